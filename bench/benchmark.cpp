@@ -0,0 +1,258 @@
+#include "benchmark.hpp"
+#include "core/memory/allocation_tracker.hpp"
+
+namespace softcube::bench {
+    namespace {
+        std::string escape_json(const std::string_view text) {
+            std::string escaped;
+            escaped.reserve(text.size());
+            for (const char c: text) {
+                if (c == '"' || c == '\\') {
+                    escaped += '\\';
+                }
+                escaped += c;
+            }
+            return escaped;
+        }
+
+        const char *get_simd_backend() {
+#if defined(SOFTCUBE_SIMD_SSE)
+            return "sse2";
+#elif defined(SOFTCUBE_SIMD_NEON)
+            return "neon";
+#else
+            return "scalar";
+#endif
+        }
+
+        const char *get_compiler() {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc";
+#else
+            return "unknown";
+#endif
+        }
+
+        void write_statistics(std::ofstream &file, const Statistics &statistics) {
+            file << "{\"min\": " << statistics.min
+                    << ", \"median\": " << statistics.median
+                    << ", \"mean\": " << statistics.mean
+                    << ", \"max\": " << statistics.max
+                    << ", \"stddev\": " << statistics.stddev << '}';
+        }
+
+        void print_header() {
+            std::cout << std::left << std::setw(48) << "benchmark" << std::right
+                    << std::setw(13) << "ns/op" << std::setw(8) << "+-"
+                    << std::setw(12) << "cycles/op" << std::setw(12) << "Mops/s" << "  counters\n";
+        }
+
+        void print_result(const Result &result) {
+            const double spread = result.ns_per_op.median > 0.0
+                                      ? 100.0 * result.ns_per_op.stddev / result.ns_per_op.median
+                                      : 0.0;
+
+            std::ostringstream line;
+            line << std::left << std::setw(48) << result.name << std::right << std::fixed
+                    << ' ' << std::setw(12) << std::setprecision(3) << result.ns_per_op.median
+                    << ' ' << std::setw(6) << std::setprecision(1) << spread << '%'
+                    << ' ' << std::setw(11);
+            if (result.cycles_per_op) {
+                line << std::setprecision(2) << *result.cycles_per_op;
+            } else {
+                line << '-';
+            }
+            line << ' ' << std::setw(11) << std::setprecision(2) << result.get_ops_per_second() / 1e6 << ' ';
+
+            line << std::defaultfloat << std::setprecision(4);
+            for (const auto &[name, value]: result.counters) {
+                line << ' ' << name << '=' << value;
+            }
+            for (const auto &check: result.failed_checks) {
+                line << "  FAILED: " << check;
+            }
+            std::cout << line.str() << std::endl;
+        }
+    }
+
+    Statistics Statistics::from_samples(std::vector<double> samples) {
+        Statistics statistics;
+        if (samples.empty()) {
+            return statistics;
+        }
+
+        std::ranges::sort(samples);
+        const size_t count = samples.size();
+        statistics.min = samples.front();
+        statistics.max = samples.back();
+        statistics.median = count % 2 == 1
+                                ? samples[count / 2]
+                                : 0.5 * (samples[count / 2 - 1] + samples[count / 2]);
+        statistics.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(count);
+
+        double variance = 0.0;
+        for (const double sample: samples) {
+            variance += (sample - statistics.mean) * (sample - statistics.mean);
+        }
+        statistics.stddev = count > 1 ? std::sqrt(variance / static_cast<double>(count - 1)) : 0.0;
+        return statistics;
+    }
+
+    State::State(std::string name, const Config &config) : m_config(config) {
+        m_result.name = std::move(name);
+    }
+
+    void State::set_counter(const std::string_view name, const double value) {
+        for (auto &[existing, existing_value]: m_result.counters) {
+            if (existing == name) {
+                existing_value = value;
+                return;
+            }
+        }
+        m_result.counters.emplace_back(name, value);
+    }
+
+    void State::check(const bool passed, const std::string_view description) {
+        if (!passed) {
+            m_result.failed_checks.emplace_back(description);
+        }
+    }
+
+    void State::begin_run(const u64 ops_per_call) {
+        SOFTCUBE_ASSERT(!m_has_run, "A benchmark may only call run once");
+        SOFTCUBE_ASSERT(ops_per_call > 0, "A call must perform at least one op");
+        m_result.ops_per_call = ops_per_call;
+    }
+
+    u64 State::get_calls_per_sample(const std::chrono::nanoseconds warmup_time, const u64 warmup_calls) const {
+        const double seconds_per_call = std::chrono::duration<double>(warmup_time).count() /
+                                        static_cast<double>(warmup_calls);
+        const double sample_seconds = std::chrono::duration<double>(m_config.sample_time).count();
+        return std::max<u64>(1, static_cast<u64>(sample_seconds / std::max(seconds_per_call, 1e-12)));
+    }
+
+    void State::finish(const u64 calls_per_sample, std::vector<double> &nanoseconds, std::vector<double> &cycles) {
+        const double ops_per_sample = static_cast<double>(calls_per_sample * m_result.ops_per_call);
+        for (size_t sample = 0; sample < nanoseconds.size(); ++sample) {
+            nanoseconds[sample] /= ops_per_sample;
+            cycles[sample] /= ops_per_sample;
+        }
+
+        m_result.calls_per_sample = calls_per_sample;
+        m_result.ns_per_op = Statistics::from_samples(std::move(nanoseconds));
+        if constexpr (has_cycle_counter) {
+            m_result.cycles_per_op = Statistics::from_samples(std::move(cycles)).median;
+        }
+        m_has_run = true;
+    }
+
+    void BenchmarkRegistry::add(std::string name, BenchmarkFunction function) {
+        SOFTCUBE_ASSERT(std::ranges::none_of(m_benchmarks, [&name](const Benchmark &benchmark) {
+                            return benchmark.name == name;
+                            }), "Benchmark registered twice");
+        m_benchmarks.push_back({std::move(name), std::move(function)});
+    }
+
+    std::vector<Result> run_benchmarks(const BenchmarkRegistry &registry, const Config &config) {
+#ifndef NDEBUG
+        std::cout << "warning: built without NDEBUG; timings include assertions and are not representative\n";
+#endif
+        print_header();
+
+        std::vector<Result> results;
+        for (const auto &benchmark: registry.get_benchmarks()) {
+            if (!config.filter.empty() && benchmark.name.find(config.filter) == std::string::npos) {
+                continue;
+            }
+
+            State state(benchmark.name, config);
+            benchmark.function(state);
+            if (!state.has_run()) {
+                std::cout << std::left << std::setw(48) << benchmark.name << std::right << " did not call run\n";
+                continue;
+            }
+
+            print_result(state.get_result());
+            results.push_back(state.get_result());
+        }
+        return results;
+    }
+
+    bool write_json(const std::filesystem::path &path, const Config &config, const std::span<const Result> results) {
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "Failed to open " << path.string() << " for writing\n";
+            return false;
+        }
+
+        const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm utc{};
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+        gmtime_s(&utc, &now);
+#else
+        gmtime_r(&now, &utc);
+#endif
+
+        file << std::setprecision(9);
+        file << "{\n  \"context\": {\n"
+                << "    \"date\": \"" << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ") << "\",\n"
+                << "    \"compiler\": \"" << escape_json(get_compiler()) << "\",\n"
+#ifdef NDEBUG
+                << "    \"build\": \"release\",\n"
+#else
+                << "    \"build\": \"debug\",\n"
+#endif
+                << "    \"simd\": \"" << get_simd_backend() << "\",\n"
+#ifdef __BMI2__
+                << "    \"bmi2\": true,\n"
+#else
+                << "    \"bmi2\": false,\n"
+#endif
+                << "    \"allocation_tracking\": " << (AllocationTracker::is_enabled() ? "true" : "false") << ",\n"
+                << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+                << "    \"cycle_counter\": \"" << (has_cycle_counter ? "tsc" : "none") << "\",\n"
+                << "    \"warmup_ms\": " << config.warmup.count() << ",\n"
+                << "    \"sample_ms\": " << config.sample_time.count() << ",\n"
+                << "    \"sample_count\": " << config.sample_count << "\n"
+                << "  },\n  \"benchmarks\": [";
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto &result = results[i];
+            file << (i == 0 ? "\n" : ",\n")
+                    << "    {\"name\": \"" << escape_json(result.name) << "\""
+                    << ", \"calls_per_sample\": " << result.calls_per_sample
+                    << ", \"ops_per_call\": " << result.ops_per_call
+                    << ", \"ns_per_op\": ";
+            write_statistics(file, result.ns_per_op);
+            file << ", \"cycles_per_op\": ";
+            if (result.cycles_per_op) {
+                file << *result.cycles_per_op;
+            } else {
+                file << "null";
+            }
+            file << ", \"ops_per_second\": " << result.get_ops_per_second() << ", \"counters\": {";
+            for (size_t c = 0; c < result.counters.size(); ++c) {
+                const double value = result.counters[c].second;
+                file << (c == 0 ? "" : ", ") << '"' << escape_json(result.counters[c].first) << "\": ";
+                if (std::isfinite(value)) {
+                    file << value;
+                } else {
+                    file << "null";
+                }
+            }
+            file << "}, \"failed_checks\": [";
+            for (size_t c = 0; c < result.failed_checks.size(); ++c) {
+                file << (c == 0 ? "\"" : ", \"") << escape_json(result.failed_checks[c]) << '"';
+            }
+            file << "]}";
+        }
+        file << "\n  ]\n}\n";
+
+        std::cout << "Wrote " << results.size() << " results to " << path.string() << '\n';
+        return true;
+    }
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include "core/common.hpp"
+
+#include <span>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+namespace softcube::bench {
+    /**
+     * @brief Keep the compiler from discarding a value or the work that produced it
+     */
+    template<typename T>
+    void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+        _ReadWriteBarrier();
+#endif
+    }
+
+    /**
+     * @brief Make the compiler assume all memory was read and written, so stores before it are kept
+     */
+    inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        _ReadWriteBarrier();
+#endif
+    }
+
+    /**
+     * @brief Whether read_cycle_counter returns a real counter on this target
+     */
+    constexpr bool has_cycle_counter =
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        true;
+#else
+        false;
+#endif
+
+    /**
+     * @brief Read the time-stamp counter
+     *
+     * The TSC ticks at the CPU's nominal frequency rather than its current
+     * clock, so cycles per op drift from the core's real cycle count while
+     * turbo or power saving changes the clock. Returns 0 without a TSC.
+     */
+    inline u64 read_cycle_counter() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @struct Config
+     * @brief How long and how often each benchmark is measured
+     */
+    struct Config {
+        std::chrono::milliseconds warmup{50}; // Untimed calls before sampling; also sizes the samples
+        std::chrono::milliseconds sample_time{10}; // Target duration of one sample
+        size_t sample_count = 15;
+        std::string filter; // Only run benchmarks whose name contains this
+    };
+
+    /**
+     * @struct Statistics
+     * @brief Summary of a set of samples
+     */
+    struct Statistics {
+        double min = 0.0;
+        double median = 0.0;
+        double mean = 0.0;
+        double max = 0.0;
+        double stddev = 0.0;
+
+        static Statistics from_samples(std::vector<double> samples);
+    };
+
+    /**
+     * @struct Result
+     * @brief Measurements of one benchmark
+     */
+    struct Result {
+        std::string name;
+        u64 calls_per_sample = 0;
+        u64 ops_per_call = 1;
+        Statistics ns_per_op;
+        std::optional<double> cycles_per_op; // Median, in TSC ticks; empty without a cycle counter
+        std::vector<std::pair<std::string, double> > counters;
+        std::vector<std::string> failed_checks; // Correctness checks the benchmark reported as failed
+
+        [[nodiscard]] double get_ops_per_second() const {
+            return ns_per_op.median > 0.0 ? 1e9 / ns_per_op.median : 0.0;
+        }
+    };
+
+    /**
+     * @class State
+     * @brief Handed to a benchmark function, which sets up its data and then calls run once
+     *
+     * Everything before run is untimed. run warms up by calling the body for
+     * Config::warmup, picks a call count that makes one sample last about
+     * Config::sample_time, then times Config::sample_count samples. Times are
+     * reported per op, where one call of the body performs ops_per_call ops,
+     * so a body looping over a batch of 1024 elements reports per element.
+     */
+    class State {
+    public:
+        State(std::string name, const Config &config);
+
+        /**
+         * @brief Measure a body
+         * @param body Work to time; should end with do_not_optimize or clobber_memory on its results
+         * @param ops_per_call Operations one call of the body performs
+         */
+        template<typename F>
+        void run(F &&body, u64 ops_per_call = 1);
+
+        /**
+         * @brief Measure a body that needs fresh state for every call, such as loading into an empty registry
+         *
+         * setup runs untimed before every call and each call is timed on its
+         * own, so the clock reads add tens of nanoseconds per call; keep this
+         * for bodies that take microseconds or more.
+         */
+        template<typename Setup, typename F>
+        void run_with_setup(Setup &&setup, F &&body, u64 ops_per_call = 1);
+
+        /**
+         * @brief Attach an extra value to the result, such as an error bound or an average hit count
+         */
+        void set_counter(std::string_view name, double value);
+
+        /**
+         * @brief Record a correctness check, such as a fast path matching its reference
+         *
+         * A failed check is printed with the result and makes softcube_bench exit non-zero.
+         */
+        void check(bool passed, std::string_view description);
+
+        [[nodiscard]] const Result &get_result() const { return m_result; }
+        [[nodiscard]] bool has_run() const { return m_has_run; }
+
+    private:
+        void begin_run(u64 ops_per_call);
+        [[nodiscard]] u64 get_calls_per_sample(std::chrono::nanoseconds warmup_time, u64 warmup_calls) const;
+        void finish(u64 calls_per_sample, std::vector<double> &nanoseconds, std::vector<double> &cycles);
+
+        const Config &m_config;
+        Result m_result;
+        bool m_has_run = false;
+    };
+
+    using BenchmarkFunction = std::function<void(State &)>;
+
+    /**
+     * @struct Benchmark
+     * @brief A named benchmark function
+     */
+    struct Benchmark {
+        std::string name;
+        BenchmarkFunction function;
+    };
+
+    /**
+     * @class BenchmarkRegistry
+     * @brief Benchmarks in registration order; names are "group/what[/size]"
+     */
+    class BenchmarkRegistry {
+    public:
+        void add(std::string name, BenchmarkFunction function);
+
+        [[nodiscard]] const std::vector<Benchmark> &get_benchmarks() const { return m_benchmarks; }
+
+    private:
+        std::vector<Benchmark> m_benchmarks;
+    };
+
+    /**
+     * @brief Run every benchmark matching the filter, printing each result as it finishes
+     */
+    std::vector<Result> run_benchmarks(const BenchmarkRegistry &registry, const Config &config);
+
+    /**
+     * @brief Write results and a description of the build and machine as JSON
+     */
+    bool write_json(const std::filesystem::path &path, const Config &config, std::span<const Result> results);
+
+    template<typename F>
+    void State::run(F &&body, const u64 ops_per_call) {
+        using Clock = std::chrono::steady_clock;
+        begin_run(ops_per_call);
+
+        u64 warmup_calls = 0;
+        const auto warmup_start = Clock::now();
+        Clock::duration warmup_time{};
+        do {
+            body();
+            ++warmup_calls;
+            warmup_time = Clock::now() - warmup_start;
+        } while (warmup_time < m_config.warmup);
+
+        const u64 calls = get_calls_per_sample(warmup_time, warmup_calls);
+        std::vector<double> nanoseconds(m_config.sample_count);
+        std::vector<double> cycles(m_config.sample_count);
+        for (size_t sample = 0; sample < m_config.sample_count; ++sample) {
+            const u64 cycles_start = read_cycle_counter();
+            const auto start = Clock::now();
+            for (u64 call = 0; call < calls; ++call) {
+                body();
+            }
+            const auto end = Clock::now();
+            const u64 cycles_end = read_cycle_counter();
+            nanoseconds[sample] = std::chrono::duration<double, std::nano>(end - start).count();
+            cycles[sample] = static_cast<double>(cycles_end - cycles_start);
+        }
+        finish(calls, nanoseconds, cycles);
+    }
+
+    template<typename Setup, typename F>
+    void State::run_with_setup(Setup &&setup, F &&body, const u64 ops_per_call) {
+        using Clock = std::chrono::steady_clock;
+        begin_run(ops_per_call);
+
+        // Samples are sized by wall time including setup, so an expensive
+        // setup shortens them instead of stretching the run.
+        u64 warmup_calls = 0;
+        const auto warmup_start = Clock::now();
+        Clock::duration warmup_time{};
+        do {
+            setup();
+            body();
+            ++warmup_calls;
+            warmup_time = Clock::now() - warmup_start;
+        } while (warmup_time < m_config.warmup);
+
+        const u64 calls = get_calls_per_sample(warmup_time, warmup_calls);
+        std::vector<double> nanoseconds(m_config.sample_count);
+        std::vector<double> cycles(m_config.sample_count);
+        for (size_t sample = 0; sample < m_config.sample_count; ++sample) {
+            for (u64 call = 0; call < calls; ++call) {
+                setup();
+                const u64 cycles_start = read_cycle_counter();
+                const auto start = Clock::now();
+                body();
+                const auto end = Clock::now();
+                const u64 cycles_end = read_cycle_counter();
+                nanoseconds[sample] += std::chrono::duration<double, std::nano>(end - start).count();
+                cycles[sample] += static_cast<double>(cycles_end - cycles_start);
+            }
+        }
+        finish(calls, nanoseconds, cycles);
+    }
+}
@@ -0,0 +1,361 @@
+#include "benchmark.hpp"
+#include "suites.hpp"
+#include "core/math/random.hpp"
+#include "core/memory/frame_allocator.hpp"
+#include "core/memory/memory_pool.hpp"
+#include "core/spatial/dynamic_aabb_tree.hpp"
+#include "core/threading/job_system.hpp"
+
+#include <barrier>
+
+namespace softcube::bench {
+    namespace {
+        constexpr size_t proxy_count = 10'000;
+        constexpr size_t query_count = 1'000;
+        constexpr float world_extent = 100.0f; // Dense enough that queries and rays find something
+
+        Vector3 random_point(math::Xoshiro256 &rng, const float extent) {
+            return {rng.next_float(-extent, extent), rng.next_float(-extent, extent), rng.next_float(-extent, extent)};
+        }
+
+        AABB random_box(math::Xoshiro256 &rng, const float half_size) {
+            const Vector3 center = random_point(rng, world_extent);
+            return {center - Vector3(half_size), center + Vector3(half_size)};
+        }
+
+        /**
+         * @struct TreeScene
+         * @brief Unit boxes scattered through the world and a tree holding them
+         */
+        struct TreeScene {
+            std::vector<AABB> boxes;
+            std::vector<i32> proxies;
+            DynamicAabbTree tree;
+
+            explicit TreeScene(const u64 seed) {
+                math::Xoshiro256 rng(seed);
+                boxes.resize(proxy_count);
+                proxies.resize(proxy_count);
+                for (size_t i = 0; i < proxy_count; ++i) {
+                    boxes[i] = random_box(rng, 0.5f);
+                    proxies[i] = tree.create_proxy(boxes[i], static_cast<u32>(i));
+                }
+            }
+        };
+
+        /**
+         * @class ThreadTeam
+         * @brief Threads that each run a body once per call of run, so starting threads stays out of the timing
+         */
+        class ThreadTeam {
+        public:
+            /**
+             * @param body Called as void(size_t thread_index) on every thread
+             */
+            ThreadTeam(const size_t thread_count, std::function<void(size_t)> body)
+                : m_start(static_cast<std::ptrdiff_t>(thread_count + 1)),
+                  m_done(static_cast<std::ptrdiff_t>(thread_count + 1)),
+                  m_body(std::move(body)) {
+                for (size_t i = 0; i < thread_count; ++i) {
+                    m_threads.emplace_back([this, i] {
+                        while (true) {
+                            m_start.arrive_and_wait();
+                            if (m_stopping) {
+                                return;
+                            }
+                            m_body(i);
+                            m_done.arrive_and_wait();
+                        }
+                    });
+                }
+            }
+
+            ~ThreadTeam() {
+                m_stopping = true;
+                m_start.arrive_and_wait();
+                for (auto &thread: m_threads) {
+                    thread.join();
+                }
+            }
+
+            ThreadTeam(const ThreadTeam &) = delete;
+
+            ThreadTeam &operator=(const ThreadTeam &) = delete;
+
+            /**
+             * @brief Run the body on every thread and wait for all of them
+             */
+            void run() {
+                m_start.arrive_and_wait();
+                m_done.arrive_and_wait();
+            }
+
+        private:
+            std::barrier<> m_start;
+            std::barrier<> m_done;
+            std::function<void(size_t)> m_body;
+            bool m_stopping = false; // Published to the threads by m_start
+            std::vector<std::thread> m_threads;
+        };
+
+        void add_tree_benchmarks(BenchmarkRegistry &registry) {
+            registry.add("core/aabb_tree/build", [](State &state) {
+                const TreeScene scene(1);
+                DynamicAabbTree tree;
+                state.run([&] {
+                    tree.clear();
+                    for (size_t i = 0; i < proxy_count; ++i) {
+                        do_not_optimize(tree.create_proxy(scene.boxes[i], static_cast<u32>(i)));
+                    }
+                }, proxy_count);
+            });
+
+            // Every proxy moves a little, half of them far enough to leave their fat box
+            registry.add("core/aabb_tree/move", [](State &state) {
+                TreeScene scene(2);
+                size_t frame = 0;
+                state.run([&] {
+                    const float offset = frame++ % 2 == 0 ? 0.1f : -0.1f;
+                    for (size_t i = 0; i < proxy_count; ++i) {
+                        const Vector3 displacement(i % 2 == 0 ? offset : offset * 4.0f, 0.0f, 0.0f);
+                        scene.boxes[i] = AABB(scene.boxes[i].min + displacement, scene.boxes[i].max + displacement);
+                        scene.tree.move_proxy(scene.proxies[i], scene.boxes[i], displacement);
+                    }
+                }, proxy_count);
+            });
+
+            registry.add("core/aabb_tree/query_aabb", [](State &state) {
+                const TreeScene scene(3);
+                math::Xoshiro256 rng(4);
+                std::vector<AABB> queries(query_count);
+                for (auto &query: queries) {
+                    query = random_box(rng, 20.0f);
+                }
+                size_t found = 0;
+                state.run([&] {
+                    found = 0;
+                    for (const auto &query: queries) {
+                        scene.tree.query(query, [&found](u32) {
+                            ++found;
+                            return true;
+                        });
+                    }
+                    do_not_optimize(found);
+                }, query_count);
+                state.set_counter("results_per_query", static_cast<double>(found) / query_count);
+            });
+
+            registry.add("core/aabb_tree/query_frustum", [](State &state) {
+                const TreeScene scene(5);
+                const Matrix4 view_projection = Matrix4::perspective(60.0f, 16.0f / 9.0f, 0.1f, 300.0f) *
+                                                Matrix4::look_at(Vector3::zero(), Vector3(1.0f, 0.0f, 1.0f),
+                                                                 Vector3::up());
+                const Frustum frustum = Frustum::from_matrix(view_projection);
+                size_t found = 0;
+                state.run([&] {
+                    found = 0;
+                    scene.tree.query(frustum, [&found](u32) {
+                        ++found;
+                        return true;
+                    });
+                    do_not_optimize(found);
+                });
+                state.set_counter("visible", static_cast<double>(found));
+            });
+
+            registry.add("core/aabb_tree/raycast", [](State &state) {
+                const TreeScene scene(6);
+                math::Xoshiro256 rng(7);
+                std::vector<Vector3> origins(query_count);
+                std::vector<Vector3> directions(query_count);
+                for (size_t i = 0; i < query_count; ++i) {
+                    origins[i] = random_point(rng, world_extent);
+                    directions[i] = normalize(random_point(rng, 1.0f) + Vector3(0.0f, 0.0f, 0.01f));
+                }
+                size_t hits = 0;
+                state.run([&] {
+                    hits = 0;
+                    for (size_t i = 0; i < query_count; ++i) {
+                        bool hit = false;
+                        scene.tree.raycast(origins[i], directions[i], 100.0f, [&](const u32 user_data, const float max) {
+                            float t_min = 0.0f;
+                            float t_max = 0.0f;
+                            if (scene.boxes[user_data].intersect_ray(origins[i], directions[i], t_min, t_max) &&
+                                t_min >= 0.0f && t_min < max) {
+                                hit = true;
+                                return t_min;
+                            }
+                            return max;
+                        });
+                        hits += hit;
+                    }
+                    do_not_optimize(hits);
+                }, query_count);
+                state.set_counter("hit_rate", static_cast<double>(hits) / query_count);
+            });
+        }
+
+        void add_job_benchmarks(BenchmarkRegistry &registry) {
+            constexpr size_t element_count = 1 << 20;
+
+            // Enough arithmetic per element that splitting the range can pay off
+            const auto kernel = [](const std::span<float> values, const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    float x = values[i];
+                    for (int iteration = 0; iteration < 8; ++iteration) {
+                        x = x * 0.999f + 0.5f;
+                    }
+                    values[i] = x;
+                }
+            };
+
+            registry.add("core/jobs/serial_for", [kernel](State &state) {
+                std::vector<float> values(element_count, 1.0f);
+                state.run([&] {
+                    kernel(values, 0, values.size());
+                    clobber_memory();
+                }, element_count);
+            });
+
+            registry.add("core/jobs/parallel_for", [kernel](State &state) {
+                JobSystem jobs;
+                std::vector<float> values(element_count, 1.0f);
+                state.run([&] {
+                    jobs.parallel_for(0, values.size(), [&](const size_t begin, const size_t end) {
+                        kernel(values, begin, end);
+                    });
+                    clobber_memory();
+                }, element_count);
+                state.set_counter("threads", jobs.get_thread_count());
+            });
+
+            // The same elements as rows of a parallel_for nested in another, as a system
+            // splitting its entities and then each entity's work would.
+            registry.add("core/jobs/nested_parallel_for", [kernel](State &state) {
+                constexpr size_t row_count = 1024;
+                constexpr size_t row_size = element_count / row_count;
+                JobSystem jobs;
+                std::vector<float> values(element_count, 1.0f);
+                state.run([&] {
+                    jobs.parallel_for(0, row_count, [&](const size_t first_row, const size_t last_row) {
+                        for (size_t row = first_row; row < last_row; ++row) {
+                            jobs.parallel_for(row * row_size, (row + 1) * row_size, [&](const size_t begin, const size_t end) {
+                                kernel(values, begin, end);
+                            });
+                        }
+                    }, 1);
+                    clobber_memory();
+                }, element_count);
+                state.set_counter("threads", jobs.get_thread_count());
+            });
+
+            // Scheduling and waiting on empty jobs, the fixed cost a job has to outweigh
+            registry.add("core/jobs/schedule_wait", [](State &state) {
+                constexpr size_t job_count = 256;
+                JobSystem jobs;
+                std::atomic<u32> executed{0};
+                state.run([&] {
+                    JobCounter counter;
+                    for (size_t i = 0; i < job_count; ++i) {
+                        jobs.schedule([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                    }
+                    jobs.wait(counter);
+                }, job_count);
+            });
+        }
+
+        void add_memory_benchmarks(BenchmarkRegistry &registry) {
+            constexpr size_t block_size = 64;
+            constexpr size_t block_count = 1'000;
+
+            // Allocate a batch of small blocks and free them again, as per-frame scratch would
+            registry.add("core/memory/new_delete", [](State &state) {
+                std::vector<std::byte *> blocks(block_count);
+                state.run([&] {
+                    for (auto &block: blocks) {
+                        block = new std::byte[block_size];
+                        do_not_optimize(block);
+                    }
+                    for (const auto *block: blocks) {
+                        delete[] block;
+                    }
+                }, block_count);
+            });
+
+            registry.add("core/memory/frame_allocator", [](State &state) {
+                FrameAllocator allocator;
+                std::vector<void *> blocks(block_count);
+                state.run([&] {
+                    allocator.begin_frame();
+                    for (auto &block: blocks) {
+                        block = allocator.allocate(block_size);
+                        do_not_optimize(block);
+                    }
+                }, block_count);
+            });
+
+            registry.add("core/memory/memory_pool", [](State &state) {
+                MemoryPool pool(block_size);
+                std::vector<void *> blocks(block_count);
+                state.run([&] {
+                    for (auto &block: blocks) {
+                        block = pool.allocate();
+                        do_not_optimize(block);
+                    }
+                    for (auto *block: blocks) {
+                        pool.deallocate(block);
+                    }
+                }, block_count);
+            });
+
+            registry.add("core/memory/concurrent_memory_pool", [](State &state) {
+                ConcurrentMemoryPool pool(block_size);
+                std::vector<void *> blocks(block_count);
+                state.run([&] {
+                    for (auto &block: blocks) {
+                        block = pool.allocate();
+                        do_not_optimize(block);
+                    }
+                    for (auto *block: blocks) {
+                        pool.deallocate(block);
+                    }
+                }, block_count);
+            });
+
+            // Eight threads allocate and free their own batches at the same time, so the allocator is under contention
+            const auto run_threaded = [](State &state, auto allocate, auto deallocate) {
+                constexpr size_t thread_count = 8;
+                std::vector<std::vector<void *> > blocks(thread_count, std::vector<void *>(block_count));
+                ThreadTeam team(thread_count, [&](const size_t thread) {
+                    for (auto &block: blocks[thread]) {
+                        block = allocate();
+                        do_not_optimize(block);
+                    }
+                    for (auto *block: blocks[thread]) {
+                        deallocate(block);
+                    }
+                });
+                state.run([&] { team.run(); }, thread_count * block_count);
+            };
+
+            registry.add("core/memory/new_delete/8_threads", [run_threaded](State &state) {
+                run_threaded(state,
+                             [] { return static_cast<void *>(new std::byte[block_size]); },
+                             [](void *block) { delete[] static_cast<std::byte *>(block); });
+            });
+
+            registry.add("core/memory/concurrent_memory_pool/8_threads", [run_threaded](State &state) {
+                ConcurrentMemoryPool pool(block_size);
+                run_threaded(state,
+                             [&pool] { return pool.allocate(); },
+                             [&pool](void *block) { pool.deallocate(block); });
+            });
+        }
+    }
+
+    void register_core_benchmarks(BenchmarkRegistry &registry) {
+        add_tree_benchmarks(registry);
+        add_job_benchmarks(registry);
+        add_memory_benchmarks(registry);
+    }
+}
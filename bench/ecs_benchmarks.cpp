@@ -0,0 +1,440 @@
+#include "benchmark.hpp"
+#include "suites.hpp"
+#include "core/math/random.hpp"
+#include "core/memory/large_page_resource.hpp"
+#include "ecs/command_buffer.hpp"
+#include "ecs/entity_factory.hpp"
+#include "ecs/prefab.hpp"
+#include "ecs/registry.hpp"
+#include "ecs/system_profiler.hpp"
+#include "ecs/components/basic/transform_component.hpp"
+#include "ecs/components/hierarchy/parent_component.hpp"
+#include "ecs/components/physics/velocity_component.hpp"
+#include "ecs/components/spatial/bounds_component.hpp"
+#include "ecs/serialization/delta_history.hpp"
+#include "ecs/serialization/registry_snapshot.hpp"
+#include "ecs/systems/basic/transform_system.hpp"
+#include "ecs/systems/hierarchy/hierarchy_system.hpp"
+#include "ecs/systems/physics/physics_integration_system.hpp"
+#include "ecs/systems/spatial/spatial_index_system.hpp"
+
+namespace softcube::bench {
+    namespace {
+        constexpr size_t entity_count = 100'000;
+        constexpr size_t batch_count = 1'000;
+        constexpr size_t particle_count = 1'000'000; // Large enough that iteration streams from memory
+        constexpr size_t spawn_count = 1'000'000; // Deferred spawns, prefab instances and snapshot entities
+        constexpr size_t reparent_count = 100'000;
+        constexpr float world_extent = 500.0f;
+        constexpr float fixed_dt = 1.0f / 60.0f;
+
+        /**
+         * @brief Create entities with a Transform at random positions; every second one also moves
+         */
+        void populate(Registry &registry, const size_t count, math::Xoshiro256 &rng) {
+            for (size_t i = 0; i < count; ++i) {
+                const auto entity = registry.create();
+                const Vector3 position(rng.next_float(-world_extent, world_extent),
+                                       rng.next_float(-world_extent, world_extent),
+                                       rng.next_float(-world_extent, world_extent));
+                registry.emplace<component::Transform>(entity, position);
+                if (i % 2 == 0) {
+                    registry.emplace<component::Velocity>(entity, Vector3(rng.next_float(-5.0f, 5.0f), 0.0f, 1.0f),
+                                                          Vector3(0.0f, 0.5f, 0.0f));
+                }
+            }
+        }
+
+        struct Particle {
+            Vector3 position;
+            Vector3 velocity;
+        };
+
+        /**
+         * @class NullSystem
+         * @brief System with an empty update, so only the profiler's own cost is measured
+         */
+        class NullSystem final : public system::System {
+        public:
+            void update(float) override {
+            }
+
+            [[nodiscard]] const char *get_name() const override { return "Null"; }
+        };
+
+        /**
+         * @brief Move a million particles, their pages allocated from upstream
+         * @param upstream Resource behind the particle pages, or null for the heap
+         */
+        void run_particle_benchmark(State &state, std::pmr::memory_resource *upstream) {
+            math::Xoshiro256 rng(11);
+            ComponentMemory memory;
+            memory.set_upstream<Particle>(upstream);
+            Registry registry{ComponentAllocator<entt::entity>(memory)};
+            for (size_t i = 0; i < particle_count; ++i) {
+                registry.emplace<Particle>(registry.create(),
+                                           Vector3(rng.next_float(-world_extent, world_extent), 0.0f, 0.0f),
+                                           Vector3(rng.next_float(-1.0f, 1.0f), 0.0f, 1.0f));
+            }
+
+            state.run([&] {
+                for (auto &particle: registry.storage<Particle>()) {
+                    particle.position += particle.velocity * fixed_dt;
+                }
+                clobber_memory();
+            }, particle_count);
+        }
+
+        void add_registry_benchmarks(BenchmarkRegistry &registry) {
+            registry.add("ecs/view/transform", [](State &state) {
+                math::Xoshiro256 rng(1);
+                Registry world;
+                populate(world, entity_count, rng);
+                const auto view = world.view<const component::Transform>();
+                state.run([&] {
+                    Vector3 sum = Vector3::zero();
+                    for (const auto [entity, transform]: view.each()) {
+                        sum += transform.position;
+                    }
+                    do_not_optimize(sum);
+                }, entity_count);
+            });
+
+            // The same loop through a view and through a group owning both types; half the entities move
+            registry.add("ecs/view/transform_velocity", [](State &state) {
+                math::Xoshiro256 rng(2);
+                Registry world;
+                populate(world, particle_count, rng);
+                const auto view = world.view<component::Transform, const component::Velocity>();
+                state.run([&] {
+                    for (const auto [entity, transform, velocity]: view.each()) {
+                        transform.position += velocity.linear * fixed_dt;
+                    }
+                    clobber_memory();
+                }, particle_count / 2);
+            });
+
+            registry.add("ecs/group/transform_velocity", [](State &state) {
+                math::Xoshiro256 rng(2);
+                Registry world;
+                const auto group = world.group<component::Transform, component::Velocity>();
+                populate(world, particle_count, rng);
+                state.run([&] {
+                    for (const auto [entity, transform, velocity]: group.each()) {
+                        transform.position += velocity.linear * fixed_dt;
+                    }
+                    clobber_memory();
+                }, particle_count / 2);
+            });
+
+            registry.add("ecs/storage/heap_pages", [](State &state) {
+                run_particle_benchmark(state, nullptr);
+            });
+
+            registry.add("ecs/storage/large_pages", [](State &state) {
+                LargePageResource resource;
+                run_particle_benchmark(state, &resource);
+            });
+        }
+
+        void add_system_benchmarks(BenchmarkRegistry &registry) {
+            registry.add("ecs/transform_system/clean", [](State &state) {
+                math::Xoshiro256 rng(3);
+                Registry world;
+                populate(world, entity_count, rng);
+                system::TransformSystem transforms;
+                transforms.init(world);
+                transforms.update(fixed_dt);
+                state.run([&] { transforms.update(fixed_dt); }, entity_count);
+            });
+
+            registry.add("ecs/transform_system/all_dirty", [](State &state) {
+                math::Xoshiro256 rng(4);
+                Registry world;
+                populate(world, entity_count, rng);
+                system::TransformSystem transforms;
+                transforms.init(world);
+                auto &storage = world.storage<component::Transform>();
+                state.run([&] {
+                    for (auto &transform: storage) {
+                        transform.matrix_dirty = true;
+                    }
+                    transforms.update(fixed_dt);
+                }, entity_count);
+            });
+
+            // A forest of 1000 roots, each with 10 children that have 9 children of their own
+            registry.add("ecs/hierarchy/update", [](State &state) {
+                Registry world;
+                system::HierarchySystem hierarchy;
+                hierarchy.init(world);
+                size_t count = 0;
+                for (size_t root = 0; root < 1'000; ++root) {
+                    const auto root_entity = world.create();
+                    world.emplace<component::Transform>(root_entity, Vector3(static_cast<float>(root), 0.0f, 0.0f));
+                    ++count;
+                    for (size_t child = 0; child < 10; ++child) {
+                        const auto child_entity = world.create();
+                        world.emplace<component::Transform>(child_entity, Vector3(1.0f, 0.0f, 0.0f));
+                        world.emplace<component::Parent>(child_entity, root_entity);
+                        ++count;
+                        for (size_t grandchild = 0; grandchild < 9; ++grandchild) {
+                            const auto grandchild_entity = world.create();
+                            world.emplace<component::Transform>(grandchild_entity, Vector3(0.0f, 1.0f, 0.0f));
+                            world.emplace<component::Parent>(grandchild_entity, child_entity);
+                            ++count;
+                        }
+                    }
+                }
+                hierarchy.update(fixed_dt);
+                state.run([&] { hierarchy.update(fixed_dt); }, count);
+            });
+
+            // Moves leaves back and forth between two parents; each move unlinks, relinks and fixes depths.
+            registry.add("ecs/hierarchy/set_parent", [](State &state) {
+                Registry world;
+                system::HierarchySystem hierarchy;
+                hierarchy.init(world);
+                const std::array parents{world.create(), world.create()};
+                for (const auto parent: parents) {
+                    world.emplace<component::Transform>(parent);
+                }
+                std::vector<entt::entity> children(reparent_count);
+                for (auto &child: children) {
+                    child = world.create();
+                    world.emplace<component::Transform>(child);
+                    hierarchy.set_parent(child, parents[0]);
+                }
+
+                size_t flip = 0;
+                state.run([&] {
+                    flip ^= 1;
+                    for (const auto child: children) {
+                        hierarchy.set_parent(child, parents[flip]);
+                    }
+                }, reparent_count);
+            });
+
+            registry.add("ecs/physics_integration/update", [](State &state) {
+                math::Xoshiro256 rng(5);
+                Registry world;
+                populate(world, entity_count, rng);
+                system::PhysicsIntegrationSystem physics(fixed_dt, 8);
+                physics.init(world);
+                physics.update(fixed_dt);
+                state.run([&] { physics.update(fixed_dt); }, entity_count / 2);
+                state.set_counter("steps", physics.get_last_step_count());
+            });
+        }
+
+        /**
+         * @struct SpatialWorld
+         * @brief Registry of bounded entities and a spatial index that has seen one update
+         */
+        struct SpatialWorld {
+            Registry registry;
+            system::SpatialIndexSystem index;
+            std::vector<entt::entity> entities;
+
+            SpatialWorld() {
+                math::Xoshiro256 rng(6);
+                index.init(registry);
+                entities.resize(entity_count);
+                for (auto &entity: entities) {
+                    entity = registry.create();
+                    registry.emplace<component::Transform>(entity, Vector3(rng.next_float(-world_extent, world_extent),
+                                                                           rng.next_float(-world_extent, world_extent),
+                                                                           rng.next_float(-world_extent, world_extent)));
+                    registry.emplace<component::Bounds>(entity);
+                }
+                index.update(fixed_dt);
+            }
+        };
+
+        void add_spatial_benchmarks(BenchmarkRegistry &registry) {
+            // One entity in ten moves a little each frame, past the tree's fat margin now and then
+            registry.add("ecs/spatial_index/update", [](State &state) {
+                const auto world = std::make_unique<SpatialWorld>();
+                size_t frame = 0;
+                state.run([&] {
+                    const float offset = frame++ % 2 == 0 ? 0.25f : -0.25f;
+                    for (size_t i = frame % 10; i < world->entities.size(); i += 10) {
+                        auto &transform = world->registry.get<component::Transform>(world->entities[i]);
+                        transform.position.x += offset;
+                        transform.matrix_dirty = true;
+                    }
+                    world->index.update(fixed_dt);
+                }, entity_count);
+            });
+
+            registry.add("ecs/spatial_index/query_aabb", [](State &state) {
+                const auto world = std::make_unique<SpatialWorld>();
+                math::Xoshiro256 rng(7);
+                std::vector<AABB> boxes(batch_count);
+                for (auto &box: boxes) {
+                    const Vector3 center(rng.next_float(-world_extent, world_extent),
+                                         rng.next_float(-world_extent, world_extent),
+                                         rng.next_float(-world_extent, world_extent));
+                    box = AABB(center - Vector3(20.0f), center + Vector3(20.0f));
+                }
+                std::vector<entt::entity> found;
+                size_t total = 0;
+                state.run([&] {
+                    total = 0;
+                    for (const auto &box: boxes) {
+                        found.clear();
+                        world->index.query(box, found);
+                        total += found.size();
+                    }
+                    do_not_optimize(total);
+                }, batch_count);
+                state.set_counter("results_per_query", static_cast<double>(total) / batch_count);
+            });
+
+            registry.add("ecs/spatial_index/raycast", [](State &state) {
+                const auto world = std::make_unique<SpatialWorld>();
+                math::Xoshiro256 rng(8);
+                std::vector<Vector3> origins(batch_count);
+                std::vector<Vector3> directions(batch_count);
+                for (size_t i = 0; i < batch_count; ++i) {
+                    origins[i] = Vector3(rng.next_float(-world_extent, world_extent),
+                                         rng.next_float(-world_extent, world_extent),
+                                         rng.next_float(-world_extent, world_extent));
+                    directions[i] = normalize(Vector3(rng.next_float(-1.0f, 1.0f), rng.next_float(-1.0f, 1.0f),
+                                                      rng.next_float(-1.0f, 1.0f)) + Vector3(0.0f, 0.0f, 0.01f));
+                }
+                size_t hits = 0;
+                state.run([&] {
+                    hits = 0;
+                    for (size_t i = 0; i < batch_count; ++i) {
+                        hits += world->index.raycast(origins[i], directions[i], 200.0f).has_value();
+                    }
+                    do_not_optimize(hits);
+                }, batch_count);
+                state.set_counter("hit_rate", static_cast<double>(hits) / batch_count);
+            });
+        }
+
+        void add_structural_benchmarks(BenchmarkRegistry &registry) {
+            // Recording and playing back a million new entities, the way worker threads spawn them
+            registry.add("ecs/command_buffer/create_playback", [](State &state) {
+                Registry world;
+                CommandBuffer commands;
+                state.run_with_setup([&] { world.clear(); }, [&] {
+                    for (size_t i = 0; i < spawn_count; ++i) {
+                        const auto entity = commands.create();
+                        commands.add<component::Transform>(entity, Vector3(static_cast<float>(i), 0.0f, 0.0f));
+                        commands.add<component::Velocity>(entity, Vector3(0.0f, 0.0f, 1.0f), Vector3::zero());
+                    }
+                    commands.playback(world);
+                }, spawn_count);
+            });
+
+            registry.add("ecs/prefab/instantiate", [](State &state) {
+                Registry world;
+                const EntityFactory factory(&world);
+                Prefab prefab;
+                prefab.with<component::Transform>(Vector3(0.0f, 10.0f, 0.0f))
+                        .with<component::Velocity>(Vector3(0.0f, 0.0f, 1.0f), Vector3::zero())
+                        .with<component::Bounds>();
+                std::vector<entt::entity> entities(spawn_count);
+                state.run_with_setup([&] { world.clear(); }, [&] {
+                    factory.instantiate(prefab, std::span{entities});
+                }, spawn_count);
+            });
+
+            registry.add("ecs/snapshot/save", [](State &state) {
+                math::Xoshiro256 rng(9);
+                Registry world;
+                populate(world, spawn_count, rng);
+                const RegistrySnapshot snapshot;
+                size_t bytes = 0;
+                state.run([&] {
+                    const auto data = snapshot.save(world);
+                    bytes = data.size();
+                    do_not_optimize(data.data());
+                }, spawn_count);
+                state.set_counter("bytes_per_entity", static_cast<double>(bytes) / spawn_count);
+            });
+
+            registry.add("ecs/snapshot/load", [](State &state) {
+                math::Xoshiro256 rng(9);
+                Registry world;
+                populate(world, spawn_count, rng);
+                const RegistrySnapshot snapshot;
+                const auto data = snapshot.save(world);
+                Registry target;
+                state.run([&] {
+                    snapshot.load(target, data);
+                    clobber_memory();
+                }, spawn_count);
+            });
+
+            // Every tick one Transform in ten changes; the rest are skipped by the shadow comparison
+            registry.add("ecs/delta_history/capture", [](State &state) {
+                math::Xoshiro256 rng(10);
+                Registry world;
+                populate(world, entity_count, rng);
+                DeltaHistory history;
+                history.track<component::Transform>();
+                history.track<component::Velocity>();
+                history.reset_base(world);
+
+                auto &transforms = world.storage<component::Transform>();
+                size_t tick = 0;
+                state.run([&] {
+                    ++tick;
+                    for (size_t i = tick % 10; i < transforms.size(); i += 10) {
+                        transforms.get(transforms.data()[i]).position.y += 0.1f;
+                    }
+                    do_not_optimize(history.capture(world));
+                }, entity_count);
+                state.set_counter("bytes_per_tick", static_cast<double>(history.get_stats().last_tick_bytes));
+            });
+
+            registry.add("ecs/delta_history/rollback", [](State &state) {
+                math::Xoshiro256 rng(10);
+                Registry world;
+                populate(world, entity_count, rng);
+                DeltaHistory history;
+                history.track<component::Transform>();
+                history.track<component::Velocity>();
+                history.reset_base(world);
+
+                auto &transforms = world.storage<component::Transform>();
+                state.run_with_setup([&] {
+                    for (size_t i = 0; i < transforms.size(); i += 10) {
+                        transforms.get(transforms.data()[i]).position.y += 0.1f;
+                    }
+                    history.capture(world);
+                }, [&] {
+                    history.rollback(world, 1);
+                }, entity_count / 10);
+            });
+        }
+
+        void add_profiler_benchmarks(BenchmarkRegistry &registry) {
+            // What EcsManager pays around every system update, with the profiler on and off
+            for (const bool enabled: {true, false}) {
+                registry.add(enabled ? "ecs/profiler/scope_enabled" : "ecs/profiler/scope_disabled",
+                             [enabled](State &state) {
+                                 NullSystem null_system;
+                                 SystemProfiler profiler;
+                                 profiler.set_enabled(enabled);
+                                 const size_t index = profiler.add_system(null_system, false);
+                                 state.run([&] {
+                                     SystemProfiler::Scope scope(profiler, index);
+                                 });
+                             });
+            }
+        }
+    }
+
+    void register_ecs_benchmarks(BenchmarkRegistry &registry) {
+        add_registry_benchmarks(registry);
+        add_system_benchmarks(registry);
+        add_spatial_benchmarks(registry);
+        add_structural_benchmarks(registry);
+        add_profiler_benchmarks(registry);
+    }
+}
@@ -0,0 +1,85 @@
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "benchmark.hpp"
+#include "suites.hpp"
+
+namespace {
+    void print_usage() {
+        std::cout << "Usage: softcube_bench [options]\n"
+                "  --filter <text>     Only run benchmarks whose name contains text\n"
+                "  --json <file>       Also write the results to a JSON file\n"
+                "  --samples <n>       Samples per benchmark (default 15)\n"
+                "  --sample-ms <ms>    Target duration of one sample (default 10)\n"
+                "  --warmup-ms <ms>    Untimed warm-up per benchmark (default 50)\n"
+                "  --list              Print the benchmark names and exit\n";
+    }
+
+    bool parse_count(const char *text, size_t &value) {
+        char *end = nullptr;
+        const unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (end == text || *end != '\0' || parsed == 0) {
+            return false;
+        }
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    bench::Config config;
+    std::filesystem::path json_path;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        const bool has_value = i + 1 < argc;
+        size_t count = 0;
+
+        if (argument == "--list") {
+            list = true;
+        } else if (argument == "--filter" && has_value) {
+            config.filter = argv[++i];
+        } else if (argument == "--json" && has_value) {
+            json_path = argv[++i];
+        } else if (argument == "--samples" && has_value && parse_count(argv[++i], count)) {
+            config.sample_count = count;
+        } else if (argument == "--sample-ms" && has_value && parse_count(argv[++i], count)) {
+            config.sample_time = std::chrono::milliseconds(count);
+        } else if (argument == "--warmup-ms" && has_value && parse_count(argv[++i], count)) {
+            config.warmup = std::chrono::milliseconds(count);
+        } else {
+            print_usage();
+            return argument == "--help" ? 0 : 1;
+        }
+    }
+
+    // Engine code logs through spdlog; keep it to warnings so the table stays readable.
+    logger::init("softcube_bench.log");
+    logger::set_level(spdlog::level::warn);
+
+    bench::BenchmarkRegistry registry;
+    bench::register_math_benchmarks(registry);
+    bench::register_noise_benchmarks(registry);
+    bench::register_voxel_benchmarks(registry);
+    bench::register_ecs_benchmarks(registry);
+    bench::register_core_benchmarks(registry);
+
+    if (list) {
+        for (const auto &benchmark: registry.get_benchmarks()) {
+            std::cout << benchmark.name << '\n';
+        }
+        return 0;
+    }
+
+    const auto results = bench::run_benchmarks(registry, config);
+    if (!json_path.empty() && !bench::write_json(json_path, config, results)) {
+        return 1;
+    }
+
+    logger::shutdown();
+
+    const bool failed = std::ranges::any_of(results, [](const bench::Result &result) {
+        return !result.failed_checks.empty();
+    });
+    return failed ? 1 : 0;
+}
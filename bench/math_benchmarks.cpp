@@ -0,0 +1,688 @@
+#include "benchmark.hpp"
+#include "suites.hpp"
+#include "core/math/fast_math.hpp"
+#include "core/math/frustum.hpp"
+#include "core/math/hash.hpp"
+#include "core/math/morton.hpp"
+#include "core/math/random.hpp"
+#include "core/math/stream.hpp"
+#include "ecs/systems/physics/integration_kernels.hpp"
+
+namespace softcube::bench {
+    namespace {
+        constexpr size_t batch_size = 1024;
+        constexpr float fixed_dt = 1.0f / 60.0f;
+
+        Vector3 random_vector(math::Xoshiro256 &rng, const float extent) {
+            return Vector3(rng.next_float(-extent, extent), rng.next_float(-extent, extent),
+                           rng.next_float(-extent, extent));
+        }
+
+        Quaternion random_rotation(math::Xoshiro256 &rng) {
+            return Quaternion(rng.next_float(-1.0f, 1.0f), rng.next_float(-1.0f, 1.0f),
+                              rng.next_float(-1.0f, 1.0f), rng.next_float(-1.0f, 1.0f)).normalized();
+        }
+
+        Matrix4 random_transform(math::Xoshiro256 &rng) {
+            return Matrix4::translation(random_vector(rng, 100.0f)) *
+                   Matrix4(random_rotation(rng).to_rotation_matrix()) *
+                   Matrix4::scale(Vector3(rng.next_float(0.5f, 2.0f)));
+        }
+
+        AABB random_box(math::Xoshiro256 &rng, const float extent, const float max_size) {
+            return AABB::from_center_and_extents(random_vector(rng, extent),
+                                                 Vector3(rng.next_float(0.1f, max_size)));
+        }
+
+        /**
+         * @brief Input range of a fast math benchmark and how its error is measured
+         */
+        struct Domain {
+            float min;
+            float max;
+            bool logarithmic; // Spread inputs evenly in log space, for functions of magnitude
+            bool relative; // Report the error relative to the exact result
+        };
+
+        std::vector<float> make_inputs(const Domain &domain, const u64 seed) {
+            math::Xoshiro256 rng(seed);
+            std::vector<float> inputs(batch_size);
+            for (auto &input: inputs) {
+                if (domain.logarithmic) {
+                    // In double, so log(input) does not land on a float and hide the rounding error
+                    const double t = static_cast<double>(rng.next_u64() >> 11) * 0x1.0p-53;
+                    const double low = std::log(static_cast<double>(domain.min));
+                    const double high = std::log(static_cast<double>(domain.max));
+                    input = static_cast<float>(std::exp(low + (high - low) * t));
+                } else {
+                    input = rng.next_float(domain.min, domain.max);
+                }
+            }
+            return inputs;
+        }
+
+        void set_error_counter(State &state, const Domain &domain, const double error) {
+            state.set_counter(domain.relative ? "max_rel_error" : "max_abs_error", error);
+        }
+
+        /**
+         * @brief Time the standard library, fast scalar and fast float4 versions of a function,
+         *        each reporting its largest error against double precision on the same inputs
+         */
+        template<typename Standard, typename Fast, typename Reference>
+        void add_unary_benchmarks(BenchmarkRegistry &registry, const std::string &name, const Domain domain,
+                                  Standard standard, Fast fast, Reference reference) {
+            const auto get_error = [domain, reference](const std::vector<float> &inputs,
+                                                       const std::vector<float> &outputs) {
+                double error = 0.0;
+                for (size_t i = 0; i < inputs.size(); ++i) {
+                    const double expected = reference(static_cast<double>(inputs[i]));
+                    double difference = std::abs(static_cast<double>(outputs[i]) - expected);
+                    if (domain.relative) {
+                        difference /= std::abs(expected);
+                    }
+                    error = std::max(error, difference);
+                }
+                return error;
+            };
+
+            registry.add(name + "/std", [=](State &state) {
+                const auto inputs = make_inputs(domain, 1);
+                std::vector<float> outputs(inputs.size());
+                const auto body = [&] {
+                    for (size_t i = 0; i < inputs.size(); ++i) {
+                        outputs[i] = standard(inputs[i]);
+                    }
+                    do_not_optimize(outputs.data());
+                };
+                body();
+                set_error_counter(state, domain, get_error(inputs, outputs));
+                state.run(body, inputs.size());
+            });
+
+            registry.add(name + "/fast", [=](State &state) {
+                const auto inputs = make_inputs(domain, 1);
+                std::vector<float> outputs(inputs.size());
+                const auto body = [&] {
+                    for (size_t i = 0; i < inputs.size(); ++i) {
+                        outputs[i] = fast(inputs[i]);
+                    }
+                    do_not_optimize(outputs.data());
+                };
+                body();
+                set_error_counter(state, domain, get_error(inputs, outputs));
+                state.run(body, inputs.size());
+            });
+
+            registry.add(name + "/fast_float4", [=](State &state) {
+                const auto inputs = make_inputs(domain, 1);
+                std::vector<float> outputs(inputs.size());
+                const auto body = [&] {
+                    for (size_t i = 0; i < inputs.size(); i += 4) {
+                        simd::store(&outputs[i], fast(simd::load(&inputs[i])));
+                    }
+                    do_not_optimize(outputs.data());
+                };
+                body();
+                set_error_counter(state, domain, get_error(inputs, outputs));
+                state.run(body, inputs.size());
+            });
+        }
+
+        /**
+         * @brief Rotation angle between two quaternions, in double so float rounding near 1 does not show
+         */
+        double get_angle(const Quaternion &a, const Quaternion &b) {
+            const auto dot = [](const Quaternion &p, const Quaternion &q) {
+                return static_cast<double>(p.x) * q.x + static_cast<double>(p.y) * q.y +
+                       static_cast<double>(p.z) * q.z + static_cast<double>(p.w) * q.w;
+            };
+            const double cosine = std::abs(dot(a, b)) / std::sqrt(dot(a, a) * dot(b, b));
+            return 2.0 * std::acos(std::min(1.0, cosine));
+        }
+
+        void add_matrix_benchmarks(BenchmarkRegistry &registry) {
+            registry.add("math/matrix4/multiply", [](State &state) {
+                math::Xoshiro256 rng(1);
+                std::vector<Matrix4> a(batch_size), b(batch_size), out(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    a[i] = random_transform(rng);
+                    b[i] = random_transform(rng);
+                }
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        out[i] = a[i] * b[i];
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/matrix4/inverse", [](State &state) {
+                math::Xoshiro256 rng(1);
+                std::vector<Matrix4> matrices(batch_size), out(batch_size);
+                for (auto &matrix: matrices) {
+                    matrix = random_transform(rng);
+                }
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        out[i] = matrices[i].inverse();
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/matrix4/transform_point", [](State &state) {
+                math::Xoshiro256 rng(1);
+                const Matrix4 matrix = random_transform(rng);
+                std::vector<Vector3> points(batch_size), out(batch_size);
+                for (auto &point: points) {
+                    point = random_vector(rng, 100.0f);
+                }
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        out[i] = matrix.transform_point(points[i]);
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/stream/transform_points", [](State &state) {
+                math::Xoshiro256 rng(1);
+                const Matrix4 matrix = random_transform(rng);
+                Vector3Array points, out;
+                points.resize(batch_size);
+                out.resize(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    points.set(i, random_vector(rng, 100.0f));
+                }
+                state.run([&] {
+                    math::transform_points(matrix, points, out);
+                    do_not_optimize(out.x.data());
+                }, batch_size);
+            });
+
+            registry.add("math/matrix4/compose_trs", [](State &state) {
+                math::Xoshiro256 rng(1);
+                std::vector<Vector3> positions(batch_size), scales(batch_size);
+                std::vector<Quaternion> rotations(batch_size);
+                std::vector<Matrix4> out(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    positions[i] = random_vector(rng, 100.0f);
+                    rotations[i] = random_rotation(rng);
+                    scales[i] = Vector3(rng.next_float(0.5f, 2.0f));
+                }
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        out[i] = Matrix4::translation(positions[i]) *
+                                 Matrix4(rotations[i].to_rotation_matrix()) * Matrix4::scale(scales[i]);
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/stream/compose_trs", [](State &state) {
+                math::Xoshiro256 rng(1);
+                Vector3Array positions, scales;
+                QuaternionArray rotations;
+                positions.resize(batch_size);
+                scales.resize(batch_size);
+                rotations.resize(batch_size);
+                std::vector<Matrix4> out(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    positions.set(i, random_vector(rng, 100.0f));
+                    rotations.set(i, random_rotation(rng));
+                    scales.set(i, Vector3(rng.next_float(0.5f, 2.0f)));
+                }
+                state.run([&] {
+                    math::compose_trs(positions, rotations, scales, out);
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+        }
+
+        void add_quaternion_benchmarks(BenchmarkRegistry &registry) {
+            struct Inputs {
+                std::vector<Quaternion> a, b, out;
+                std::vector<Vector3> vectors, rotated;
+            };
+            const auto make = [] {
+                math::Xoshiro256 rng(2);
+                Inputs inputs;
+                inputs.a.resize(batch_size);
+                inputs.b.resize(batch_size);
+                inputs.out.resize(batch_size);
+                inputs.vectors.resize(batch_size);
+                inputs.rotated.resize(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    inputs.a[i] = random_rotation(rng);
+                    inputs.b[i] = random_rotation(rng);
+                    inputs.vectors[i] = random_vector(rng, 10.0f);
+                }
+                return inputs;
+            };
+
+            registry.add("math/quaternion/multiply", [make](State &state) {
+                auto inputs = make();
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        inputs.out[i] = inputs.a[i] * inputs.b[i];
+                    }
+                    do_not_optimize(inputs.out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/quaternion/rotate_vector", [make](State &state) {
+                auto inputs = make();
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        inputs.rotated[i] = inputs.a[i].rotate_vector(inputs.vectors[i]);
+                    }
+                    do_not_optimize(inputs.rotated.data());
+                }, batch_size);
+            });
+
+            registry.add("math/quaternion/normalize", [make](State &state) {
+                auto inputs = make();
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        inputs.out[i] = (inputs.a[i] * 1.5f).normalized();
+                    }
+                    do_not_optimize(inputs.out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/quaternion/to_rotation_matrix", [make](State &state) {
+                auto inputs = make();
+                std::vector<Matrix3> out(batch_size);
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        out[i] = inputs.a[i].to_rotation_matrix();
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            // Interpolation at a different t per element, as for bodies between physics steps
+            const auto add_interpolation = [&registry, make](const std::string &name, auto interpolate) {
+                registry.add("math/quaternion/" + name, [make, interpolate](State &state) {
+                    auto inputs = make();
+                    const auto body = [&] {
+                        for (size_t i = 0; i < batch_size; ++i) {
+                            const float t = static_cast<float>(i) * (1.0f / batch_size);
+                            inputs.out[i] = interpolate(inputs.a[i], inputs.b[i], t);
+                        }
+                        do_not_optimize(inputs.out.data());
+                    };
+
+                    body();
+                    double error = 0.0;
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        const float t = static_cast<float>(i) * (1.0f / batch_size);
+                        const Quaternion exact = inputs.a[i].slerp(inputs.b[i], t);
+                        error = std::max(error, get_angle(exact, inputs.out[i]));
+                    }
+                    state.set_counter("max_angle_error", error);
+                    state.run(body, batch_size);
+                });
+            };
+            add_interpolation("slerp", [](const Quaternion &a, const Quaternion &b, const float t) {
+                return a.slerp(b, t);
+            });
+            add_interpolation("fast_slerp", [](const Quaternion &a, const Quaternion &b, const float t) {
+                return math::fast::slerp(a, b, t);
+            });
+            add_interpolation("nlerp", [](const Quaternion &a, const Quaternion &b, const float t) {
+                return math::fast::nlerp(a, b, t);
+            });
+        }
+
+        void add_bounds_benchmarks(BenchmarkRegistry &registry) {
+            registry.add("math/aabb/intersects", [](State &state) {
+                math::Xoshiro256 rng(3);
+                std::vector<AABB> boxes(batch_size + 1);
+                for (auto &box: boxes) {
+                    box = random_box(rng, 4.0f, 2.0f);
+                }
+                size_t hits = 0;
+                state.run([&] {
+                    size_t count = 0;
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        count += boxes[i].intersects(boxes[i + 1]);
+                    }
+                    hits = count;
+                    do_not_optimize(hits);
+                }, batch_size);
+                state.set_counter("hit_rate", static_cast<double>(hits) / batch_size);
+            });
+
+            registry.add("math/aabb/contains_point", [](State &state) {
+                math::Xoshiro256 rng(3);
+                std::vector<AABB> boxes(batch_size);
+                std::vector<Vector3> points(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    boxes[i] = random_box(rng, 10.0f, 8.0f);
+                    points[i] = random_vector(rng, 10.0f);
+                }
+                state.run([&] {
+                    size_t count = 0;
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        count += boxes[i].contains(points[i]);
+                    }
+                    do_not_optimize(count);
+                }, batch_size);
+            });
+
+            registry.add("math/aabb/intersect_ray", [](State &state) {
+                math::Xoshiro256 rng(3);
+                std::vector<AABB> boxes(batch_size);
+                std::vector<Vector3> directions(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    boxes[i] = random_box(rng, 50.0f, 10.0f);
+                    directions[i] = normalize(random_vector(rng, 1.0f));
+                }
+                state.run([&] {
+                    size_t count = 0;
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        float t_min = 0.0f;
+                        float t_max = 0.0f;
+                        count += boxes[i].intersect_ray(Vector3::zero(), directions[i], t_min, t_max);
+                    }
+                    do_not_optimize(count);
+                }, batch_size);
+            });
+
+            registry.add("math/aabb/transform", [](State &state) {
+                math::Xoshiro256 rng(3);
+                std::vector<AABB> boxes(batch_size), out(batch_size);
+                std::vector<Matrix4> matrices(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    boxes[i] = random_box(rng, 1.0f, 2.0f);
+                    matrices[i] = random_transform(rng);
+                }
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        out[i] = boxes[i].transform(matrices[i]);
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/stream/transform_aabbs", [](State &state) {
+                math::Xoshiro256 rng(3);
+                Vector3Array local_min, local_max, world_min, world_max;
+                for (auto *array: {&local_min, &local_max, &world_min, &world_max}) {
+                    array->resize(batch_size);
+                }
+                std::vector<Matrix4> matrices(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    const AABB box = random_box(rng, 1.0f, 2.0f);
+                    local_min.set(i, box.min);
+                    local_max.set(i, box.max);
+                    matrices[i] = random_transform(rng);
+                }
+                state.run([&] {
+                    math::transform_aabbs(matrices, local_min, local_max, world_min, world_max);
+                    do_not_optimize(world_min.x.data());
+                }, batch_size);
+            });
+
+            registry.add("math/frustum/intersects_aabb", [](State &state) {
+                math::Xoshiro256 rng(3);
+                const Matrix4 view_projection = Matrix4::perspective(60.0f, 16.0f / 9.0f, 0.1f, 500.0f) *
+                                                Matrix4::look_at(Vector3::zero(), Vector3(0.0f, 0.0f, 1.0f),
+                                                                 Vector3::up());
+                const Frustum frustum = Frustum::from_matrix(view_projection);
+                std::vector<AABB> boxes(batch_size);
+                for (auto &box: boxes) {
+                    box = random_box(rng, 200.0f, 4.0f);
+                }
+                size_t visible = 0;
+                state.run([&] {
+                    size_t count = 0;
+                    for (const auto &box: boxes) {
+                        count += frustum.intersects(box);
+                    }
+                    visible = count;
+                    do_not_optimize(visible);
+                }, batch_size);
+                state.set_counter("visible_rate", static_cast<double>(visible) / batch_size);
+            });
+        }
+
+        void add_integer_benchmarks(BenchmarkRegistry &registry) {
+            registry.add("math/morton/encode_3d", [](State &state) {
+                std::vector<u64> out(batch_size);
+                u32 base = 0;
+                state.run([&] {
+                    for (u32 i = 0; i < batch_size; ++i) {
+                        const u32 value = base + i;
+                        out[i] = math::morton_encode_3d(value & 1023, value >> 10 & 1023, value >> 20 & 1023);
+                    }
+                    base += batch_size;
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/morton/decode_3d", [](State &state) {
+                math::Xoshiro256 rng(4);
+                std::vector<u64> codes(batch_size);
+                std::vector<std::array<u32, 3> > out(batch_size);
+                for (auto &code: codes) {
+                    code = rng.next_u64() >> 34;
+                }
+                state.run([&] {
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        out[i] = math::morton_decode_3d(codes[i]);
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/hash/coordinates_3d", [](State &state) {
+                std::vector<u64> out(batch_size);
+                i32 base = 0;
+                state.run([&] {
+                    for (i32 i = 0; i < static_cast<i32>(batch_size); ++i) {
+                        out[i] = math::hash_coordinates(base + i, i, -i);
+                    }
+                    ++base;
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+        }
+
+        void add_random_benchmarks(BenchmarkRegistry &registry) {
+            // What math::random_float used before the xoshiro256++ streams
+            registry.add("math/random/mt19937_float", [](State &state) {
+                std::mt19937 engine(1);
+                std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+                std::vector<float> out(batch_size);
+                state.run([&] {
+                    for (auto &value: out) {
+                        value = distribution(engine);
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/random/random_float", [](State &state) {
+                math::seed_random(1);
+                std::vector<float> out(batch_size);
+                state.run([&] {
+                    for (auto &value: out) {
+                        value = math::random_float();
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/random/xoshiro256_float", [](State &state) {
+                math::Xoshiro256 rng(1);
+                std::vector<float> out(batch_size);
+                state.run([&] {
+                    for (auto &value: out) {
+                        value = rng.next_float();
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/random/xoshiro256_fill_float", [](State &state) {
+                math::Xoshiro256 rng(1);
+                std::vector<float> out(batch_size);
+                state.run([&] {
+                    rng.fill(std::span{out});
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/random/pcg32_float", [](State &state) {
+                math::Pcg32 rng(1);
+                std::vector<float> out(batch_size);
+                state.run([&] {
+                    for (auto &value: out) {
+                        value = rng.next_float();
+                    }
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+
+            registry.add("math/random/positional", [](State &state) {
+                std::vector<u64> out(batch_size);
+                i32 base = 0;
+                state.run([&] {
+                    for (i32 i = 0; i < static_cast<i32>(batch_size); ++i) {
+                        out[i] = math::rng(42, base, i, 7);
+                    }
+                    ++base;
+                    do_not_optimize(out.data());
+                }, batch_size);
+            });
+        }
+
+        void add_fast_math_benchmarks(BenchmarkRegistry &registry) {
+            add_unary_benchmarks(registry, "math/fast/sin", {-100.0f, 100.0f, false, false},
+                                 [](const float x) { return std::sin(x); },
+                                 [](const auto x) { return math::fast::sin(x); },
+                                 [](const double x) { return std::sin(x); });
+            add_unary_benchmarks(registry, "math/fast/exp", {-80.0f, 80.0f, false, true},
+                                 [](const float x) { return std::exp(x); },
+                                 [](const auto x) { return math::fast::exp(x); },
+                                 [](const double x) { return std::exp(x); });
+            add_unary_benchmarks(registry, "math/fast/log", {1e-6f, 1e6f, true, false},
+                                 [](const float x) { return std::log(x); },
+                                 [](const auto x) { return math::fast::log(x); },
+                                 [](const double x) { return std::log(x); });
+            add_unary_benchmarks(registry, "math/fast/rsqrt", {1e-6f, 1e6f, true, true},
+                                 [](const float x) { return 1.0f / std::sqrt(x); },
+                                 [](const auto x) { return math::fast::rsqrt(x); },
+                                 [](const double x) { return 1.0 / std::sqrt(x); });
+
+            // atan2 over points in a square around the origin
+            const auto add_atan2 = [&registry](const std::string &name, auto body_for) {
+                registry.add("math/fast/atan2/" + name, [body_for](State &state) {
+                    const auto y = make_inputs({-10.0f, 10.0f, false, false}, 1);
+                    const auto x = make_inputs({-10.0f, 10.0f, false, false}, 2);
+                    std::vector<float> out(batch_size);
+                    const auto body = [&] {
+                        body_for(y, x, out);
+                        do_not_optimize(out.data());
+                    };
+                    body();
+                    double error = 0.0;
+                    for (size_t i = 0; i < batch_size; ++i) {
+                        const double expected = std::atan2(static_cast<double>(y[i]), static_cast<double>(x[i]));
+                        error = std::max(error, std::abs(static_cast<double>(out[i]) - expected));
+                    }
+                    state.set_counter("max_abs_error", error);
+                    state.run(body, batch_size);
+                });
+            };
+            add_atan2("std", [](const std::vector<float> &y, const std::vector<float> &x, std::vector<float> &out) {
+                for (size_t i = 0; i < out.size(); ++i) {
+                    out[i] = std::atan2(y[i], x[i]);
+                }
+            });
+            add_atan2("fast", [](const std::vector<float> &y, const std::vector<float> &x, std::vector<float> &out) {
+                for (size_t i = 0; i < out.size(); ++i) {
+                    out[i] = math::fast::atan2(y[i], x[i]);
+                }
+            });
+            add_atan2("fast_float4", [](const std::vector<float> &y, const std::vector<float> &x,
+                                        std::vector<float> &out) {
+                for (size_t i = 0; i < out.size(); i += 4) {
+                    simd::store(&out[i], math::fast::atan2(simd::load(&y[i]), simd::load(&x[i])));
+                }
+            });
+        }
+        bool same_bits(const std::vector<float> &a, const std::vector<float> &b) {
+            return std::ranges::equal(a, b, [](const float x, const float y) {
+                return std::bit_cast<u32>(x) == std::bit_cast<u32>(y);
+            });
+        }
+
+        /**
+         * @brief Benchmark a physics integration kernel over packed lanes and check it against its scalar path
+         * @param lane_extents Range of the random values in each lane, outputs first
+         * @param kernel Called with the lanes, the first element and the element count
+         */
+        template<size_t LaneCount, typename Kernel>
+        void add_integration_benchmark(BenchmarkRegistry &registry, const std::string &name,
+                                       const std::array<float, LaneCount> lane_extents, Kernel kernel) {
+            registry.add(name, [lane_extents, kernel](State &state) {
+                using Lanes = std::array<std::vector<float>, LaneCount>;
+                math::Xoshiro256 rng(31);
+                Lanes lanes;
+                for (size_t lane = 0; lane < LaneCount; ++lane) {
+                    lanes[lane].resize(batch_size);
+                    for (auto &value: lanes[lane]) {
+                        value = rng.next_float(-lane_extents[lane], lane_extents[lane]);
+                    }
+                }
+
+                // One element per call always takes the scalar tail, the reference for the float4 loop.
+                Lanes reference = lanes;
+                kernel(lanes, 0, lanes[0].size());
+                for (size_t i = 0; i < batch_size; ++i) {
+                    kernel(reference, i, 1);
+                }
+                state.check(std::ranges::equal(lanes, reference, same_bits),
+                            "float4 loop differs from the scalar path");
+
+                state.run([&] {
+                    kernel(lanes, 0, lanes[0].size());
+                    clobber_memory();
+                }, batch_size);
+            });
+        }
+
+        void add_integration_benchmarks(BenchmarkRegistry &registry) {
+            add_integration_benchmark<6>(registry, "physics/integrate_positions",
+                                         {500.0f, 500.0f, 500.0f, 5.0f, 5.0f, 5.0f},
+                                         [](auto &l, const size_t begin, const size_t count) {
+                                             physics::integrate_positions(&l[0][begin], &l[1][begin], &l[2][begin],
+                                                                          &l[3][begin], &l[4][begin], &l[5][begin],
+                                                                          count, fixed_dt);
+                                         });
+
+            // Unnormalized starting orientations; the first step normalizes them
+            add_integration_benchmark<7>(registry, "physics/integrate_rotations",
+                                         {1.0f, 1.0f, 1.0f, 1.0f, 4.0f, 4.0f, 4.0f},
+                                         [](auto &l, const size_t begin, const size_t count) {
+                                             physics::integrate_rotations(&l[0][begin], &l[1][begin], &l[2][begin],
+                                                                          &l[3][begin], &l[4][begin], &l[5][begin],
+                                                                          &l[6][begin], count, fixed_dt);
+                                         });
+        }
+    }
+
+    void register_math_benchmarks(BenchmarkRegistry &registry) {
+        add_matrix_benchmarks(registry);
+        add_quaternion_benchmarks(registry);
+        add_bounds_benchmarks(registry);
+        add_integer_benchmarks(registry);
+        add_random_benchmarks(registry);
+        add_fast_math_benchmarks(registry);
+        add_integration_benchmarks(registry);
+    }
+}
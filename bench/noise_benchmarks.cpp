@@ -0,0 +1,114 @@
+#include "benchmark.hpp"
+#include "suites.hpp"
+#include "core/math/noise/noise.hpp"
+
+namespace softcube::bench {
+    namespace {
+        using math::noise::FractalType;
+        using math::noise::NoiseGenerator;
+        using math::noise::NoiseSettings;
+        using math::noise::NoiseType;
+
+        constexpr IVector2 grid_size_2d{128, 128};
+        constexpr IVector3 grid_size_3d{32, 32, 32};
+        constexpr size_t cell_count_2d = static_cast<size_t>(grid_size_2d.x) * grid_size_2d.y;
+        constexpr size_t cell_count_3d = static_cast<size_t>(grid_size_3d.x) * grid_size_3d.y * grid_size_3d.z;
+
+        // Away from the origin, where lattice coordinates are no longer small
+        const Vector2 origin_2d{1000.5f, -2000.25f};
+        const Vector3 origin_3d{1000.5f, 64.0f, -2000.25f};
+
+        /**
+         * @brief Sample a grid one position at a time, the way code without fill_grid would
+         */
+        void add_single_benchmarks(BenchmarkRegistry &registry, const std::string &name,
+                                   const NoiseSettings &settings) {
+            registry.add(name + "/single_2d", [settings](State &state) {
+                const NoiseGenerator generator(settings);
+                std::vector<float> out(cell_count_2d);
+                state.run([&] {
+                    size_t index = 0;
+                    for (i32 y = 0; y < grid_size_2d.y; ++y) {
+                        for (i32 x = 0; x < grid_size_2d.x; ++x) {
+                            out[index++] = generator.sample(origin_2d + Vector2(static_cast<float>(x),
+                                                                                static_cast<float>(y)));
+                        }
+                    }
+                    do_not_optimize(out.data());
+                }, cell_count_2d);
+            });
+
+            registry.add(name + "/single_3d", [settings](State &state) {
+                const NoiseGenerator generator(settings);
+                std::vector<float> out(cell_count_3d);
+                state.run([&] {
+                    size_t index = 0;
+                    for (i32 z = 0; z < grid_size_3d.z; ++z) {
+                        for (i32 y = 0; y < grid_size_3d.y; ++y) {
+                            for (i32 x = 0; x < grid_size_3d.x; ++x) {
+                                out[index++] = generator.sample(origin_3d + Vector3(static_cast<float>(x),
+                                                                    static_cast<float>(y), static_cast<float>(z)));
+                            }
+                        }
+                    }
+                    do_not_optimize(out.data());
+                }, cell_count_3d);
+            });
+        }
+
+        void add_grid_benchmarks(BenchmarkRegistry &registry, const std::string &name,
+                                 const NoiseSettings &settings) {
+            registry.add(name + "/grid_2d", [settings](State &state) {
+                const NoiseGenerator generator(settings);
+                std::vector<float> out(cell_count_2d);
+                state.run([&] {
+                    generator.fill_grid(origin_2d, 1.0f, grid_size_2d, out);
+                    do_not_optimize(out.data());
+                }, cell_count_2d);
+            });
+
+            registry.add(name + "/grid_3d", [settings](State &state) {
+                const NoiseGenerator generator(settings);
+                std::vector<float> out(cell_count_3d);
+                state.run([&] {
+                    generator.fill_grid(origin_3d, 1.0f, grid_size_3d, out);
+                    do_not_optimize(out.data());
+                }, cell_count_3d);
+            });
+        }
+
+        NoiseSettings make_settings(const NoiseType type, const FractalType fractal, const i32 octaves) {
+            NoiseSettings settings;
+            settings.type = type;
+            settings.fractal = fractal;
+            settings.octaves = octaves;
+            settings.frequency = 0.02f;
+            return settings;
+        }
+    }
+
+    void register_noise_benchmarks(BenchmarkRegistry &registry) {
+        constexpr std::array types{
+            std::pair{NoiseType::Perlin, "perlin"},
+            std::pair{NoiseType::OpenSimplex2, "open_simplex2"},
+            std::pair{NoiseType::Cellular, "cellular"}
+        };
+
+        // One octave: the cost of the base noise itself
+        for (const auto &[type, type_name]: types) {
+            const std::string name = std::string("noise/") + type_name;
+            const NoiseSettings settings = make_settings(type, FractalType::None, 1);
+            add_single_benchmarks(registry, name, settings);
+            add_grid_benchmarks(registry, name, settings);
+        }
+
+        // Terrain-style settings: four octaves of fBm, then the same with domain warping
+        const NoiseSettings fbm = make_settings(NoiseType::OpenSimplex2, FractalType::FBm, 4);
+        add_single_benchmarks(registry, "noise/fbm4", fbm);
+        add_grid_benchmarks(registry, "noise/fbm4", fbm);
+
+        NoiseSettings warped = fbm;
+        warped.warp_amplitude = 30.0f;
+        add_grid_benchmarks(registry, "noise/fbm4_warped", warped);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "benchmark.hpp"
+
+namespace softcube::bench {
+    /**
+     * @brief Matrix, quaternion, AABB and frustum operations, SoA stream kernels, Morton codes,
+     *        hashing, random number generators, the fast transcendental functions and the physics
+     *        integration kernels, each checked bit for bit against its scalar path
+     */
+    void register_math_benchmarks(BenchmarkRegistry &registry);
+
+    /**
+     * @brief Single samples and grid fills for every noise type, with and without fractals
+     */
+    void register_noise_benchmarks(BenchmarkRegistry &registry);
+
+    /**
+     * @brief Voxel ray traversal over a generated world, world to chunk to local coordinate conversion
+     *        and the face and ambient occlusion tables
+     */
+    void register_voxel_benchmarks(BenchmarkRegistry &registry);
+
+    /**
+     * @brief View and owning-group iteration, storages, hierarchy and transform propagation, command buffers,
+     *        prefabs, snapshots, delta history, the spatial index, physics integration and profiler overhead
+     */
+    void register_ecs_benchmarks(BenchmarkRegistry &registry);
+
+    /**
+     * @brief Dynamic AABB tree, job system including nested parallel_for, frame allocator and memory pools,
+     *        alone and under eight threads
+     */
+    void register_core_benchmarks(BenchmarkRegistry &registry);
+}
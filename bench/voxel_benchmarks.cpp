@@ -0,0 +1,282 @@
+#include "benchmark.hpp"
+#include "suites.hpp"
+#include "core/math/noise/noise.hpp"
+#include "core/math/random.hpp"
+#include "core/voxel/voxel_raycast.hpp"
+#include "core/voxel/voxel_tables.hpp"
+#include "core/voxel/world_position.hpp"
+
+namespace softcube::voxel {
+    namespace {
+        /**
+         * @class World
+         * @brief Heightmap terrain standing in for chunk storage, which the engine does not have yet
+         *
+         * Blocks below the height of their column are solid. The map repeats
+         * every world_size blocks. A chunk is empty when it lies above the
+         * highest column in its footprint, so rays through the sky skip whole
+         * chunks while rays grazing the terrain walk block by block.
+         */
+        class World {
+        public:
+            static constexpr i32 world_size = 256;
+            static constexpr i32 chunk_columns = world_size / chunk_size;
+
+            World() {
+                math::noise::NoiseSettings settings;
+                settings.frequency = 0.01f;
+                settings.octaves = 4;
+                const math::noise::NoiseGenerator generator(settings);
+
+                std::vector<float> noise(static_cast<size_t>(world_size) * world_size);
+                generator.fill_grid(Vector2::zero(), 1.0f, IVector2(world_size, world_size), noise);
+                for (size_t i = 0; i < noise.size(); ++i) {
+                    m_heights[i] = static_cast<u8>(std::clamp(40.0f + 20.0f * noise[i], 1.0f, 100.0f));
+                }
+
+                m_chunk_tops.fill(0);
+                for (i32 z = 0; z < world_size; ++z) {
+                    for (i32 x = 0; x < world_size; ++x) {
+                        u8 &top = m_chunk_tops[(z / chunk_size) * chunk_columns + x / chunk_size];
+                        top = std::max(top, get_height(x, z));
+                    }
+                }
+            }
+
+            [[nodiscard]] u8 get_height(const i32 x, const i32 z) const {
+                return m_heights[(z & (world_size - 1)) * world_size + (x & (world_size - 1))];
+            }
+
+            [[nodiscard]] bool is_opaque(const IVector3 &block) const {
+                return block.y < get_height(block.x, block.z);
+            }
+
+            [[nodiscard]] bool is_chunk_empty(const IVector3 &chunk) const {
+                const i32 column = (chunk.z & (chunk_columns - 1)) * chunk_columns + (chunk.x & (chunk_columns - 1));
+                return chunk.y * chunk_size >= m_chunk_tops[column];
+            }
+
+        private:
+            std::array<u8, world_size * world_size> m_heights{};
+            std::array<u8, chunk_columns * chunk_columns> m_chunk_tops{};
+        };
+
+        constexpr size_t ray_count = 256;
+        constexpr float max_distance = 200.0f;
+
+        /**
+         * @struct Rays
+         * @brief Rays from above the terrain in every direction, so some hit the ground and some leave the world
+         */
+        struct Rays {
+            std::vector<Vector3> origins;
+            std::vector<Vector3> directions;
+
+            Rays() {
+                math::Xoshiro256 rng(5);
+                origins.resize(ray_count);
+                directions.resize(ray_count);
+                for (size_t i = 0; i < ray_count; ++i) {
+                    origins[i] = Vector3(rng.next_float(0.0f, 256.0f), rng.next_float(70.0f, 120.0f),
+                                         rng.next_float(0.0f, 256.0f));
+                    Vector3 direction;
+                    do {
+                        direction = Vector3(rng.next_float(-1.0f, 1.0f), rng.next_float(-1.0f, 1.0f),
+                                            rng.next_float(-1.0f, 1.0f));
+                    } while (direction.length_squared() < 0.01f || direction.length_squared() > 1.0f);
+                    directions[i] = normalize(direction);
+                }
+            }
+        };
+
+        void add_raycast_benchmarks(bench::BenchmarkRegistry &registry) {
+            registry.add("voxel/raycast/flat", [](bench::State &state) {
+                const auto world = std::make_unique<World>();
+                const Rays rays;
+                size_t hits = 0;
+                size_t visited = 0;
+                state.run([&] {
+                    hits = 0;
+                    visited = 0;
+                    for (size_t i = 0; i < ray_count; ++i) {
+                        const auto hit = raycast(rays.origins[i], rays.directions[i], max_distance,
+                                                 [&](const VoxelRayHit &candidate) {
+                                                     ++visited;
+                                                     return world->is_opaque(candidate.block);
+                                                 });
+                        hits += hit.has_value();
+                    }
+                    bench::do_not_optimize(hits);
+                }, ray_count);
+                state.set_counter("hit_rate", static_cast<double>(hits) / ray_count);
+                state.set_counter("blocks_per_ray", static_cast<double>(visited) / ray_count);
+            });
+
+            registry.add("voxel/raycast/hierarchical", [](bench::State &state) {
+                const auto world = std::make_unique<World>();
+                const Rays rays;
+                size_t hits = 0;
+                size_t visited = 0;
+                state.run([&] {
+                    hits = 0;
+                    visited = 0;
+                    for (size_t i = 0; i < ray_count; ++i) {
+                        const auto hit = raycast(rays.origins[i], rays.directions[i], max_distance,
+                                                 [&](const IVector3 &chunk) { return world->is_chunk_empty(chunk); },
+                                                 [&](const VoxelRayHit &candidate) {
+                                                     ++visited;
+                                                     return world->is_opaque(candidate.block);
+                                                 });
+                        hits += hit.has_value();
+                    }
+                    bench::do_not_optimize(hits);
+                }, ray_count);
+                state.set_counter("hit_rate", static_cast<double>(hits) / ray_count);
+                state.set_counter("blocks_per_ray", static_cast<double>(visited) / ray_count);
+            });
+
+            registry.add("voxel/line_of_sight", [](bench::State &state) {
+                const auto world = std::make_unique<World>();
+                const Rays rays;
+                std::vector<Vector3> targets(ray_count);
+                for (size_t i = 0; i < ray_count; ++i) {
+                    targets[i] = rays.origins[i] + rays.directions[i] * 64.0f;
+                }
+                // std::vector<bool> has no contiguous storage to hand out as a span
+                const auto visible = std::make_unique<bool[]>(ray_count);
+                const std::span<bool> visible_span(visible.get(), ray_count);
+                state.run([&] {
+                    line_of_sight(rays.origins, targets, visible_span,
+                                  [&](const IVector3 &chunk) { return world->is_chunk_empty(chunk); },
+                                  [&](const IVector3 &block) { return world->is_opaque(block); });
+                    bench::do_not_optimize(visible[0]);
+                }, ray_count);
+                state.set_counter("visible_rate", static_cast<double>(std::ranges::count(visible_span, true)) / ray_count);
+            });
+        }
+
+        void add_coordinate_benchmarks(bench::BenchmarkRegistry &registry) {
+            constexpr size_t position_count = 1024;
+            constexpr float extent = 100'000.0f; // Far enough out that chunk coordinates are large and negative too
+
+            // World position to block, chunk, local position and block index, the lookup behind every block access
+            registry.add("voxel/coordinates/world_to_local", [](bench::State &state) {
+                math::Xoshiro256 rng(9);
+                std::vector<Vector3> positions(position_count);
+                for (auto &position: positions) {
+                    position = Vector3(rng.next_float(-extent, extent), rng.next_float(-extent, extent),
+                                       rng.next_float(-extent, extent));
+                }
+
+                bool round_trips = true;
+                for (const auto &position: positions) {
+                    const IVector3 block = world_to_block(position);
+                    const IVector3 local = index_to_local(local_to_index(block_to_local(block)));
+                    round_trips = round_trips && chunk_to_block(block_to_chunk(block), local) == block;
+                }
+                state.check(round_trips, "chunk and local position do not map back to the block");
+
+                state.run([&] {
+                    i32 sum = 0;
+                    for (const auto &position: positions) {
+                        const IVector3 block = world_to_block(position);
+                        const IVector3 chunk = block_to_chunk(block);
+                        sum += chunk.x ^ chunk.y ^ chunk.z ^ local_to_index(block_to_local(block));
+                    }
+                    bench::do_not_optimize(sum);
+                }, position_count);
+            });
+
+            // Absolute coordinates split into chunk and offset, then made relative to a camera, as for a spawn
+            registry.add("voxel/coordinates/world_position", [](bench::State &state) {
+                math::Xoshiro256 rng(10);
+                std::vector<std::array<double, 3> > coordinates(position_count);
+                for (auto &[x, y, z]: coordinates) {
+                    x = rng.next_float(-extent, extent) * 10.0;
+                    y = rng.next_float(-extent, extent);
+                    z = rng.next_float(-extent, extent) * 10.0;
+                }
+                const WorldPosition camera = WorldPosition::from_world(123'456.5, 64.0, -654'321.25);
+
+                state.run([&] {
+                    Vector3 sum;
+                    for (const auto &[x, y, z]: coordinates) {
+                        sum += WorldPosition::from_world(x, y, z).relative_to(camera);
+                    }
+                    bench::do_not_optimize(sum);
+                }, position_count);
+            });
+        }
+
+        void add_table_benchmarks(bench::BenchmarkRegistry &registry) {
+            // Ambient occlusion for every exposed face of one chunk the terrain surface passes through,
+            // the per-face work of a mesher.
+            registry.add("voxel/face_ambient_occlusion", [](bench::State &state) {
+                constexpr i32 padded = chunk_size + 2;
+                const auto world = std::make_unique<World>();
+                const IVector3 low = chunk_to_block(IVector3(0, 2, 0));
+
+                std::vector<u8> solid(static_cast<size_t>(padded) * padded * padded);
+                const auto index = [](const IVector3 &p) {
+                    return static_cast<size_t>(((p.z + 1) * padded + (p.y + 1)) * padded + (p.x + 1));
+                };
+                for (i32 z = -1; z <= chunk_size; ++z) {
+                    for (i32 y = -1; y <= chunk_size; ++y) {
+                        for (i32 x = -1; x <= chunk_size; ++x) {
+                            solid[index({x, y, z})] = world->is_opaque(low + IVector3(x, y, z));
+                        }
+                    }
+                }
+
+                const auto count_faces = [&] {
+                    size_t faces = 0;
+                    for (i32 i = 0; i < chunk_volume; ++i) {
+                        const IVector3 local = index_to_local(i);
+                        if (!solid[index(local)]) {
+                            continue;
+                        }
+                        for (size_t face = 0; face < face_count; ++face) {
+                            faces += !solid[index(local + face_offsets[face])];
+                        }
+                    }
+                    return faces;
+                };
+                const size_t face_total = count_faces();
+
+                std::vector<u8> flips;
+                flips.reserve(face_total);
+                state.run([&] {
+                    flips.clear();
+                    for (i32 i = 0; i < chunk_volume; ++i) {
+                        const IVector3 local = index_to_local(i);
+                        if (!solid[index(local)]) {
+                            continue;
+                        }
+                        for (size_t face = 0; face < face_count; ++face) {
+                            if (solid[index(local + face_offsets[face])]) {
+                                continue;
+                            }
+                            std::array<u8, 4> ao{};
+                            for (size_t corner = 0; corner < 4; ++corner) {
+                                const auto &[side1, side2, diagonal] = ao_neighbors[face][corner];
+                                ao[corner] = ambient_occlusion(solid[index(local + side1)], solid[index(local + side2)],
+                                                               solid[index(local + diagonal)]);
+                            }
+                            flips.push_back(should_flip_quad(ao));
+                        }
+                    }
+                    bench::do_not_optimize(flips.data());
+                }, std::max<size_t>(face_total, 1));
+                state.set_counter("faces", static_cast<double>(face_total));
+            });
+        }
+    }
+}
+
+namespace softcube::bench {
+    void register_voxel_benchmarks(BenchmarkRegistry &registry) {
+        voxel::add_raycast_benchmarks(registry);
+        voxel::add_coordinate_benchmarks(registry);
+        voxel::add_table_benchmarks(registry);
+    }
+}
@@ -93,8 +93,6 @@
 // SDL3
 #include <SDL3/SDL.h>
 
-#include "math/math.hpp"
-
 // Engine-wide type definitions
 namespace softcube {
     using i8 = int8_t;
@@ -110,6 +108,9 @@ namespace softcube {
     using byte = u8;
 }
 
+// Math types use the definitions above
+#include "math/math.hpp"
+
 using namespace softcube;
 
 #define SOFTCUBE_VERSION_MAJOR 0
@@ -0,0 +1,120 @@
+#include "mapped_file.hpp"
+
+#ifndef SOFTCUBE_PLATFORM_WINDOWS
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace softcube {
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            close();
+
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+            m_file = std::exchange(other.m_file, INVALID_HANDLE_VALUE);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+
+        return *this;
+    }
+
+    bool MappedFile::open(const std::filesystem::path &path) {
+        close();
+
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+        m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            SC_ERROR("Failed to open {}", path.string());
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            SC_ERROR("Failed to map {}: empty or unreadable file", path.string());
+            close();
+            return false;
+        }
+
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) {
+            SC_ERROR("Failed to create file mapping for {}", path.string());
+            close();
+            return false;
+        }
+
+        m_data = static_cast<const std::byte *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data) {
+            SC_ERROR("Failed to map view of {}", path.string());
+            close();
+            return false;
+        }
+
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            SC_ERROR("Failed to open {}", path.string());
+            return false;
+        }
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            SC_ERROR("Failed to map {}: empty or unreadable file", path.string());
+            ::close(fd);
+            return false;
+        }
+
+        void *data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (data == MAP_FAILED) {
+            SC_ERROR("Failed to map {}", path.string());
+            return false;
+        }
+
+        madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+        m_data = static_cast<const std::byte *>(data);
+        m_size = static_cast<size_t>(info.st_size);
+#endif
+
+        return true;
+    }
+
+    void MappedFile::close() {
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_data) {
+            munmap(const_cast<std::byte *>(m_data), m_size);
+        }
+#endif
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+
+#include <span>
+
+namespace softcube {
+    /**
+     * @class MappedFile
+     * @brief Read-only memory mapping of a whole file
+     *
+     * The mapping is released when the object is destroyed. Pages are loaded
+     * lazily by the OS, so opening a large file is cheap and only the parts
+     * that are read are ever brought into memory.
+     */
+    class MappedFile {
+        SC_LOG_GROUP(CORE::MAPPED_FILE);
+
+    public:
+        MappedFile() = default;
+
+        ~MappedFile();
+
+        MappedFile(MappedFile &&other) noexcept;
+
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /**
+         * @brief Map a file into memory
+         * @param path File to map
+         * @return True if the file was mapped
+         */
+        bool open(const std::filesystem::path &path);
+
+        /**
+         * @brief Unmap the file
+         */
+        void close();
+
+        [[nodiscard]] bool is_open() const { return m_data != nullptr; }
+
+        [[nodiscard]] std::span<const std::byte> get_data() const { return {m_data, m_size}; }
+
+        [[nodiscard]] size_t get_size() const { return m_size; }
+
+    private:
+        const std::byte *m_data = nullptr;
+        size_t m_size = 0;
+
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+    };
+}
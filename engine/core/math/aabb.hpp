@@ -12,18 +12,18 @@ namespace softcube {
         Vector3 min;
         Vector3 max;
 
-        AABB() : min(Vector3(std::numeric_limits<float>::max())),
-                 max(Vector3(-std::numeric_limits<float>::max())) {
+        constexpr AABB() : min(Vector3(std::numeric_limits<float>::max())),
+                           max(Vector3(-std::numeric_limits<float>::max())) {
         }
 
-        AABB(const Vector3 &min, const Vector3 &max) : min(min), max(max) {
+        constexpr AABB(const Vector3 &min, const Vector3 &max) : min(min), max(max) {
         }
 
-        static AABB from_center_and_extents(const Vector3 &center, const Vector3 &half_extents) {
+        static constexpr AABB from_center_and_extents(const Vector3 &center, const Vector3 &half_extents) {
             return {center - half_extents, center + half_extents};
         }
 
-        static AABB from_points(const Vector3 *points, size_t count) {
+        static constexpr AABB from_points(const Vector3 *points, size_t count) {
             AABB result;
             for (size_t i = 0; i < count; ++i) {
                 result.expand(points[i]);
@@ -31,33 +31,33 @@ namespace softcube {
             return result;
         }
 
-        [[nodiscard]] Vector3 center() const {
+        [[nodiscard]] constexpr Vector3 center() const {
             return (min + max) * 0.5f;
         }
 
-        [[nodiscard]] Vector3 extents() const {
+        [[nodiscard]] constexpr Vector3 extents() const {
             return (max - min) * 0.5f;
         }
 
-        [[nodiscard]] Vector3 size() const {
+        [[nodiscard]] constexpr Vector3 size() const {
             return max - min;
         }
 
-        [[nodiscard]] float volume() const {
+        [[nodiscard]] constexpr float volume() const {
             Vector3 s = size();
             return s.x * s.y * s.z;
         }
 
-        [[nodiscard]] float surface_area() const {
+        [[nodiscard]] constexpr float surface_area() const {
             Vector3 s = size();
             return 2.0f * (s.x * s.y + s.x * s.z + s.y * s.z);
         }
 
-        [[nodiscard]] bool is_valid() const {
+        [[nodiscard]] constexpr bool is_valid() const {
             return min.x <= max.x && min.y <= max.y && min.z <= max.z;
         }
 
-        void get_corners(Vector3 corners[8]) const {
+        constexpr void get_corners(Vector3 corners[8]) const {
             corners[0] = min;
             corners[1] = Vector3(max.x, min.y, min.z);
             corners[2] = Vector3(max.x, max.y, min.z);
@@ -68,7 +68,7 @@ namespace softcube {
             corners[7] = Vector3(min.x, max.y, max.z);
         }
 
-        void expand(const Vector3 &point) {
+        constexpr void expand(const Vector3 &point) {
             min.x = std::min(min.x, point.x);
             min.y = std::min(min.y, point.y);
             min.z = std::min(min.z, point.z);
@@ -77,7 +77,7 @@ namespace softcube {
             max.z = std::max(max.z, point.z);
         }
 
-        void expand(const AABB &other) {
+        constexpr void expand(const AABB &other) {
             min.x = std::min(min.x, other.min.x);
             min.y = std::min(min.y, other.min.y);
             min.z = std::min(min.z, other.min.z);
@@ -86,24 +86,24 @@ namespace softcube {
             max.z = std::max(max.z, other.max.z);
         }
 
-        void expand(float amount) {
+        constexpr void expand(float amount) {
             min -= Vector3(amount);
             max += Vector3(amount);
         }
 
-        [[nodiscard]] bool contains(const Vector3 &point) const {
+        [[nodiscard]] constexpr bool contains(const Vector3 &point) const {
             return point.x >= min.x && point.x <= max.x &&
                    point.y >= min.y && point.y <= max.y &&
                    point.z >= min.z && point.z <= max.z;
         }
 
-        [[nodiscard]] bool contains(const AABB &other) const {
+        [[nodiscard]] constexpr bool contains(const AABB &other) const {
             return min.x <= other.min.x && max.x >= other.max.x &&
                    min.y <= other.min.y && max.y >= other.max.y &&
                    min.z <= other.min.z && max.z >= other.max.z;
         }
 
-        [[nodiscard]] bool intersects(const AABB &other) const {
+        [[nodiscard]] constexpr bool intersects(const AABB &other) const {
             return max.x >= other.min.x && min.x <= other.max.x &&
                    max.y >= other.min.y && min.y <= other.max.y &&
                    max.z >= other.min.z && min.z <= other.max.z;
@@ -146,19 +146,31 @@ namespace softcube {
             return true;
         }
 
+        /**
+         * @brief Bounds of this box under an affine transform (Arvo's method)
+         *
+         * Adds the smaller and larger of each matrix element times the box's
+         * min and max to the translation, which bounds all eight corners
+         * without transforming them. See math::transform_aabbs for many boxes.
+         */
         [[nodiscard]] AABB transform(const Matrix4 &matrix) const {
-            Vector3 corners[8];
-            get_corners(corners);
-
             AABB result;
-            for (auto corner: corners) {
-                result.expand(matrix.transform_point(corner));
+            for (int row = 0; row < 3; ++row) {
+                float out_min = matrix.m[row][3];
+                float out_max = matrix.m[row][3];
+                for (int axis = 0; axis < 3; ++axis) {
+                    const float a = matrix.m[row][axis] * (&min.x)[axis];
+                    const float b = matrix.m[row][axis] * (&max.x)[axis];
+                    out_min += a < b ? a : b;
+                    out_max += a > b ? a : b;
+                }
+                (&result.min.x)[row] = out_min;
+                (&result.max.x)[row] = out_max;
             }
-
             return result;
         }
 
-        static AABB merge(const AABB &a, const AABB &b) {
+        static constexpr AABB merge(const AABB &a, const AABB &b) {
             return {
                 Vector3(std::min(a.min.x, b.min.x),
                         std::min(a.min.y, b.min.y),
@@ -169,7 +181,7 @@ namespace softcube {
             };
         }
 
-        static AABB intersection(const AABB &a, const AABB &b) {
+        static constexpr AABB intersection(const AABB &a, const AABB &b) {
             const AABB result(
                 Vector3(std::max(a.min.x, b.min.x),
                         std::max(a.min.y, b.min.y),
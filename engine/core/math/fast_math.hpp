@@ -0,0 +1,325 @@
+#pragma once
+#include "core/common.hpp"
+#include "math_utils.hpp"
+#include "quaternion.hpp"
+#include "simd.hpp"
+
+/**
+ * @brief Polynomial approximations of the standard math functions for hot loops
+ *
+ * Each function documents its largest error measured against double
+ * precision over its stated domain. Apart from rsqrt, they only use
+ * operations that round the same way everywhere, so scalar and SIMD
+ * versions of a function agree with each other and across platforms. That
+ * relies on the compiler not fusing multiply-adds; the build passes
+ * -ffp-contract=off, and code built without it may differ by an ulp.
+ * Inputs outside the stated domains give unspecified results rather than
+ * NaN or infinity. The speedup comes from the float4 versions; the scalar
+ * sin and exp are there to match them bit for bit and are no faster than
+ * the standard library.
+ */
+namespace softcube::math::fast {
+    namespace detail {
+        // Two-part 2 pi for reduction: the high part has few enough bits that
+        // quotient * high is exact for quotients below 2^16.
+        constexpr float two_pi_high = 6.28125f;
+        constexpr float two_pi_low = 1.9353071795864769e-3f;
+        constexpr float inverse_two_pi = 0.15915494309189535f;
+
+        constexpr float ln2_high = 0.693359375f;
+        constexpr float ln2_low = -2.12194440e-4f;
+        constexpr float log2_e = 1.44269504088896341f;
+        constexpr float sqrt_half = 0.70710678118654752f;
+
+        // Minimax polynomials on [-pi/2, pi/2]; odd for sine, even for cosine.
+        constexpr float sin_coefficients[] = {
+            -0.16666667f, 0.0083333310f, -0.00019840874f, 2.7525562e-06f, -2.3889859e-08f
+        };
+        constexpr float cos_coefficients[] = {
+            -0.5f, 0.041666638f, -0.0013888378f, 2.4760495e-05f, -2.6051615e-07f
+        };
+
+        // Minimax polynomial for atan on [0, 1], odd powers.
+        constexpr float atan_coefficients[] = {
+            0.99997726f, -0.33262347f, 0.19354346f, -0.11643287f, 0.05265332f, -0.01172120f
+        };
+
+        inline float sin_polynomial(const float y) {
+            const float y2 = y * y;
+            const auto &c = sin_coefficients;
+            return y + y * y2 * (c[0] + y2 * (c[1] + y2 * (c[2] + y2 * (c[3] + y2 * c[4]))));
+        }
+
+        inline float cos_polynomial(const float y) {
+            const float y2 = y * y;
+            const auto &c = cos_coefficients;
+            return 1.0f + y2 * (c[0] + y2 * (c[1] + y2 * (c[2] + y2 * (c[3] + y2 * c[4]))));
+        }
+
+        inline float atan_polynomial(const float a) {
+            const float a2 = a * a;
+            const auto &c = atan_coefficients;
+            return a * (c[0] + a2 * (c[1] + a2 * (c[2] + a2 * (c[3] + a2 * (c[4] + a2 * c[5])))));
+        }
+
+        inline simd::float4 polynomial(const simd::float4 x, const float *coefficients, const int count) {
+            simd::float4 result = simd::splat(coefficients[count - 1]);
+            for (int i = count - 2; i >= 0; --i) {
+                result = simd::add(simd::splat(coefficients[i]), simd::mul(x, result));
+            }
+            return result;
+        }
+
+        /**
+         * @brief Reduce an angle to [-pi/2, pi/2]; cos_sign is -1 where the cosine changes sign
+         */
+        inline float reduce_angle(const float angle, float &cos_sign) {
+            const float quotient = std::floor(angle * inverse_two_pi + 0.5f);
+            float y = angle - quotient * two_pi_high - quotient * two_pi_low;
+            cos_sign = 1.0f;
+            if (y > HALF_PI) {
+                y = PI - y;
+                cos_sign = -1.0f;
+            } else if (y < -HALF_PI) {
+                y = -PI - y;
+                cos_sign = -1.0f;
+            }
+            return y;
+        }
+
+        inline simd::float4 reduce_angle(const simd::float4 angle, simd::float4 &cos_sign) {
+            const simd::float4 quotient = simd::floor(simd::add(simd::mul(angle, simd::splat(inverse_two_pi)),
+                                                                simd::splat(0.5f)));
+            simd::float4 y = simd::sub(simd::sub(angle, simd::mul(quotient, simd::splat(two_pi_high))),
+                                       simd::mul(quotient, simd::splat(two_pi_low)));
+
+            const simd::float4 above = simd::less(simd::splat(HALF_PI), y);
+            const simd::float4 below = simd::less(y, simd::splat(-HALF_PI));
+            y = simd::select(above, simd::sub(simd::splat(PI), y), y);
+            y = simd::select(below, simd::sub(simd::splat(-PI), y), y);
+            cos_sign = simd::select(simd::as_float4(simd::bit_or(simd::as_int4(above), simd::as_int4(below))),
+                                    simd::splat(-1.0f), simd::splat(1.0f));
+            return y;
+        }
+    }
+
+    /**
+     * @brief Sine and cosine of one angle; max error 3e-7 for |angle| < 1000
+     *
+     * Valid for |angle| < 2^16 radians.
+     */
+    inline void sincos(const float angle, float &sine, float &cosine) {
+        float cos_sign;
+        const float y = detail::reduce_angle(angle, cos_sign);
+        sine = detail::sin_polynomial(y);
+        cosine = detail::cos_polynomial(y) * cos_sign;
+    }
+
+    inline float sin(const float angle) {
+        float cos_sign;
+        return detail::sin_polynomial(detail::reduce_angle(angle, cos_sign));
+    }
+
+    inline float cos(const float angle) {
+        float cos_sign;
+        const float y = detail::reduce_angle(angle, cos_sign);
+        return detail::cos_polynomial(y) * cos_sign;
+    }
+
+    inline void sincos(const simd::float4 angle, simd::float4 &sine, simd::float4 &cosine) {
+        simd::float4 cos_sign;
+        const simd::float4 y = detail::reduce_angle(angle, cos_sign);
+        const simd::float4 y2 = simd::mul(y, y);
+        sine = simd::add(y, simd::mul(simd::mul(y, y2), detail::polynomial(y2, detail::sin_coefficients, 5)));
+        cosine = simd::mul(simd::add(simd::splat(1.0f), simd::mul(y2, detail::polynomial(
+                                         y2, detail::cos_coefficients, 5))), cos_sign);
+    }
+
+    inline simd::float4 sin(const simd::float4 angle) {
+        simd::float4 sine, cosine;
+        sincos(angle, sine, cosine);
+        return sine;
+    }
+
+    inline simd::float4 cos(const simd::float4 angle) {
+        simd::float4 sine, cosine;
+        sincos(angle, sine, cosine);
+        return cosine;
+    }
+
+    /**
+     * @brief Angle of (x, y) from the positive x axis in [-pi, pi]; max error 2e-6 radians
+     *
+     * atan2(0, 0) is 0, and the sign of a zero y is ignored, so atan2(-0, -1) is pi.
+     */
+    inline float atan2(const float y, const float x) {
+        const float ax = std::abs(x);
+        const float ay = std::abs(y);
+        const float largest = std::max(ax, ay);
+        const float ratio = largest > 0.0f ? std::min(ax, ay) / largest : 0.0f;
+
+        float angle = detail::atan_polynomial(ratio);
+        if (ay > ax) {
+            angle = HALF_PI - angle;
+        }
+        if (x < 0.0f) {
+            angle = PI - angle;
+        }
+        return y < 0.0f ? -angle : angle;
+    }
+
+    inline simd::float4 atan2(const simd::float4 y, const simd::float4 x) {
+        const simd::float4 zero = simd::splat(0.0f);
+        const simd::float4 ax = simd::abs(x);
+        const simd::float4 ay = simd::abs(y);
+        const simd::float4 largest = simd::max(ax, ay);
+        const simd::float4 nonzero = simd::less(zero, largest);
+        const simd::float4 ratio = simd::bit_and(
+            nonzero, simd::div(simd::min(ax, ay), simd::select(nonzero, largest, simd::splat(1.0f))));
+
+        const simd::float4 ratio2 = simd::mul(ratio, ratio);
+        simd::float4 angle = simd::mul(ratio, detail::polynomial(ratio2, detail::atan_coefficients, 6));
+        angle = simd::select(simd::less(ax, ay), simd::sub(simd::splat(HALF_PI), angle), angle);
+        angle = simd::select(simd::less(x, zero), simd::sub(simd::splat(PI), angle), angle);
+        return simd::select(simd::less(y, zero), simd::sub(zero, angle), angle);
+    }
+
+    /**
+     * @brief Arctangent in [-pi/2, pi/2]; max error 2e-6 radians
+     */
+    inline float atan(const float x) {
+        return atan2(x, 1.0f);
+    }
+
+    /**
+     * @brief Arccosine of a value in [-1, 1]; max error 2e-6 radians
+     */
+    inline float acos(const float x) {
+        return atan2(std::sqrt((1.0f - x) * (1.0f + x)), x);
+    }
+
+    /**
+     * @brief Arcsine of a value in [-1, 1]; max error 2e-6 radians
+     */
+    inline float asin(const float x) {
+        return atan2(x, std::sqrt((1.0f - x) * (1.0f + x)));
+    }
+
+    /**
+     * @brief e^x for x in [-87, 88]; max relative error 3e-7
+     *
+     * Inputs outside the range are clamped to it, so the result stays a
+     * normal, finite float.
+     */
+    inline float exp(float x) {
+        x = std::clamp(x, -87.0f, 88.0f);
+        const float n = std::floor(x * detail::log2_e + 0.5f);
+        const float r = x - n * detail::ln2_high - n * detail::ln2_low;
+
+        // Taylor series of e^r; |r| <= ln(2) / 2 keeps the truncation below float precision.
+        const float p = 1.0f + r * (1.0f + r * (0.5f + r * (1.0f / 6.0f + r * (1.0f / 24.0f + r * (
+                                                                          1.0f / 120.0f + r * (1.0f / 720.0f))))));
+        return p * std::bit_cast<float>(static_cast<u32>(static_cast<i32>(n) + 127) << 23);
+    }
+
+    inline simd::float4 exp(simd::float4 x) {
+        x = simd::min(simd::max(x, simd::splat(-87.0f)), simd::splat(88.0f));
+        const simd::float4 n = simd::floor(simd::add(simd::mul(x, simd::splat(detail::log2_e)), simd::splat(0.5f)));
+        const simd::float4 r = simd::sub(simd::sub(x, simd::mul(n, simd::splat(detail::ln2_high))),
+                                         simd::mul(n, simd::splat(detail::ln2_low)));
+
+        constexpr float taylor[] = {
+            1.0f, 1.0f, 0.5f, 1.0f / 6.0f, 1.0f / 24.0f, 1.0f / 120.0f, 1.0f / 720.0f
+        };
+        const simd::float4 p = detail::polynomial(r, taylor, 7);
+        const simd::int4 scale = simd::shift_left<23>(simd::add(simd::to_int4(n), simd::splat(127)));
+        return simd::mul(p, simd::as_float4(scale));
+    }
+
+    /**
+     * @brief Natural logarithm of a positive, normal x; max absolute error 4e-7 near 1, relative 3e-8 elsewhere
+     */
+    inline float log(const float x) {
+        const u32 bits = std::bit_cast<u32>(x);
+        float exponent = static_cast<float>(static_cast<i32>(bits >> 23) - 127);
+        float mantissa = std::bit_cast<float>((bits & 0x007FFFFFu) | 0x3F800000u);
+        if (mantissa > 2.0f * detail::sqrt_half) {
+            mantissa *= 0.5f;
+            exponent += 1.0f;
+        }
+
+        // log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172.
+        const float s = (mantissa - 1.0f) / (mantissa + 1.0f);
+        const float s2 = s * s;
+        const float series = 2.0f * s + 2.0f * s * s2 * (1.0f / 3.0f + s2 * (1.0f / 5.0f + s2 * (
+                                                              1.0f / 7.0f + s2 * (1.0f / 9.0f))));
+        return exponent * detail::ln2_high + (series + exponent * detail::ln2_low);
+    }
+
+    inline simd::float4 log(const simd::float4 x) {
+        const simd::int4 bits = simd::as_int4(x);
+        simd::float4 exponent = simd::to_float4(simd::sub(simd::shift_right<23>(bits), simd::splat(127)));
+        simd::float4 mantissa = simd::as_float4(simd::bit_or(simd::bit_and(bits, simd::splat(0x007FFFFF)),
+                                                             simd::splat(0x3F800000)));
+        const simd::float4 high = simd::less(simd::splat(2.0f * detail::sqrt_half), mantissa);
+        mantissa = simd::select(high, simd::mul(mantissa, simd::splat(0.5f)), mantissa);
+        exponent = simd::add(exponent, simd::bit_and(high, simd::splat(1.0f)));
+
+        const simd::float4 one = simd::splat(1.0f);
+        const simd::float4 s = simd::div(simd::sub(mantissa, one), simd::add(mantissa, one));
+        const simd::float4 s2 = simd::mul(s, s);
+        constexpr float series_coefficients[] = {1.0f / 3.0f, 1.0f / 5.0f, 1.0f / 7.0f, 1.0f / 9.0f};
+        const simd::float4 two_s = simd::mul(simd::splat(2.0f), s);
+        const simd::float4 series = simd::add(two_s, simd::mul(simd::mul(two_s, s2),
+                                                               detail::polynomial(s2, series_coefficients, 4)));
+        return simd::add(simd::mul(exponent, simd::splat(detail::ln2_high)),
+                         simd::add(series, simd::mul(exponent, simd::splat(detail::ln2_low))));
+    }
+
+    /**
+     * @brief 1 / sqrt(x) for positive x; max relative error 3e-7 with SSE, 5e-6 elsewhere
+     *
+     * The hardware estimate refined by one Newton step. Results depend on the
+     * CPU, so keep it out of anything that must replay identically.
+     */
+    inline simd::float4 rsqrt(const simd::float4 x) {
+        const simd::float4 estimate = simd::rsqrt_estimate(x);
+        const simd::float4 half_x = simd::mul(x, simd::splat(0.5f));
+        return simd::mul(estimate, simd::sub(simd::splat(1.5f), simd::mul(half_x, simd::mul(estimate, estimate))));
+    }
+
+    inline float rsqrt(const float x) {
+        return simd::get_x(rsqrt(simd::splat(x)));
+    }
+
+    /**
+     * @brief Normalized linear interpolation along the shorter arc
+     *
+     * Constant-speed only for small angles; fine for blending poses a frame apart.
+     */
+    inline Quaternion nlerp(const Quaternion &a, const Quaternion &b, const float t) {
+        const float sign = a.dot(b) < 0.0f ? -1.0f : 1.0f;
+        const float s0 = 1.0f - t;
+        const float s1 = t * sign;
+        const Quaternion blended(s0 * a.x + s1 * b.x, s0 * a.y + s1 * b.y, s0 * a.z + s1 * b.z, s0 * a.w + s1 * b.w);
+        const float inv_length = 1.0f / std::sqrt(blended.dot(blended));
+        return Quaternion(blended.x * inv_length, blended.y * inv_length, blended.z * inv_length,
+                          blended.w * inv_length);
+    }
+
+    /**
+     * @brief slerp replacement: nlerp with t corrected for the speed change along the arc
+     *
+     * The correction is a polynomial in t and |dot(a, b)| fitted to slerp
+     * (Kapoulkine's onlerp), so no trigonometry is needed. Max angular error
+     * against slerp 2e-3 radians, over every pair of unit quaternions.
+     */
+    inline Quaternion slerp(const Quaternion &a, const Quaternion &b, const float t) {
+        const float d = std::abs(a.dot(b));
+        const float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+        const float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+        const float k = A * (t - 0.5f) * (t - 0.5f) + B;
+        const float corrected = t + t * (t - 0.5f) * (t - 1.0f) * k;
+        return nlerp(a, b, corrected);
+    }
+}
@@ -0,0 +1,4 @@
+#include "frustum.hpp"
+
+namespace softcube {
+}
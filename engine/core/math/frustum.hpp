@@ -0,0 +1,96 @@
+#pragma once
+#include "core/common.hpp"
+#include "vector3.hpp"
+#include "vector4.hpp"
+#include "matrix.hpp"
+#include "aabb.hpp"
+
+namespace softcube {
+    /**
+     * @struct Frustum
+     * @brief View frustum described by six inward-facing planes
+     *
+     * Each plane is stored as (normal.x, normal.y, normal.z, distance) so that a
+     * point p is inside the plane when dot(normal, p) + distance >= 0.
+     */
+    struct Frustum {
+        enum Plane {
+            PLANE_LEFT = 0,
+            PLANE_RIGHT,
+            PLANE_BOTTOM,
+            PLANE_TOP,
+            PLANE_NEAR,
+            PLANE_FAR,
+            PLANE_COUNT
+        };
+
+        std::array<Vector4, PLANE_COUNT> planes{};
+
+        Frustum() = default;
+
+        /**
+         * @brief Extract the frustum planes from a combined view-projection matrix
+         * @param view_projection Projection * view, using the engine's column-vector convention
+         * @return The normalized frustum
+         */
+        static Frustum from_matrix(const Matrix4 &view_projection) {
+            const auto &m = view_projection;
+            const Vector4 row0(m.m00, m.m01, m.m02, m.m03);
+            const Vector4 row1(m.m10, m.m11, m.m12, m.m13);
+            const Vector4 row2(m.m20, m.m21, m.m22, m.m23);
+            const Vector4 row3(m.m30, m.m31, m.m32, m.m33);
+
+            Frustum result;
+            result.planes[PLANE_LEFT] = row3 + row0;
+            result.planes[PLANE_RIGHT] = row3 - row0;
+            result.planes[PLANE_BOTTOM] = row3 + row1;
+            result.planes[PLANE_TOP] = row3 - row1;
+            result.planes[PLANE_NEAR] = row3 + row2;
+            result.planes[PLANE_FAR] = row3 - row2;
+
+            for (auto &plane: result.planes) {
+                if (const float length = plane.xyz().length(); length > 0.0f) {
+                    plane /= length;
+                }
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] bool contains(const Vector3 &point) const {
+            for (const auto &plane: planes) {
+                if (plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool intersects_sphere(const Vector3 &center, const float radius) const {
+            for (const auto &plane: planes) {
+                if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Conservative box test using the corner furthest along each plane normal
+         * @param box Box to test
+         * @return False only if the box is fully outside one of the planes
+         */
+        [[nodiscard]] bool intersects(const AABB &box) const {
+            for (const auto &plane: planes) {
+                const float x = plane.x >= 0.0f ? box.max.x : box.min.x;
+                const float y = plane.y >= 0.0f ? box.max.y : box.min.y;
+                const float z = plane.z >= 0.0f ? box.max.z : box.min.z;
+
+                if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "core/common.hpp"
+
+namespace softcube::math {
+    /**
+     * @brief Scramble a 64-bit value so every input bit affects every output bit
+     *
+     * The splitmix64 finalizer. It is a bijection, so distinct keys never
+     * collide, and the low bits are as well mixed as the high ones, which is
+     * what open-addressing tables indexing with a power-of-two mask need.
+     * std::hash of integers is the identity on common standard libraries and
+     * clusters badly for grid coordinates.
+     */
+    constexpr u64 mix64(u64 value) {
+        value ^= value >> 30;
+        value *= 0xBF58476D1CE4E5B9ull;
+        value ^= value >> 27;
+        value *= 0x94D049BB133111EBull;
+        value ^= value >> 31;
+        return value;
+    }
+
+    /**
+     * @brief Fold another value into a running hash
+     */
+    constexpr u64 hash_combine(const u64 seed, const u64 value) {
+        return mix64(seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2)));
+    }
+
+    /**
+     * @brief Hash two 32-bit coordinates; the packing is lossless, so only the mixing step can collide
+     */
+    constexpr u64 hash_coordinates(const i32 x, const i32 y) {
+        return mix64(static_cast<u64>(static_cast<u32>(x)) | static_cast<u64>(static_cast<u32>(y)) << 32);
+    }
+
+    /**
+     * @brief Hash three 32-bit coordinates with a single mixing step
+     *
+     * x and y are packed into one word and z is spread over all 64 bits by an
+     * odd multiplier before the two are combined.
+     */
+    constexpr u64 hash_coordinates(const i32 x, const i32 y, const i32 z) {
+        const u64 xy = static_cast<u64>(static_cast<u32>(x)) | static_cast<u64>(static_cast<u32>(y)) << 32;
+        return mix64(xy ^ static_cast<u64>(static_cast<u32>(z)) * 0x9E3779B97F4A7C15ull);
+    }
+}
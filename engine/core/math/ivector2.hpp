@@ -0,0 +1,144 @@
+#pragma once
+#include "core/common.hpp"
+#include "vector2.hpp"
+#include "math_utils.hpp"
+#include "morton.hpp"
+#include "hash.hpp"
+
+namespace softcube {
+    /**
+     * @struct IVector2
+     * @brief 2D integer vector, for chunk columns and other grid coordinates
+     */
+    struct IVector2 {
+        i32 x{0};
+        i32 y{0};
+
+        IVector2() = default;
+
+        constexpr IVector2(i32 x, i32 y) : x(x), y(y) {
+        }
+
+        explicit constexpr IVector2(i32 value) : x(value), y(value) {
+        }
+
+        /**
+         * @brief Grid cell containing a point: each component rounded toward negative infinity
+         */
+        static constexpr IVector2 floor(const Vector2 &v) {
+            return IVector2(math::floor_to_int(v.x), math::floor_to_int(v.y));
+        }
+
+        /**
+         * @brief Inverse of to_morton
+         */
+        static constexpr IVector2 from_morton(const u64 code) {
+            const auto [x, y] = math::morton_decode_2d(code);
+            return IVector2(static_cast<i32>(x ^ 0x80000000u), static_cast<i32>(y ^ 0x80000000u));
+        }
+
+        static constexpr IVector2 zero() { return IVector2(0, 0); }
+        static constexpr IVector2 one() { return IVector2(1, 1); }
+        static constexpr IVector2 unit_x() { return IVector2(1, 0); }
+        static constexpr IVector2 unit_y() { return IVector2(0, 1); }
+
+        constexpr Vector2 to_vector2() const {
+            return Vector2(static_cast<float>(x), static_cast<float>(y));
+        }
+
+        /**
+         * @brief Z-order code of the coordinates
+         *
+         * Flipping the sign bit maps the signed range onto unsigned in order,
+         * so cells that are close in space stay close in the code across zero.
+         */
+        constexpr u64 to_morton() const {
+            return math::morton_encode_2d(static_cast<u32>(x) ^ 0x80000000u, static_cast<u32>(y) ^ 0x80000000u);
+        }
+
+        constexpr u64 hash() const {
+            return math::hash_coordinates(x, y);
+        }
+
+        constexpr IVector2 operator+(const IVector2 &other) const {
+            return IVector2(x + other.x, y + other.y);
+        }
+
+        constexpr IVector2 operator-(const IVector2 &other) const {
+            return IVector2(x - other.x, y - other.y);
+        }
+
+        constexpr IVector2 operator*(i32 scalar) const {
+            return IVector2(x * scalar, y * scalar);
+        }
+
+        constexpr IVector2 operator*(const IVector2 &other) const {
+            return IVector2(x * other.x, y * other.y);
+        }
+
+        constexpr IVector2 operator-() const {
+            return IVector2(-x, -y);
+        }
+
+        constexpr IVector2 &operator+=(const IVector2 &other) {
+            x += other.x;
+            y += other.y;
+            return *this;
+        }
+
+        constexpr IVector2 &operator-=(const IVector2 &other) {
+            x -= other.x;
+            y -= other.y;
+            return *this;
+        }
+
+        constexpr IVector2 &operator*=(i32 scalar) {
+            x *= scalar;
+            y *= scalar;
+            return *this;
+        }
+
+        constexpr bool operator==(const IVector2 &other) const {
+            return x == other.x && y == other.y;
+        }
+
+        constexpr bool operator!=(const IVector2 &other) const {
+            return !(*this == other);
+        }
+
+        constexpr i32 dot(const IVector2 &other) const {
+            return x * other.x + y * other.y;
+        }
+
+        constexpr i32 length_squared() const {
+            return x * x + y * y;
+        }
+    };
+
+    constexpr IVector2 operator*(i32 scalar, const IVector2 &vec) {
+        return vec * scalar;
+    }
+
+    constexpr IVector2 min(const IVector2 &a, const IVector2 &b) {
+        return IVector2(std::min(a.x, b.x), std::min(a.y, b.y));
+    }
+
+    constexpr IVector2 max(const IVector2 &a, const IVector2 &b) {
+        return IVector2(std::max(a.x, b.x), std::max(a.y, b.y));
+    }
+
+    constexpr IVector2 floor_div(const IVector2 &value, i32 divisor) {
+        return IVector2(math::floor_div(value.x, divisor), math::floor_div(value.y, divisor));
+    }
+
+    constexpr IVector2 floor_mod(const IVector2 &value, i32 divisor) {
+        return IVector2(math::floor_mod(value.x, divisor), math::floor_mod(value.y, divisor));
+    }
+}
+
+template<>
+struct std::hash<softcube::IVector2> {
+    size_t operator()(const softcube::IVector2 &value) const noexcept {
+        return static_cast<size_t>(value.hash());
+    }
+};
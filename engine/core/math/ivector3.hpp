@@ -0,0 +1,192 @@
+#pragma once
+#include "core/common.hpp"
+#include "vector3.hpp"
+#include "ivector2.hpp"
+
+namespace softcube {
+    /**
+     * @struct IVector3
+     * @brief 3D integer vector, for block, chunk and other grid coordinates
+     */
+    struct IVector3 {
+        i32 x{0};
+        i32 y{0};
+        i32 z{0};
+
+        /**
+         * @brief Each component of a 3D Z-order code holds 21 bits, so to_morton covers [-morton_range, morton_range)
+         */
+        static constexpr i32 morton_range = 1 << 20;
+
+        IVector3() = default;
+
+        constexpr IVector3(i32 x, i32 y, i32 z) : x(x), y(y), z(z) {
+        }
+
+        explicit constexpr IVector3(i32 value) : x(value), y(value), z(value) {
+        }
+
+        constexpr IVector3(const IVector2 &v, i32 z) : x(v.x), y(v.y), z(z) {
+        }
+
+        /**
+         * @brief Grid cell containing a point: each component rounded toward negative infinity
+         */
+        static constexpr IVector3 floor(const Vector3 &v) {
+            return IVector3(math::floor_to_int(v.x), math::floor_to_int(v.y), math::floor_to_int(v.z));
+        }
+
+        /**
+         * @brief Inverse of to_morton
+         */
+        static constexpr IVector3 from_morton(const u64 code) {
+            const auto [x, y, z] = math::morton_decode_3d(code);
+            return IVector3(
+                static_cast<i32>(x) - morton_range,
+                static_cast<i32>(y) - morton_range,
+                static_cast<i32>(z) - morton_range
+            );
+        }
+
+        static constexpr IVector3 zero() { return IVector3(0, 0, 0); }
+        static constexpr IVector3 one() { return IVector3(1, 1, 1); }
+        static constexpr IVector3 unit_x() { return IVector3(1, 0, 0); }
+        static constexpr IVector3 unit_y() { return IVector3(0, 1, 0); }
+        static constexpr IVector3 unit_z() { return IVector3(0, 0, 1); }
+
+        constexpr IVector2 xy() const { return IVector2(x, y); }
+        constexpr IVector2 xz() const { return IVector2(x, z); }
+        constexpr IVector2 yz() const { return IVector2(y, z); }
+
+        constexpr Vector3 to_vector3() const {
+            return Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+        }
+
+        /**
+         * @brief Z-order code of the coordinates
+         *
+         * Components are offset by morton_range so the signed range maps onto
+         * the 21 unsigned bits in order; values outside it wrap.
+         */
+        constexpr u64 to_morton() const {
+            constexpr u32 mask = 2 * morton_range - 1;
+            return math::morton_encode_3d(
+                static_cast<u32>(x + morton_range) & mask,
+                static_cast<u32>(y + morton_range) & mask,
+                static_cast<u32>(z + morton_range) & mask
+            );
+        }
+
+        constexpr u64 hash() const {
+            return math::hash_coordinates(x, y, z);
+        }
+
+        constexpr IVector3 operator+(const IVector3 &other) const {
+            return IVector3(x + other.x, y + other.y, z + other.z);
+        }
+
+        constexpr IVector3 operator-(const IVector3 &other) const {
+            return IVector3(x - other.x, y - other.y, z - other.z);
+        }
+
+        constexpr IVector3 operator*(i32 scalar) const {
+            return IVector3(x * scalar, y * scalar, z * scalar);
+        }
+
+        constexpr IVector3 operator*(const IVector3 &other) const {
+            return IVector3(x * other.x, y * other.y, z * other.z);
+        }
+
+        constexpr IVector3 operator-() const {
+            return IVector3(-x, -y, -z);
+        }
+
+        constexpr IVector3 &operator+=(const IVector3 &other) {
+            x += other.x;
+            y += other.y;
+            z += other.z;
+            return *this;
+        }
+
+        constexpr IVector3 &operator-=(const IVector3 &other) {
+            x -= other.x;
+            y -= other.y;
+            z -= other.z;
+            return *this;
+        }
+
+        constexpr IVector3 &operator*=(i32 scalar) {
+            x *= scalar;
+            y *= scalar;
+            z *= scalar;
+            return *this;
+        }
+
+        constexpr bool operator==(const IVector3 &other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+
+        constexpr bool operator!=(const IVector3 &other) const {
+            return !(*this == other);
+        }
+
+        constexpr i32 dot(const IVector3 &other) const {
+            return x * other.x + y * other.y + z * other.z;
+        }
+
+        constexpr IVector3 cross(const IVector3 &other) const {
+            return IVector3(
+                y * other.z - z * other.y,
+                z * other.x - x * other.z,
+                x * other.y - y * other.x
+            );
+        }
+
+        constexpr i32 length_squared() const {
+            return x * x + y * y + z * z;
+        }
+    };
+
+    constexpr IVector3 operator*(i32 scalar, const IVector3 &vec) {
+        return vec * scalar;
+    }
+
+    constexpr i32 dot(const IVector3 &a, const IVector3 &b) {
+        return a.dot(b);
+    }
+
+    constexpr IVector3 cross(const IVector3 &a, const IVector3 &b) {
+        return a.cross(b);
+    }
+
+    constexpr IVector3 min(const IVector3 &a, const IVector3 &b) {
+        return IVector3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+    }
+
+    constexpr IVector3 max(const IVector3 &a, const IVector3 &b) {
+        return IVector3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+    }
+
+    constexpr IVector3 floor_div(const IVector3 &value, i32 divisor) {
+        return IVector3(
+            math::floor_div(value.x, divisor),
+            math::floor_div(value.y, divisor),
+            math::floor_div(value.z, divisor)
+        );
+    }
+
+    constexpr IVector3 floor_mod(const IVector3 &value, i32 divisor) {
+        return IVector3(
+            math::floor_mod(value.x, divisor),
+            math::floor_mod(value.y, divisor),
+            math::floor_mod(value.z, divisor)
+        );
+    }
+}
+
+template<>
+struct std::hash<softcube::IVector3> {
+    size_t operator()(const softcube::IVector3 &value) const noexcept {
+        return static_cast<size_t>(value.hash());
+    }
+};
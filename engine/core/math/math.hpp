@@ -3,17 +3,27 @@
 #include "vector2.hpp"
 #include "vector3.hpp"
 #include "vector4.hpp"
+#include "ivector2.hpp"
+#include "ivector3.hpp"
 #include "matrix.hpp"
 #include "quaternion.hpp"
 #include "transform.hpp"
 #include "math_utils.hpp"
 #include "aabb.hpp"
+#include "frustum.hpp"
+#include "stream.hpp"
+#include "morton.hpp"
+#include "hash.hpp"
+#include "random.hpp"
+#include "fast_math.hpp"
 
 namespace softcube {
     namespace math {
         using Vec2 = Vector2;
         using Vec3 = Vector3;
         using Vec4 = Vector4;
+        using IVec2 = IVector2;
+        using IVec3 = IVector3;
         using Mat3 = Matrix3;
         using Mat4 = Matrix4;
         using Quat = Quaternion;
@@ -1,6 +1,28 @@
 #include "math_utils.hpp"
+#include "random.hpp"
 
 namespace softcube {
     namespace math {
+        namespace {
+            Xoshiro256 &thread_generator() {
+                thread_local Xoshiro256 generator([] {
+                    std::random_device device;
+                    return static_cast<u64>(device()) << 32 | device();
+                }());
+                return generator;
+            }
+        }
+
+        float random_float(const float min, const float max) {
+            return thread_generator().next_float(min, max);
+        }
+
+        int random_int(const int min, const int max) {
+            return thread_generator().next_int(min, max);
+        }
+
+        void seed_random(const u64 seed) {
+            thread_generator() = Xoshiro256(seed);
+        }
     }
 }
@@ -1,7 +1,6 @@
 #pragma once
 #include "core/common.hpp"
 #include <cmath>
-#include <random>
 
 namespace softcube {
     namespace math {
@@ -64,19 +63,24 @@ namespace softcube {
             return x + 1;
         }
 
-        inline float random_float(const float min = 0.0f, const float max = 1.0f) {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            std::uniform_real_distribution dis(min, max);
-            return dis(gen);
-        }
+        /**
+         * @brief Uniform float between min and max from the calling thread's generator
+         *
+         * Each thread has its own Xoshiro256 seeded from std::random_device, so
+         * calls are lock-free but not reproducible; call seed_random() first, or
+         * use a seeded Xoshiro256, Pcg32 or rng() where results must repeat.
+         */
+        float random_float(float min = 0.0f, float max = 1.0f);
 
-        inline int random_int(const int min, const int max) {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            std::uniform_int_distribution dis(min, max);
-            return dis(gen);
-        }
+        /**
+         * @brief Uniform integer in [min, max] from the calling thread's generator
+         */
+        int random_int(int min, int max);
+
+        /**
+         * @brief Reseed the calling thread's generator used by random_float and random_int
+         */
+        void seed_random(u64 seed);
 
         inline float hermite(const float y0, const float y1, const float y2, const float y3, const float mu) {
             float m0, m1, mu2, mu3;
@@ -125,5 +129,29 @@ namespace softcube {
         int sign(T value) {
             return (T(0) < value) - (value < T(0));
         }
+
+        /**
+         * @brief Integer division rounding toward negative infinity, so -1 / 16 is -1 rather than 0
+         */
+        constexpr i32 floor_div(const i32 a, const i32 b) {
+            const i32 quotient = a / b;
+            return quotient - (a % b != 0 && (a < 0) != (b < 0));
+        }
+
+        /**
+         * @brief Remainder of floor_div; takes the sign of the divisor, so -1 mod 16 is 15
+         */
+        constexpr i32 floor_mod(const i32 a, const i32 b) {
+            const i32 remainder = a % b;
+            return remainder != 0 && (remainder < 0) != (b < 0) ? remainder + b : remainder;
+        }
+
+        /**
+         * @brief Largest integer not greater than value; value must fit in an i32
+         */
+        constexpr i32 floor_to_int(const float value) {
+            const i32 truncated = static_cast<i32>(value);
+            return truncated - (value < static_cast<float>(truncated));
+        }
     }
 }
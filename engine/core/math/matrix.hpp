@@ -2,6 +2,7 @@
 #include "core/common.hpp"
 #include "vector3.hpp"
 #include "vector4.hpp"
+#include "simd.hpp"
 
 namespace softcube {
     /**
@@ -20,11 +21,14 @@ namespace softcube {
             float values[9];
         };
 
-        Matrix3() {
-            *this = identity();
+        constexpr Matrix3() : Matrix3(
+            1.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 1.0f
+        ) {
         }
 
-        Matrix3(
+        constexpr Matrix3(
             float m00, float m01, float m02,
             float m10, float m11, float m12,
             float m20, float m21, float m22
@@ -33,7 +37,7 @@ namespace softcube {
             m20(m20), m21(m21), m22(m22) {
         }
 
-        static Matrix3 identity() {
+        static constexpr Matrix3 identity() {
             return Matrix3(
                 1.0f, 0.0f, 0.0f,
                 0.0f, 1.0f, 0.0f,
@@ -41,7 +45,7 @@ namespace softcube {
             );
         }
 
-        static Matrix3 zero() {
+        static constexpr Matrix3 zero() {
             return Matrix3(
                 0.0f, 0.0f, 0.0f,
                 0.0f, 0.0f, 0.0f,
@@ -49,7 +53,7 @@ namespace softcube {
             );
         }
 
-        static Matrix3 scale(const float x, const float y, const float z) {
+        static constexpr Matrix3 scale(const float x, const float y, const float z) {
             return Matrix3(
                 x, 0.0f, 0.0f,
                 0.0f, y, 0.0f,
@@ -57,7 +61,7 @@ namespace softcube {
             );
         }
 
-        static Matrix3 scale(const Vector3 &s) {
+        static constexpr Matrix3 scale(const Vector3 &s) {
             return scale(s.x, s.y, s.z);
         }
 
@@ -108,21 +112,21 @@ namespace softcube {
             );
         }
 
-        Matrix3 transpose() const {
+        constexpr Matrix3 transpose() const {
             return {
-                m00, m01, m02,
-                m10, m11, m12,
-                m20, m21, m22
+                m00, m10, m20,
+                m01, m11, m21,
+                m02, m12, m22
             };
         }
 
-        float determinant() const {
+        constexpr float determinant() const {
             return m00 * (m11 * m22 - m12 * m21)
                    - m01 * (m10 * m22 - m12 * m20)
                    + m02 * (m10 * m21 - m11 * m20);
         }
 
-        Matrix3 inverse() const {
+        constexpr Matrix3 inverse() const {
             const float det = determinant();
             if (std::abs(det) < 1e-6f) {
                 return identity();
@@ -144,7 +148,7 @@ namespace softcube {
             return result;
         }
 
-        Vector3 transform_vector(const Vector3 &v) const {
+        constexpr Vector3 transform_vector(const Vector3 &v) const {
             return Vector3(
                 m00 * v.x + m01 * v.y + m02 * v.z,
                 m10 * v.x + m11 * v.y + m12 * v.z,
@@ -168,16 +172,18 @@ namespace softcube {
             return result;
         }
 
-        Matrix3 operator*(const Matrix3 &other) const {
-            Matrix3 result = zero();
-            for (int i = 0; i < 3; ++i) {
-                for (int j = 0; j < 3; ++j) {
-                    for (int k = 0; k < 3; ++k) {
-                        result.m[i][j] += m[i][k] * other.m[k][j];
-                    }
-                }
-            }
-            return result;
+        constexpr Matrix3 operator*(const Matrix3 &other) const {
+            return Matrix3(
+                m00 * other.m00 + m01 * other.m10 + m02 * other.m20,
+                m00 * other.m01 + m01 * other.m11 + m02 * other.m21,
+                m00 * other.m02 + m01 * other.m12 + m02 * other.m22,
+                m10 * other.m00 + m11 * other.m10 + m12 * other.m20,
+                m10 * other.m01 + m11 * other.m11 + m12 * other.m21,
+                m10 * other.m02 + m11 * other.m12 + m12 * other.m22,
+                m20 * other.m00 + m21 * other.m10 + m22 * other.m20,
+                m20 * other.m01 + m21 * other.m11 + m22 * other.m21,
+                m20 * other.m02 + m21 * other.m12 + m22 * other.m22
+            );
         }
 
         Matrix3 operator*(float scalar) const {
@@ -188,7 +194,7 @@ namespace softcube {
             return result;
         }
 
-        Vector3 operator*(const Vector3 &v) const {
+        constexpr Vector3 operator*(const Vector3 &v) const {
             return transform_vector(v);
         }
 
@@ -206,7 +212,7 @@ namespace softcube {
             return *this;
         }
 
-        Matrix3 &operator*=(const Matrix3 &other) {
+        constexpr Matrix3 &operator*=(const Matrix3 &other) {
             *this = *this * other;
             return *this;
         }
@@ -262,11 +268,15 @@ namespace softcube {
             float values[16];
         };
 
-        Matrix4() {
-            *this = identity();
+        constexpr Matrix4() : Matrix4(
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        ) {
         }
 
-        Matrix4(
+        constexpr Matrix4(
             float m00, float m01, float m02, float m03,
             float m10, float m11, float m12, float m13,
             float m20, float m21, float m22, float m23,
@@ -277,26 +287,15 @@ namespace softcube {
             m30(m30), m31(m31), m32(m32), m33(m33) {
         }
 
-        explicit Matrix4(const Matrix3 &m3) {
-            m00 = m3.m00;
-            m01 = m3.m01;
-            m02 = m3.m02;
-            m03 = 0.0f;
-            m10 = m3.m10;
-            m11 = m3.m11;
-            m12 = m3.m12;
-            m13 = 0.0f;
-            m20 = m3.m20;
-            m21 = m3.m21;
-            m22 = m3.m22;
-            m23 = 0.0f;
-            m30 = 0.0f;
-            m31 = 0.0f;
-            m32 = 0.0f;
-            m33 = 1.0f;
-        }
-
-        static Matrix4 identity() {
+        explicit constexpr Matrix4(const Matrix3 &m3) : Matrix4(
+            m3.m00, m3.m01, m3.m02, 0.0f,
+            m3.m10, m3.m11, m3.m12, 0.0f,
+            m3.m20, m3.m21, m3.m22, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        ) {
+        }
+
+        static constexpr Matrix4 identity() {
             return Matrix4(
                 1.0f, 0.0f, 0.0f, 0.0f,
                 0.0f, 1.0f, 0.0f, 0.0f,
@@ -305,7 +304,7 @@ namespace softcube {
             );
         }
 
-        static Matrix4 zero() {
+        static constexpr Matrix4 zero() {
             return Matrix4(
                 0.0f, 0.0f, 0.0f, 0.0f,
                 0.0f, 0.0f, 0.0f, 0.0f,
@@ -314,7 +313,7 @@ namespace softcube {
             );
         }
 
-        static Matrix4 translation(float x, float y, float z) {
+        static constexpr Matrix4 translation(float x, float y, float z) {
             return Matrix4(
                 1.0f, 0.0f, 0.0f, x,
                 0.0f, 1.0f, 0.0f, y,
@@ -323,11 +322,11 @@ namespace softcube {
             );
         }
 
-        static Matrix4 translation(const Vector3 &t) {
+        static constexpr Matrix4 translation(const Vector3 &t) {
             return translation(t.x, t.y, t.z);
         }
 
-        static Matrix4 scale(const float x, const float y, const float z) {
+        static constexpr Matrix4 scale(const float x, const float y, const float z) {
             return Matrix4(
                 x, 0.0f, 0.0f, 0.0f,
                 0.0f, y, 0.0f, 0.0f,
@@ -336,7 +335,7 @@ namespace softcube {
             );
         }
 
-        static Matrix4 scale(const Vector3 &s) {
+        static constexpr Matrix4 scale(const Vector3 &s) {
             return scale(s.x, s.y, s.z);
         }
 
@@ -430,16 +429,55 @@ namespace softcube {
             return result;
         }
 
-        Matrix4 transpose() const {
-            return {
-                m00, m01, m02, m03,
-                m10, m11, m12, m13,
-                m20, m21, m22, m23,
-                m30, m31, m32, m33
-            };
+        /**
+         * @brief Row as a vector; usable in constant expressions, unlike m
+         */
+        constexpr Vector4 get_row(const int index) const {
+            switch (index) {
+                case 0: return Vector4(m00, m01, m02, m03);
+                case 1: return Vector4(m10, m11, m12, m13);
+                case 2: return Vector4(m20, m21, m22, m23);
+                default: return Vector4(m30, m31, m32, m33);
+            }
+        }
+
+        /**
+         * @brief Column as a vector; usable in constant expressions, unlike m
+         */
+        constexpr Vector4 get_column(const int index) const {
+            switch (index) {
+                case 0: return Vector4(m00, m10, m20, m30);
+                case 1: return Vector4(m01, m11, m21, m31);
+                case 2: return Vector4(m02, m12, m22, m32);
+                default: return Vector4(m03, m13, m23, m33);
+            }
+        }
+
+        constexpr Matrix4 transpose() const {
+            if consteval {
+                return {
+                    m00, m10, m20, m30,
+                    m01, m11, m21, m31,
+                    m02, m12, m22, m32,
+                    m03, m13, m23, m33
+                };
+            }
+
+            simd::float4 row0 = simd::load(m[0]);
+            simd::float4 row1 = simd::load(m[1]);
+            simd::float4 row2 = simd::load(m[2]);
+            simd::float4 row3 = simd::load(m[3]);
+            simd::transpose(row0, row1, row2, row3);
+
+            Matrix4 result;
+            simd::store(result.m[0], row0);
+            simd::store(result.m[1], row1);
+            simd::store(result.m[2], row2);
+            simd::store(result.m[3], row3);
+            return result;
         }
 
-        Matrix3 to_matrix3() const {
+        constexpr Matrix3 to_matrix3() const {
             return Matrix3(
                 m00, m01, m02,
                 m10, m11, m12,
@@ -490,25 +528,71 @@ namespace softcube {
             return a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
         }
 
+        /**
+         * @brief Inverse from 2x2 block adjugates (Cramer's rule)
+         * @return Identity if the matrix is singular
+         */
         Matrix4 inverse() const {
-            float det = determinant();
-            if (std::abs(det) < 1e-6f) {
-                return identity();
-            }
+            using namespace simd;
 
-            float inv_det = 1.0f / det;
-            Matrix4 result;
+            // 2x2 helpers on blocks packed as (a00, a01, a10, a11).
+            constexpr auto multiply = [](const float4 a, const float4 b) {
+                return add(mul(a, swizzle<0, 3, 0, 3>(b)), mul(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+            };
+            constexpr auto adjugate_multiply = [](const float4 a, const float4 b) {
+                return sub(mul(swizzle<3, 3, 0, 0>(a), b), mul(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+            };
+            constexpr auto multiply_adjugate = [](const float4 a, const float4 b) {
+                return sub(mul(a, swizzle<3, 0, 3, 0>(b)), mul(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+            };
 
-            for (int i = 0; i < 4; ++i) {
-                for (int j = 0; j < 4; ++j) {
-                    result.m[j][i] = cofactor(i, j) * inv_det;
-                }
+            const float4 row0 = load(m[0]);
+            const float4 row1 = load(m[1]);
+            const float4 row2 = load(m[2]);
+            const float4 row3 = load(m[3]);
+
+            // | A B |
+            // | C D |
+            const float4 a = shuffle<0, 1, 0, 1>(row0, row1);
+            const float4 b = shuffle<2, 3, 2, 3>(row0, row1);
+            const float4 c = shuffle<0, 1, 0, 1>(row2, row3);
+            const float4 d = shuffle<2, 3, 2, 3>(row2, row3);
+
+            // (|A|, |B|, |C|, |D|)
+            const float4 block_determinants = sub(
+                mul(shuffle<0, 2, 0, 2>(row0, row2), shuffle<1, 3, 1, 3>(row1, row3)),
+                mul(shuffle<1, 3, 1, 3>(row0, row2), shuffle<0, 2, 0, 2>(row1, row3))
+            );
+            const float4 det_a = broadcast<0>(block_determinants);
+            const float4 det_b = broadcast<1>(block_determinants);
+            const float4 det_c = broadcast<2>(block_determinants);
+            const float4 det_d = broadcast<3>(block_determinants);
+
+            const float4 d_c = adjugate_multiply(d, c);
+            const float4 a_b = adjugate_multiply(a, b);
+
+            // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+            const float4 trace = horizontal_sum(mul(a_b, swizzle<0, 2, 1, 3>(d_c)));
+            const float4 det = sub(add(mul(det_a, det_d), mul(det_b, det_c)), trace);
+            if (std::abs(get_x(det)) < 1e-6f) {
+                return identity();
             }
 
+            const float4 inv_det = div(set(1.0f, -1.0f, -1.0f, 1.0f), det);
+            const float4 x = mul(sub(mul(det_d, a), multiply(b, d_c)), inv_det);
+            const float4 y = mul(sub(mul(det_b, c), multiply_adjugate(d, a_b)), inv_det);
+            const float4 z = mul(sub(mul(det_c, b), multiply_adjugate(a, d_c)), inv_det);
+            const float4 w = mul(sub(mul(det_a, d), multiply(c, a_b)), inv_det);
+
+            Matrix4 result;
+            store(result.m[0], shuffle<3, 1, 3, 1>(x, y));
+            store(result.m[1], shuffle<2, 0, 2, 0>(x, y));
+            store(result.m[2], shuffle<3, 1, 3, 1>(z, w));
+            store(result.m[3], shuffle<2, 0, 2, 0>(z, w));
             return result;
         }
 
-        Vector3 get_translation() const {
+        constexpr Vector3 get_translation() const {
             return Vector3(m03, m13, m23);
         }
 
@@ -520,7 +604,7 @@ namespace softcube {
             );
         }
 
-        Vector3 transform_point(const Vector3 &v) const {
+        constexpr Vector3 transform_point(const Vector3 &v) const {
             Vector4 transformed = transform_vector(Vector4(v, 1.0f));
             if (std::abs(transformed.w) > 1e-6f) {
                 float inv_w = 1.0f / transformed.w;
@@ -529,7 +613,7 @@ namespace softcube {
             return Vector3(transformed.x, transformed.y, transformed.z);
         }
 
-        Vector3 transform_vector(const Vector3 &v) const {
+        constexpr Vector3 transform_vector(const Vector3 &v) const {
             return Vector3(
                 m00 * v.x + m01 * v.y + m02 * v.z,
                 m10 * v.x + m11 * v.y + m12 * v.z,
@@ -541,13 +625,26 @@ namespace softcube {
             return normalize(transform_vector(v));
         }
 
-        Vector4 transform_vector(const Vector4 &v) const {
-            return Vector4(
-                m00 * v.x + m01 * v.y + m02 * v.z + m03 * v.w,
-                m10 * v.x + m11 * v.y + m12 * v.z + m13 * v.w,
-                m20 * v.x + m21 * v.y + m22 * v.z + m23 * v.w,
-                m30 * v.x + m31 * v.y + m32 * v.z + m33 * v.w
-            );
+        constexpr Vector4 transform_vector(const Vector4 &v) const {
+            if consteval {
+                return Vector4(get_row(0).dot(v), get_row(1).dot(v), get_row(2).dot(v), get_row(3).dot(v));
+            }
+
+            // Columns scaled by the components, summed in the same order as the row dot products.
+            simd::float4 column0 = simd::load(m[0]);
+            simd::float4 column1 = simd::load(m[1]);
+            simd::float4 column2 = simd::load(m[2]);
+            simd::float4 column3 = simd::load(m[3]);
+            simd::transpose(column0, column1, column2, column3);
+
+            simd::float4 result = simd::mul(column0, simd::splat(v.x));
+            result = simd::add(result, simd::mul(column1, simd::splat(v.y)));
+            result = simd::add(result, simd::mul(column2, simd::splat(v.z)));
+            result = simd::add(result, simd::mul(column3, simd::splat(v.w)));
+
+            Vector4 transformed;
+            simd::store(&transformed.x, result);
+            return transformed;
         }
 
         Matrix4 operator+(const Matrix4 &other) const {
@@ -566,14 +663,34 @@ namespace softcube {
             return result;
         }
 
-        Matrix4 operator*(const Matrix4 &other) const {
-            Matrix4 result = zero();
+        constexpr Matrix4 operator*(const Matrix4 &other) const {
+            if consteval {
+                const auto element = [&](const int row, const int column) {
+                    return get_row(row).dot(other.get_column(column));
+                };
+
+                return {
+                    element(0, 0), element(0, 1), element(0, 2), element(0, 3),
+                    element(1, 0), element(1, 1), element(1, 2), element(1, 3),
+                    element(2, 0), element(2, 1), element(2, 2), element(2, 3),
+                    element(3, 0), element(3, 1), element(3, 2), element(3, 3)
+                };
+            }
+
+            const simd::float4 other0 = simd::load(other.m[0]);
+            const simd::float4 other1 = simd::load(other.m[1]);
+            const simd::float4 other2 = simd::load(other.m[2]);
+            const simd::float4 other3 = simd::load(other.m[3]);
+
+            // Each result row is this row's elements weighting the rows of other.
+            Matrix4 result;
             for (int i = 0; i < 4; ++i) {
-                for (int j = 0; j < 4; ++j) {
-                    for (int k = 0; k < 4; ++k) {
-                        result.m[i][j] += m[i][k] * other.m[k][j];
-                    }
-                }
+                const simd::float4 row = simd::load(m[i]);
+                simd::float4 sum = simd::mul(simd::broadcast<0>(row), other0);
+                sum = simd::add(sum, simd::mul(simd::broadcast<1>(row), other1));
+                sum = simd::add(sum, simd::mul(simd::broadcast<2>(row), other2));
+                sum = simd::add(sum, simd::mul(simd::broadcast<3>(row), other3));
+                simd::store(result.m[i], sum);
             }
             return result;
         }
@@ -586,7 +703,7 @@ namespace softcube {
             return result;
         }
 
-        Vector4 operator*(const Vector4 &v) const {
+        constexpr Vector4 operator*(const Vector4 &v) const {
             return transform_vector(v);
         }
 
@@ -604,7 +721,7 @@ namespace softcube {
             return *this;
         }
 
-        Matrix4 &operator*=(const Matrix4 &other) {
+        constexpr Matrix4 &operator*=(const Matrix4 &other) {
             *this = *this * other;
             return *this;
         }
@@ -630,6 +747,9 @@ namespace softcube {
         }
     };
 
+    static_assert(sizeof(Vector4) == 4 * sizeof(float), "Vector4 is loaded as one SIMD register");
+    static_assert(sizeof(Matrix4) == 16 * sizeof(float), "Matrix4 rows are loaded as SIMD registers");
+
     inline Matrix4 operator*(const float scalar, const Matrix4 &matrix) {
         return matrix * scalar;
     }
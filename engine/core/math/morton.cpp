@@ -0,0 +1,32 @@
+#include "morton.hpp"
+#include "ivector3.hpp"
+
+// Compile-time checks of the portable interleave paths; the BMI2 paths are
+// only taken at runtime and must agree with them.
+namespace softcube::math {
+    static_assert(morton_encode_2d(0b11, 0b00) == 0b0101);
+    static_assert(morton_encode_2d(0b00, 0b11) == 0b1010);
+    static_assert(morton_encode_3d(1, 0, 0) == 0b001 && morton_encode_3d(0, 1, 0) == 0b010 &&
+                  morton_encode_3d(0, 0, 1) == 0b100);
+    static_assert(morton_encode_2d(0xFFFFFFFFu, 0xFFFFFFFFu) == ~0ull);
+    static_assert(morton_encode_3d(0x1FFFFF, 0x1FFFFF, 0x1FFFFF) == 0x7FFFFFFFFFFFFFFFull);
+
+    static_assert(morton_decode_2d(morton_encode_2d(0x12345678u, 0x9ABCDEF0u)) == std::array<u32, 2>{
+        0x12345678u, 0x9ABCDEF0u
+    });
+    static_assert(morton_decode_3d(morton_encode_3d(0x1ABCDE, 0x012345, 0x1FFFFF)) == std::array<u32, 3>{
+        0x1ABCDE, 0x012345, 0x1FFFFF
+    });
+
+    static_assert(IVector2::from_morton(IVector2(-7, 123456).to_morton()) == IVector2(-7, 123456));
+    static_assert(IVector3::from_morton(IVector3(-1, 0, 1).to_morton()) == IVector3(-1, 0, 1));
+    static_assert(IVector3::from_morton(IVector3(-IVector3::morton_range).to_morton()) ==
+                  IVector3(-IVector3::morton_range));
+    static_assert(IVector3(-1, -1, -1).to_morton() < IVector3(0, 0, 0).to_morton());
+
+    static_assert(floor_div(-1, 16) == -1 && floor_div(-16, 16) == -1 && floor_div(-17, 16) == -2);
+    static_assert(floor_div(15, 16) == 0 && floor_div(7, -2) == -4);
+    static_assert(floor_mod(-1, 16) == 15 && floor_mod(-16, 16) == 0 && floor_mod(17, 16) == 1);
+    static_assert(floor_mod(7, -2) == -1);
+    static_assert(floor_to_int(-0.5f) == -1 && floor_to_int(-1.0f) == -1 && floor_to_int(1.5f) == 1);
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include "core/common.hpp"
+
+#include <array>
+
+// pdep/pext interleave in one instruction each. They are only used when the
+// compiler targets BMI2 (SOFTCUBE_BMI2 in CMake); note that AMD CPUs before
+// Zen 3 implement them in microcode and run slower than the fallback.
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+    #define SOFTCUBE_MORTON_BMI2
+    #include <immintrin.h>
+#endif
+
+namespace softcube::math {
+    namespace detail {
+        constexpr u64 morton_mask_2d_x = 0x5555555555555555ull;
+        constexpr u64 morton_mask_2d_y = 0xAAAAAAAAAAAAAAAAull;
+        constexpr u64 morton_mask_3d_x = 0x1249249249249249ull;
+        constexpr u64 morton_mask_3d_y = 0x2492492492492492ull;
+        constexpr u64 morton_mask_3d_z = 0x4924924924924924ull;
+
+        // Put a zero bit between each of the 32 low bits.
+        constexpr u64 spread_bits_2d(u64 value) {
+            value &= 0xFFFFFFFFull;
+            value = (value | value << 16) & 0x0000FFFF0000FFFFull;
+            value = (value | value << 8) & 0x00FF00FF00FF00FFull;
+            value = (value | value << 4) & 0x0F0F0F0F0F0F0F0Full;
+            value = (value | value << 2) & 0x3333333333333333ull;
+            value = (value | value << 1) & 0x5555555555555555ull;
+            return value;
+        }
+
+        constexpr u32 compact_bits_2d(u64 value) {
+            value &= 0x5555555555555555ull;
+            value = (value | value >> 1) & 0x3333333333333333ull;
+            value = (value | value >> 2) & 0x0F0F0F0F0F0F0F0Full;
+            value = (value | value >> 4) & 0x00FF00FF00FF00FFull;
+            value = (value | value >> 8) & 0x0000FFFF0000FFFFull;
+            value = (value | value >> 16) & 0x00000000FFFFFFFFull;
+            return static_cast<u32>(value);
+        }
+
+        // Put two zero bits between each of the 21 low bits.
+        constexpr u64 spread_bits_3d(u64 value) {
+            value &= 0x1FFFFFull;
+            value = (value | value << 32) & 0x001F00000000FFFFull;
+            value = (value | value << 16) & 0x001F0000FF0000FFull;
+            value = (value | value << 8) & 0x100F00F00F00F00Full;
+            value = (value | value << 4) & 0x10C30C30C30C30C3ull;
+            value = (value | value << 2) & 0x1249249249249249ull;
+            return value;
+        }
+
+        constexpr u32 compact_bits_3d(u64 value) {
+            value &= 0x1249249249249249ull;
+            value = (value | value >> 2) & 0x10C30C30C30C30C3ull;
+            value = (value | value >> 4) & 0x100F00F00F00F00Full;
+            value = (value | value >> 8) & 0x001F0000FF0000FFull;
+            value = (value | value >> 16) & 0x001F00000000FFFFull;
+            value = (value | value >> 32) & 0x00000000001FFFFFull;
+            return static_cast<u32>(value);
+        }
+    }
+
+    /**
+     * @brief Interleave two 32-bit coordinates into a Z-order code, x in the lowest bit
+     */
+    constexpr u64 morton_encode_2d(const u32 x, const u32 y) {
+#if defined(SOFTCUBE_MORTON_BMI2)
+        if !consteval {
+            return _pdep_u64(x, detail::morton_mask_2d_x) | _pdep_u64(y, detail::morton_mask_2d_y);
+        }
+#endif
+        return detail::spread_bits_2d(x) | detail::spread_bits_2d(y) << 1;
+    }
+
+    /**
+     * @brief Split a 2D Z-order code back into x and y
+     */
+    constexpr std::array<u32, 2> morton_decode_2d(const u64 code) {
+#if defined(SOFTCUBE_MORTON_BMI2)
+        if !consteval {
+            return {
+                static_cast<u32>(_pext_u64(code, detail::morton_mask_2d_x)),
+                static_cast<u32>(_pext_u64(code, detail::morton_mask_2d_y))
+            };
+        }
+#endif
+        return {detail::compact_bits_2d(code), detail::compact_bits_2d(code >> 1)};
+    }
+
+    /**
+     * @brief Interleave three coordinates into a Z-order code, x in the lowest bit
+     *
+     * Only the low 21 bits of each coordinate fit in the 63-bit code; higher bits are dropped.
+     */
+    constexpr u64 morton_encode_3d(const u32 x, const u32 y, const u32 z) {
+#if defined(SOFTCUBE_MORTON_BMI2)
+        if !consteval {
+            return _pdep_u64(x, detail::morton_mask_3d_x) | _pdep_u64(y, detail::morton_mask_3d_y) |
+                   _pdep_u64(z, detail::morton_mask_3d_z);
+        }
+#endif
+        return detail::spread_bits_3d(x) | detail::spread_bits_3d(y) << 1 | detail::spread_bits_3d(z) << 2;
+    }
+
+    /**
+     * @brief Split a 3D Z-order code back into x, y and z
+     */
+    constexpr std::array<u32, 3> morton_decode_3d(const u64 code) {
+#if defined(SOFTCUBE_MORTON_BMI2)
+        if !consteval {
+            return {
+                static_cast<u32>(_pext_u64(code, detail::morton_mask_3d_x)),
+                static_cast<u32>(_pext_u64(code, detail::morton_mask_3d_y)),
+                static_cast<u32>(_pext_u64(code, detail::morton_mask_3d_z))
+            };
+        }
+#endif
+        return {detail::compact_bits_3d(code), detail::compact_bits_3d(code >> 1), detail::compact_bits_3d(code >> 2)};
+    }
+}
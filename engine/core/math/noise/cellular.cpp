@@ -0,0 +1,99 @@
+#include "noise_kernels.hpp"
+
+namespace softcube::math::noise::detail {
+    namespace {
+        // Feature points stay this far from their cell center on each axis, close
+        // enough that the nearest one is almost always in the surrounding cells.
+        constexpr float jitter = 0.43701595f;
+
+        // Ten hash bits per axis, mapped to [-jitter, jitter].
+        template<int Shift>
+        float4 jitter_offset(const int4 hash) {
+            int4 bits = hash;
+            if constexpr (Shift > 0) {
+                bits = simd::shift_right<Shift>(hash);
+            }
+            bits = simd::bit_and(bits, simd::splat(1023));
+            return simd::sub(simd::mul(simd::to_float4(bits), simd::splat(2.0f * jitter / 1023.0f)),
+                             simd::splat(jitter));
+        }
+    }
+
+    float4 cellular(const i32 seed, const float4 x, const float4 y) {
+        const float4 half = simd::splat(0.5f);
+        const float4 x_cell = simd::floor(simd::add(x, half));
+        const float4 y_cell = simd::floor(simd::add(y, half));
+
+        const int4 seeds = simd::splat(seed);
+        const int4 x_start = simd::mul(simd::sub(simd::to_int4(x_cell), simd::splat(1)), simd::splat(prime_x));
+        const int4 y_start = simd::mul(simd::sub(simd::to_int4(y_cell), simd::splat(1)), simd::splat(prime_y));
+        const float4 dx_start = simd::sub(simd::sub(x_cell, simd::splat(1.0f)), x);
+        const float4 dy_start = simd::sub(simd::sub(y_cell, simd::splat(1.0f)), y);
+
+        float4 nearest = simd::splat(1e10f);
+        int4 x_primed = x_start;
+        float4 dx = dx_start;
+        for (int i = 0; i < 3; ++i) {
+            int4 y_primed = y_start;
+            float4 dy = dy_start;
+            for (int j = 0; j < 3; ++j) {
+                const int4 cell = hash(seeds, x_primed, y_primed);
+                const float4 px = simd::add(dx, jitter_offset<0>(cell));
+                const float4 py = simd::add(dy, jitter_offset<10>(cell));
+                nearest = simd::min(nearest, simd::add(simd::mul(px, px), simd::mul(py, py)));
+
+                y_primed = simd::add(y_primed, simd::splat(prime_y));
+                dy = simd::add(dy, simd::splat(1.0f));
+            }
+            x_primed = simd::add(x_primed, simd::splat(prime_x));
+            dx = simd::add(dx, simd::splat(1.0f));
+        }
+
+        return simd::sub(simd::sqrt(nearest), simd::splat(1.0f));
+    }
+
+    float4 cellular(const i32 seed, const float4 x, const float4 y, const float4 z) {
+        const float4 half = simd::splat(0.5f);
+        const float4 x_cell = simd::floor(simd::add(x, half));
+        const float4 y_cell = simd::floor(simd::add(y, half));
+        const float4 z_cell = simd::floor(simd::add(z, half));
+
+        const int4 seeds = simd::splat(seed);
+        const int4 x_start = simd::mul(simd::sub(simd::to_int4(x_cell), simd::splat(1)), simd::splat(prime_x));
+        const int4 y_start = simd::mul(simd::sub(simd::to_int4(y_cell), simd::splat(1)), simd::splat(prime_y));
+        const int4 z_start = simd::mul(simd::sub(simd::to_int4(z_cell), simd::splat(1)), simd::splat(prime_z));
+        const float4 dx_start = simd::sub(simd::sub(x_cell, simd::splat(1.0f)), x);
+        const float4 dy_start = simd::sub(simd::sub(y_cell, simd::splat(1.0f)), y);
+        const float4 dz_start = simd::sub(simd::sub(z_cell, simd::splat(1.0f)), z);
+
+        float4 nearest = simd::splat(1e10f);
+        int4 x_primed = x_start;
+        float4 dx = dx_start;
+        for (int i = 0; i < 3; ++i) {
+            int4 y_primed = y_start;
+            float4 dy = dy_start;
+            for (int j = 0; j < 3; ++j) {
+                int4 z_primed = z_start;
+                float4 dz = dz_start;
+                for (int k = 0; k < 3; ++k) {
+                    const int4 cell = hash(seeds, x_primed, y_primed, z_primed);
+                    const float4 px = simd::add(dx, jitter_offset<0>(cell));
+                    const float4 py = simd::add(dy, jitter_offset<10>(cell));
+                    const float4 pz = simd::add(dz, jitter_offset<20>(cell));
+                    const float4 distance = simd::add(simd::add(simd::mul(px, px), simd::mul(py, py)),
+                                                      simd::mul(pz, pz));
+                    nearest = simd::min(nearest, distance);
+
+                    z_primed = simd::add(z_primed, simd::splat(prime_z));
+                    dz = simd::add(dz, simd::splat(1.0f));
+                }
+                y_primed = simd::add(y_primed, simd::splat(prime_y));
+                dy = simd::add(dy, simd::splat(1.0f));
+            }
+            x_primed = simd::add(x_primed, simd::splat(prime_x));
+            dx = simd::add(dx, simd::splat(1.0f));
+        }
+
+        return simd::sub(simd::sqrt(nearest), simd::splat(1.0f));
+    }
+}
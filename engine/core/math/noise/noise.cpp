@@ -0,0 +1,222 @@
+#include "noise.hpp"
+#include "noise_kernels.hpp"
+
+namespace softcube::math::noise {
+    namespace {
+        using simd::float4;
+
+        constexpr i32 lane_count = 4;
+
+        // Seeds of the warp offsets; far from the small per-octave increments of the main seed.
+        i32 offset_seed(const i32 seed, const u32 offset) {
+            return static_cast<i32>(static_cast<u32>(seed) + offset);
+        }
+
+        float4 base_noise(const NoiseType type, const i32 seed, const float4 x, const float4 y) {
+            switch (type) {
+                case NoiseType::Perlin:
+                    return detail::perlin(seed, x, y);
+                case NoiseType::Cellular:
+                    return detail::cellular(seed, x, y);
+                case NoiseType::OpenSimplex2:
+                default:
+                    return detail::open_simplex2(seed, x, y);
+            }
+        }
+
+        float4 base_noise(const NoiseType type, const i32 seed, const float4 x, const float4 y, const float4 z) {
+            switch (type) {
+                case NoiseType::Perlin:
+                    return detail::perlin(seed, x, y, z);
+                case NoiseType::Cellular:
+                    return detail::cellular(seed, x, y, z);
+                case NoiseType::OpenSimplex2:
+                default:
+                    return detail::open_simplex2(seed, x, y, z);
+            }
+        }
+
+        /**
+         * @brief Sum octaves of the base noise; coordinates are already scaled by the base frequency
+         */
+        template<typename Sample>
+        float4 fractal(const NoiseSettings &settings, const float bounding, Sample &&sample) {
+            if (settings.fractal == FractalType::None) {
+                return sample(settings.seed, 1.0f);
+            }
+
+            const float4 one = simd::splat(1.0f);
+            const float4 two = simd::splat(2.0f);
+            float4 sum = simd::splat(0.0f);
+            float amplitude = bounding;
+            float frequency = 1.0f;
+            i32 seed = settings.seed;
+
+            for (i32 octave = 0; octave < settings.octaves; ++octave) {
+                float4 value = sample(seed, frequency);
+                switch (settings.fractal) {
+                    case FractalType::Ridged:
+                        value = simd::sub(one, simd::mul(simd::abs(value), two));
+                        break;
+                    case FractalType::Billow:
+                        value = simd::sub(simd::mul(simd::abs(value), two), one);
+                        break;
+                    default:
+                        break;
+                }
+
+                sum = simd::add(sum, simd::mul(value, simd::splat(amplitude)));
+                amplitude *= settings.gain;
+                frequency *= settings.lacunarity;
+                seed = offset_seed(seed, 1);
+            }
+            return sum;
+        }
+
+        float4 evaluate(const NoiseSettings &settings, const float bounding, float4 x, float4 y) {
+            if (settings.warp_amplitude != 0.0f) {
+                const float4 frequency = simd::splat(settings.warp_frequency);
+                const float4 amplitude = simd::splat(settings.warp_amplitude);
+                const float4 wx = simd::mul(x, frequency);
+                const float4 wy = simd::mul(y, frequency);
+                const float4 dx = detail::open_simplex2(offset_seed(settings.seed, 0x9E3779B9u), wx, wy);
+                const float4 dy = detail::open_simplex2(offset_seed(settings.seed, 0x3C6EF372u), wx, wy);
+                x = simd::add(x, simd::mul(dx, amplitude));
+                y = simd::add(y, simd::mul(dy, amplitude));
+            }
+
+            x = simd::mul(x, simd::splat(settings.frequency));
+            y = simd::mul(y, simd::splat(settings.frequency));
+            return fractal(settings, bounding, [&](const i32 seed, const float frequency) {
+                const float4 scale = simd::splat(frequency);
+                return base_noise(settings.type, seed, simd::mul(x, scale), simd::mul(y, scale));
+            });
+        }
+
+        float4 evaluate(const NoiseSettings &settings, const float bounding, float4 x, float4 y, float4 z) {
+            if (settings.warp_amplitude != 0.0f) {
+                const float4 frequency = simd::splat(settings.warp_frequency);
+                const float4 amplitude = simd::splat(settings.warp_amplitude);
+                const float4 wx = simd::mul(x, frequency);
+                const float4 wy = simd::mul(y, frequency);
+                const float4 wz = simd::mul(z, frequency);
+                const float4 dx = detail::open_simplex2(offset_seed(settings.seed, 0x9E3779B9u), wx, wy, wz);
+                const float4 dy = detail::open_simplex2(offset_seed(settings.seed, 0x3C6EF372u), wx, wy, wz);
+                const float4 dz = detail::open_simplex2(offset_seed(settings.seed, 0xDAA66D2Bu), wx, wy, wz);
+                x = simd::add(x, simd::mul(dx, amplitude));
+                y = simd::add(y, simd::mul(dy, amplitude));
+                z = simd::add(z, simd::mul(dz, amplitude));
+            }
+
+            x = simd::mul(x, simd::splat(settings.frequency));
+            y = simd::mul(y, simd::splat(settings.frequency));
+            z = simd::mul(z, simd::splat(settings.frequency));
+            return fractal(settings, bounding, [&](const i32 seed, const float frequency) {
+                const float4 scale = simd::splat(frequency);
+                return base_noise(settings.type, seed, simd::mul(x, scale), simd::mul(y, scale),
+                                  simd::mul(z, scale));
+            });
+        }
+
+        // x coordinates of four consecutive cells starting at cell column x.
+        float4 row_lanes(const float origin, const float step, const i32 x) {
+            const float4 columns = simd::add(simd::to_float4(simd::splat(x)), simd::set(0.0f, 1.0f, 2.0f, 3.0f));
+            return simd::add(simd::splat(origin), simd::mul(columns, simd::splat(step)));
+        }
+
+        void store_row(float *destination, const float4 values, const i32 count) {
+            if (count == lane_count) {
+                simd::store(destination, values);
+                return;
+            }
+
+            float lanes[lane_count];
+            simd::store(lanes, values);
+            std::copy_n(lanes, count, destination);
+        }
+    }
+
+    float perlin(const i32 seed, const Vector2 &position) {
+        return simd::get_x(detail::perlin(seed, simd::splat(position.x), simd::splat(position.y)));
+    }
+
+    float perlin(const i32 seed, const Vector3 &position) {
+        return simd::get_x(detail::perlin(seed, simd::splat(position.x), simd::splat(position.y),
+                                          simd::splat(position.z)));
+    }
+
+    float open_simplex2(const i32 seed, const Vector2 &position) {
+        return simd::get_x(detail::open_simplex2(seed, simd::splat(position.x), simd::splat(position.y)));
+    }
+
+    float open_simplex2(const i32 seed, const Vector3 &position) {
+        return simd::get_x(detail::open_simplex2(seed, simd::splat(position.x), simd::splat(position.y),
+                                                 simd::splat(position.z)));
+    }
+
+    float cellular(const i32 seed, const Vector2 &position) {
+        return simd::get_x(detail::cellular(seed, simd::splat(position.x), simd::splat(position.y)));
+    }
+
+    float cellular(const i32 seed, const Vector3 &position) {
+        return simd::get_x(detail::cellular(seed, simd::splat(position.x), simd::splat(position.y),
+                                            simd::splat(position.z)));
+    }
+
+    NoiseGenerator::NoiseGenerator(const NoiseSettings &settings)
+        : m_settings(settings) {
+        float amplitude = 1.0f;
+        float total = 0.0f;
+        for (i32 octave = 0; octave < std::max(settings.octaves, 1); ++octave) {
+            total += amplitude;
+            amplitude *= settings.gain;
+        }
+        m_fractal_bounding = 1.0f / total;
+    }
+
+    float NoiseGenerator::sample(const Vector2 &position) const {
+        return simd::get_x(evaluate(m_settings, m_fractal_bounding, simd::splat(position.x),
+                                    simd::splat(position.y)));
+    }
+
+    float NoiseGenerator::sample(const Vector3 &position) const {
+        return simd::get_x(evaluate(m_settings, m_fractal_bounding, simd::splat(position.x),
+                                    simd::splat(position.y), simd::splat(position.z)));
+    }
+
+    void NoiseGenerator::fill_grid(const Vector2 &origin, const float step, const IVector2 &size,
+                                   const std::span<float> out) const {
+        SOFTCUBE_ASSERT(out.size() == static_cast<size_t>(size.x) * size.y, "Output must hold one value per cell");
+
+        float *destination = out.data();
+        for (i32 y = 0; y < size.y; ++y) {
+            const float4 ys = simd::splat(origin.y + static_cast<float>(y) * step);
+            for (i32 x = 0; x < size.x; x += lane_count) {
+                const i32 count = std::min(lane_count, size.x - x);
+                store_row(destination, evaluate(m_settings, m_fractal_bounding, row_lanes(origin.x, step, x), ys),
+                          count);
+                destination += count;
+            }
+        }
+    }
+
+    void NoiseGenerator::fill_grid(const Vector3 &origin, const float step, const IVector3 &size,
+                                   const std::span<float> out) const {
+        SOFTCUBE_ASSERT(out.size() == static_cast<size_t>(size.x) * size.y * size.z,
+                        "Output must hold one value per cell");
+
+        float *destination = out.data();
+        for (i32 y = 0; y < size.y; ++y) {
+            const float4 ys = simd::splat(origin.y + static_cast<float>(y) * step);
+            for (i32 z = 0; z < size.z; ++z) {
+                const float4 zs = simd::splat(origin.z + static_cast<float>(z) * step);
+                for (i32 x = 0; x < size.x; x += lane_count) {
+                    const i32 count = std::min(lane_count, size.x - x);
+                    store_row(destination, evaluate(m_settings, m_fractal_bounding, row_lanes(origin.x, step, x), ys,
+                                                    zs), count);
+                    destination += count;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/math/vector2.hpp"
+#include "core/math/vector3.hpp"
+#include "core/math/ivector3.hpp"
+
+#include <span>
+
+namespace softcube::math::noise {
+    /**
+     * @brief Base noise a NoiseGenerator evaluates at each octave
+     */
+    enum class NoiseType : u8 {
+        Perlin,
+        OpenSimplex2,
+        Cellular // Distance to the nearest jittered feature point, minus one
+    };
+
+    /**
+     * @brief How octaves of the base noise are combined
+     */
+    enum class FractalType : u8 {
+        None, // A single octave
+        FBm, // Sum of octaves at rising frequency and falling amplitude
+        Ridged, // Sharp crests where the base noise crosses zero
+        Billow // Rounded bumps; the absolute value of each octave
+    };
+
+    /**
+     * @brief Perlin gradient noise in roughly [-1, 1]
+     */
+    float perlin(i32 seed, const Vector2 &position);
+
+    float perlin(i32 seed, const Vector3 &position);
+
+    /**
+     * @brief OpenSimplex2 noise in roughly [-1, 1]; fewer axis-aligned artifacts than Perlin
+     */
+    float open_simplex2(i32 seed, const Vector2 &position);
+
+    float open_simplex2(i32 seed, const Vector3 &position);
+
+    /**
+     * @brief Cellular (Worley) noise: distance to the nearest feature point minus one
+     */
+    float cellular(i32 seed, const Vector2 &position);
+
+    float cellular(i32 seed, const Vector3 &position);
+
+    /**
+     * @struct NoiseSettings
+     * @brief Everything that shapes the output of a NoiseGenerator
+     */
+    struct NoiseSettings {
+        NoiseType type = NoiseType::OpenSimplex2;
+        i32 seed = 1337;
+        float frequency = 0.01f; // Base noise cycles per world unit
+
+        FractalType fractal = FractalType::FBm;
+        i32 octaves = 3;
+        float lacunarity = 2.0f; // Frequency multiplier between octaves
+        float gain = 0.5f; // Amplitude multiplier between octaves
+
+        float warp_amplitude = 0.0f; // How far domain warping moves positions, in world units; 0 disables it
+        float warp_frequency = 0.005f;
+    };
+
+    /**
+     * @class NoiseGenerator
+     * @brief Fractal, optionally domain-warped noise for terrain generation
+     *
+     * Samples are computed four at a time with the SIMD backend and only use
+     * operations that round the same way on every backend, so a seed gives
+     * identical values on SSE2, NEON and the scalar fallback. sample() runs
+     * the same code as fill_grid(), so sample(origin + Vector3(x, y, z) * step)
+     * matches the grid cell exactly. Coordinates times the frequency must stay
+     * within the i32 range.
+     */
+    class NoiseGenerator {
+    public:
+        explicit NoiseGenerator(const NoiseSettings &settings = {});
+
+        [[nodiscard]] const NoiseSettings &get_settings() const { return m_settings; }
+
+        [[nodiscard]] float sample(const Vector2 &position) const;
+
+        [[nodiscard]] float sample(const Vector3 &position) const;
+
+        /**
+         * @brief Sample a grid of points spaced step apart, x varying fastest
+         *
+         * Cell (x, y) holds the sample at origin + (x, y) * step and is stored at y * size.x + x.
+         *
+         * @param origin Position of the first cell
+         * @param step Distance between neighbouring cells
+         * @param size Cells along each axis
+         * @param out Output, size.x * size.y values
+         */
+        void fill_grid(const Vector2 &origin, float step, const IVector2 &size, std::span<float> out) const;
+
+        /**
+         * @brief Sample a grid of points spaced step apart, in the block order of a chunk
+         *
+         * Cell (x, y, z) holds the sample at origin + (x, y, z) * step and is
+         * stored at (y * size.z + z) * size.x + x, which for a 16^3 grid is
+         * voxel::local_to_index.
+         *
+         * @param origin Position of the first cell
+         * @param step Distance between neighbouring cells
+         * @param size Cells along each axis
+         * @param out Output, size.x * size.y * size.z values
+         */
+        void fill_grid(const Vector3 &origin, float step, const IVector3 &size, std::span<float> out) const;
+
+    private:
+        NoiseSettings m_settings;
+        float m_fractal_bounding; // Scales the octave sum back to roughly [-1, 1]
+    };
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/math/simd.hpp"
+
+// Lattice noise evaluated four samples at a time. Only simd:: operations
+// are used, so the scalar backend computes the same bits as SSE2 and NEON
+// and a seed produces the same terrain in every build.
+namespace softcube::math::noise::detail {
+    using simd::float4;
+    using simd::int4;
+
+    // Lattice coordinates are multiplied by large primes before hashing so
+    // neighbouring cells differ in many bits.
+    constexpr i32 prime_x = 501125321;
+    constexpr i32 prime_y = 1136930381;
+    constexpr i32 prime_z = 1720413743;
+
+    inline int4 hash(const int4 seed, const int4 x_primed, const int4 y_primed) {
+        const int4 hash = simd::mul(simd::bit_xor(seed, simd::bit_xor(x_primed, y_primed)), simd::splat(0x27D4EB2D));
+        return simd::bit_xor(hash, simd::shift_right<15>(hash));
+    }
+
+    inline int4 hash(const int4 seed, const int4 x_primed, const int4 y_primed, const int4 z_primed) {
+        return hash(seed, simd::bit_xor(x_primed, y_primed), z_primed);
+    }
+
+    inline float4 mask_of(const int4 mask) {
+        return simd::as_float4(mask);
+    }
+
+    inline int4 bit_is_clear(const int4 value, const i32 bit) {
+        return simd::equal(simd::bit_and(value, simd::splat(bit)), simd::splat(0));
+    }
+
+    // Flip the sign of each lane of value whose selected hash bit is set.
+    template<int Bit>
+    float4 flip_sign(const float4 value, const int4 hash) {
+        return simd::bit_xor(value, simd::as_float4(simd::shift_left<31 - Bit>(simd::bit_and(hash, simd::splat(1 << Bit)))));
+    }
+
+    /**
+     * @brief Dot product with one of eight unit gradients: the axes and the diagonals
+     */
+    inline float4 gradient_dot(const int4 hash, const float4 x, const float4 y) {
+        const float4 axis = flip_sign<0>(simd::select(mask_of(bit_is_clear(hash, 2)), x, y), hash);
+        const float4 diagonal = simd::mul(simd::add(flip_sign<0>(x, hash), flip_sign<1>(y, hash)),
+                                          simd::splat(0.70710678f));
+        return simd::select(mask_of(bit_is_clear(hash, 4)), diagonal, axis);
+    }
+
+    /**
+     * @brief Dot product with one of the twelve cube edge gradients, picked from the low four hash bits
+     */
+    inline float4 gradient_dot(const int4 hash, const float4 x, const float4 y, const float4 z) {
+        // Four of the sixteen codes repeat an edge, as in improved Perlin noise.
+        const int4 low = simd::bit_and(hash, simd::splat(15));
+        const float4 u = simd::select(mask_of(bit_is_clear(low, 8)), x, y);
+        const float4 x_or_z = simd::select(mask_of(simd::equal(simd::bit_and(low, simd::splat(13)), simd::splat(12))),
+                                           x, z);
+        const float4 v = simd::select(mask_of(simd::equal(simd::bit_and(low, simd::splat(12)), simd::splat(0))),
+                                      y, x_or_z);
+        return simd::add(flip_sign<0>(u, hash), flip_sign<1>(v, hash));
+    }
+
+    inline float4 lerp(const float4 a, const float4 b, const float4 t) {
+        return simd::add(a, simd::mul(t, simd::sub(b, a)));
+    }
+
+    /**
+     * @brief 6t^5 - 15t^4 + 10t^3, whose first and second derivatives vanish at 0 and 1
+     */
+    inline float4 quintic(const float4 t) {
+        const float4 poly = simd::add(simd::mul(t, simd::sub(simd::mul(t, simd::splat(6.0f)), simd::splat(15.0f))),
+                                      simd::splat(10.0f));
+        return simd::mul(simd::mul(simd::mul(t, t), t), poly);
+    }
+
+    inline float4 pow4(const float4 v) {
+        const float4 squared = simd::mul(v, v);
+        return simd::mul(squared, squared);
+    }
+
+    float4 perlin(i32 seed, float4 x, float4 y);
+
+    float4 perlin(i32 seed, float4 x, float4 y, float4 z);
+
+    float4 open_simplex2(i32 seed, float4 x, float4 y);
+
+    float4 open_simplex2(i32 seed, float4 x, float4 y, float4 z);
+
+    float4 cellular(i32 seed, float4 x, float4 y);
+
+    float4 cellular(i32 seed, float4 x, float4 y, float4 z);
+}
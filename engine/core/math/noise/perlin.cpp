@@ -0,0 +1,68 @@
+#include "noise_kernels.hpp"
+
+namespace softcube::math::noise::detail {
+    float4 perlin(const i32 seed, const float4 x, const float4 y) {
+        const float4 x_floor = simd::floor(x);
+        const float4 y_floor = simd::floor(y);
+        const float4 one = simd::splat(1.0f);
+
+        const float4 xd0 = simd::sub(x, x_floor);
+        const float4 yd0 = simd::sub(y, y_floor);
+        const float4 xd1 = simd::sub(xd0, one);
+        const float4 yd1 = simd::sub(yd0, one);
+        const float4 xs = quintic(xd0);
+        const float4 ys = quintic(yd0);
+
+        const int4 seeds = simd::splat(seed);
+        const int4 x0 = simd::mul(simd::to_int4(x_floor), simd::splat(prime_x));
+        const int4 y0 = simd::mul(simd::to_int4(y_floor), simd::splat(prime_y));
+        const int4 x1 = simd::add(x0, simd::splat(prime_x));
+        const int4 y1 = simd::add(y0, simd::splat(prime_y));
+
+        const float4 bottom = lerp(gradient_dot(hash(seeds, x0, y0), xd0, yd0),
+                                   gradient_dot(hash(seeds, x1, y0), xd1, yd0), xs);
+        const float4 top = lerp(gradient_dot(hash(seeds, x0, y1), xd0, yd1),
+                                gradient_dot(hash(seeds, x1, y1), xd1, yd1), xs);
+
+        // Unit gradients reach at most sqrt(1/2) at a cell center.
+        return simd::mul(lerp(bottom, top, ys), simd::splat(1.41421356f));
+    }
+
+    float4 perlin(const i32 seed, const float4 x, const float4 y, const float4 z) {
+        const float4 x_floor = simd::floor(x);
+        const float4 y_floor = simd::floor(y);
+        const float4 z_floor = simd::floor(z);
+        const float4 one = simd::splat(1.0f);
+
+        const float4 xd0 = simd::sub(x, x_floor);
+        const float4 yd0 = simd::sub(y, y_floor);
+        const float4 zd0 = simd::sub(z, z_floor);
+        const float4 xd1 = simd::sub(xd0, one);
+        const float4 yd1 = simd::sub(yd0, one);
+        const float4 zd1 = simd::sub(zd0, one);
+        const float4 xs = quintic(xd0);
+        const float4 ys = quintic(yd0);
+        const float4 zs = quintic(zd0);
+
+        const int4 seeds = simd::splat(seed);
+        const int4 x0 = simd::mul(simd::to_int4(x_floor), simd::splat(prime_x));
+        const int4 y0 = simd::mul(simd::to_int4(y_floor), simd::splat(prime_y));
+        const int4 z0 = simd::mul(simd::to_int4(z_floor), simd::splat(prime_z));
+        const int4 x1 = simd::add(x0, simd::splat(prime_x));
+        const int4 y1 = simd::add(y0, simd::splat(prime_y));
+        const int4 z1 = simd::add(z0, simd::splat(prime_z));
+
+        const float4 x00 = lerp(gradient_dot(hash(seeds, x0, y0, z0), xd0, yd0, zd0),
+                                gradient_dot(hash(seeds, x1, y0, z0), xd1, yd0, zd0), xs);
+        const float4 x10 = lerp(gradient_dot(hash(seeds, x0, y1, z0), xd0, yd1, zd0),
+                                gradient_dot(hash(seeds, x1, y1, z0), xd1, yd1, zd0), xs);
+        const float4 x01 = lerp(gradient_dot(hash(seeds, x0, y0, z1), xd0, yd0, zd1),
+                                gradient_dot(hash(seeds, x1, y0, z1), xd1, yd0, zd1), xs);
+        const float4 x11 = lerp(gradient_dot(hash(seeds, x0, y1, z1), xd0, yd1, zd1),
+                                gradient_dot(hash(seeds, x1, y1, z1), xd1, yd1, zd1), xs);
+
+        const float4 near = lerp(x00, x10, ys);
+        const float4 far = lerp(x01, x11, ys);
+        return simd::mul(lerp(near, far, zs), simd::splat(0.96492141f));
+    }
+}
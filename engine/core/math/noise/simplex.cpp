@@ -0,0 +1,154 @@
+#include "noise_kernels.hpp"
+
+namespace softcube::math::noise::detail {
+    namespace {
+        constexpr float skew_2d = 0.36602540f; // (sqrt(3) - 1) / 2
+        constexpr float unskew_2d = 0.21132487f; // (3 - sqrt(3)) / 6
+
+        float4 contribution(const float4 falloff, const int4 hash, const float4 x, const float4 y) {
+            return simd::mul(pow4(simd::max(falloff, simd::splat(0.0f))), gradient_dot(hash, x, y));
+        }
+
+        float4 contribution(const float4 falloff, const int4 hash, const float4 x, const float4 y, const float4 z) {
+            return simd::mul(pow4(simd::max(falloff, simd::splat(0.0f))), gradient_dot(hash, x, y, z));
+        }
+
+        float4 falloff_2d(const float4 x, const float4 y) {
+            return simd::sub(simd::sub(simd::splat(0.5f), simd::mul(x, x)), simd::mul(y, y));
+        }
+    }
+
+    float4 open_simplex2(const i32 seed, float4 x, float4 y) {
+        // Skew so the triangular lattice maps onto the integer grid.
+        const float4 skew = simd::mul(simd::add(x, y), simd::splat(skew_2d));
+        x = simd::add(x, skew);
+        y = simd::add(y, skew);
+
+        const float4 i = simd::floor(x);
+        const float4 j = simd::floor(y);
+        const float4 xi = simd::sub(x, i);
+        const float4 yi = simd::sub(y, j);
+
+        const float4 t = simd::mul(simd::add(xi, yi), simd::splat(unskew_2d));
+        const float4 x0 = simd::sub(xi, t);
+        const float4 y0 = simd::sub(yi, t);
+
+        const int4 seeds = simd::splat(seed);
+        const int4 i_primed = simd::mul(simd::to_int4(i), simd::splat(prime_x));
+        const int4 j_primed = simd::mul(simd::to_int4(j), simd::splat(prime_y));
+
+        // The middle vertex of the triangle depends on which side of the diagonal the point is.
+        const float4 upper = simd::less(x0, y0);
+        const int4 upper_bits = simd::as_int4(upper);
+        const float4 x1 = simd::add(x0, simd::select(upper, simd::splat(unskew_2d), simd::splat(unskew_2d - 1.0f)));
+        const float4 y1 = simd::add(y0, simd::select(upper, simd::splat(unskew_2d - 1.0f), simd::splat(unskew_2d)));
+        const int4 i1 = simd::add(i_primed, simd::select(upper_bits, simd::splat(0), simd::splat(prime_x)));
+        const int4 j1 = simd::add(j_primed, simd::select(upper_bits, simd::splat(prime_y), simd::splat(0)));
+
+        const float4 x2 = simd::add(x0, simd::splat(2.0f * unskew_2d - 1.0f));
+        const float4 y2 = simd::add(y0, simd::splat(2.0f * unskew_2d - 1.0f));
+        const int4 i2 = simd::add(i_primed, simd::splat(prime_x));
+        const int4 j2 = simd::add(j_primed, simd::splat(prime_y));
+
+        float4 value = contribution(falloff_2d(x0, y0), hash(seeds, i_primed, j_primed), x0, y0);
+        value = simd::add(value, contribution(falloff_2d(x1, y1), hash(seeds, i1, j1), x1, y1));
+        value = simd::add(value, contribution(falloff_2d(x2, y2), hash(seeds, i2, j2), x2, y2));
+        return simd::mul(value, simd::splat(99.836854f));
+    }
+
+    float4 open_simplex2(const i32 seed, float4 x, float4 y, float4 z) {
+        // Rotate so the two interleaved cubic lattices below form a body-centered cubic lattice
+        // with no axis lined up with the input axes.
+        const float4 r = simd::mul(simd::add(simd::add(x, y), z), simd::splat(2.0f / 3.0f));
+        x = simd::sub(r, x);
+        y = simd::sub(r, y);
+        z = simd::sub(r, z);
+
+        const float4 half = simd::splat(0.5f);
+        const float4 zero = simd::splat(0.0f);
+        const float4 one = simd::splat(1.0f);
+        const float4 minus_one = simd::splat(-1.0f);
+
+        const float4 i = simd::floor(simd::add(x, half));
+        const float4 j = simd::floor(simd::add(y, half));
+        const float4 k = simd::floor(simd::add(z, half));
+        float4 x0 = simd::sub(x, i);
+        float4 y0 = simd::sub(y, j);
+        float4 z0 = simd::sub(z, k);
+
+        int4 i_primed = simd::mul(simd::to_int4(i), simd::splat(prime_x));
+        int4 j_primed = simd::mul(simd::to_int4(j), simd::splat(prime_y));
+        int4 k_primed = simd::mul(simd::to_int4(k), simd::splat(prime_z));
+
+        // Set where the offset from the nearest vertex is not negative, so the
+        // next vertex along that axis is on the positive side.
+        float4 x_positive = simd::less_equal(zero, x0);
+        float4 y_positive = simd::less_equal(zero, y0);
+        float4 z_positive = simd::less_equal(zero, z0);
+
+        float4 ax0 = simd::abs(x0);
+        float4 ay0 = simd::abs(y0);
+        float4 az0 = simd::abs(z0);
+
+        int4 seeds = simd::splat(seed);
+        float4 a = simd::sub(simd::sub(simd::sub(simd::splat(0.6f), simd::mul(x0, x0)), simd::mul(y0, y0)),
+                             simd::mul(z0, z0));
+        float4 value = zero;
+
+        for (int lattice = 0; ; ++lattice) {
+            value = simd::add(value, contribution(a, hash(seeds, i_primed, j_primed, k_primed), x0, y0, z0));
+
+            // The next closest vertex is one step along the axis with the largest offset.
+            const float4 along_x = simd::bit_and(simd::less_equal(ay0, ax0), simd::less_equal(az0, ax0));
+            const float4 along_y = simd::bit_and(simd::less(ax0, ay0), simd::less_equal(az0, ay0));
+            const float4 along_z = simd::bit_xor(simd::bit_xor(along_x, along_y), simd::as_float4(simd::splat(-1)));
+            const float4 largest = simd::select(along_x, ax0, simd::select(along_y, ay0, az0));
+            const float4 b = simd::sub(simd::add(simd::add(a, largest), largest), one);
+
+            const float4 x_step = simd::select(x_positive, minus_one, one);
+            const float4 y_step = simd::select(y_positive, minus_one, one);
+            const float4 z_step = simd::select(z_positive, minus_one, one);
+            const int4 i_step = simd::select(simd::as_int4(x_positive), simd::splat(prime_x), simd::splat(-prime_x));
+            const int4 j_step = simd::select(simd::as_int4(y_positive), simd::splat(prime_y), simd::splat(-prime_y));
+            const int4 k_step = simd::select(simd::as_int4(z_positive), simd::splat(prime_z), simd::splat(-prime_z));
+
+            const int4 neighbor = hash(
+                seeds,
+                simd::add(i_primed, simd::select(simd::as_int4(along_x), i_step, simd::splat(0))),
+                simd::add(j_primed, simd::select(simd::as_int4(along_y), j_step, simd::splat(0))),
+                simd::add(k_primed, simd::select(simd::as_int4(along_z), k_step, simd::splat(0)))
+            );
+            value = simd::add(value, contribution(
+                                  b, neighbor,
+                                  simd::add(x0, simd::bit_and(along_x, x_step)),
+                                  simd::add(y0, simd::bit_and(along_y, y_step)),
+                                  simd::add(z0, simd::bit_and(along_z, z_step))
+                              ));
+
+            if (lattice == 1) {
+                break;
+            }
+
+            // Move to the second lattice, offset by half a cell on every axis.
+            ax0 = simd::sub(half, ax0);
+            ay0 = simd::sub(half, ay0);
+            az0 = simd::sub(half, az0);
+            x0 = simd::mul(x_step, ax0);
+            y0 = simd::mul(y_step, ay0);
+            z0 = simd::mul(z_step, az0);
+            a = simd::add(a, simd::sub(simd::sub(simd::splat(0.75f), ax0), simd::add(ay0, az0)));
+
+            i_primed = simd::add(i_primed, simd::select(simd::as_int4(x_positive), simd::splat(prime_x), simd::splat(0)));
+            j_primed = simd::add(j_primed, simd::select(simd::as_int4(y_positive), simd::splat(prime_y), simd::splat(0)));
+            k_primed = simd::add(k_primed, simd::select(simd::as_int4(z_positive), simd::splat(prime_z), simd::splat(0)));
+
+            const float4 all_bits = simd::as_float4(simd::splat(-1));
+            x_positive = simd::bit_xor(x_positive, all_bits);
+            y_positive = simd::bit_xor(y_positive, all_bits);
+            z_positive = simd::bit_xor(z_positive, all_bits);
+            seeds = simd::bit_xor(seeds, simd::splat(-1));
+        }
+
+        return simd::mul(value, simd::splat(32.694283f));
+    }
+}
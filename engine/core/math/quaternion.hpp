@@ -2,6 +2,7 @@
 #include "vector3.hpp"
 #include "matrix.hpp"
 #include "math_utils.hpp"
+#include "simd.hpp"
 
 namespace softcube {
     /**
@@ -16,7 +17,7 @@ namespace softcube {
 
         Quaternion() = default;
 
-        Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {
+        constexpr Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {
         }
 
         Quaternion(const Quaternion &) = default;
@@ -32,7 +33,7 @@ namespace softcube {
 
         explicit operator bx::Quaternion() const { return {x, y, z, w}; }
 
-        static Quaternion identity() {
+        static constexpr Quaternion identity() {
             return Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
         }
 
@@ -132,7 +133,7 @@ namespace softcube {
             return from_rotation_matrix(rot_matrix);
         }
 
-        Matrix3 to_rotation_matrix() const {
+        constexpr Matrix3 to_rotation_matrix() const {
             const float xx = x * x;
             const float xy = x * y;
             float xz = x * z;
@@ -191,7 +192,7 @@ namespace softcube {
             return std::sqrt(x * x + y * y + z * z + w * w);
         }
 
-        float length_squared() const {
+        constexpr float length_squared() const {
             return x * x + y * y + z * z + w * w;
         }
 
@@ -220,11 +221,11 @@ namespace softcube {
             }
         }
 
-        Quaternion conjugate() const {
+        constexpr Quaternion conjugate() const {
             return Quaternion(-x, -y, -z, w);
         }
 
-        Quaternion inverse() const {
+        constexpr Quaternion inverse() const {
             float len_sq = length_squared();
             if (len_sq > 0.0f) {
                 float inv_len_sq = 1.0f / len_sq;
@@ -238,7 +239,7 @@ namespace softcube {
             return identity();
         }
 
-        float dot(const Quaternion &other) const {
+        constexpr float dot(const Quaternion &other) const {
             return x * other.x + y * other.y + z * other.z + w * other.w;
         }
 
@@ -282,28 +283,63 @@ namespace softcube {
             );
         }
 
-        Vector3 rotate_vector(const Vector3 &v) const {
-            Vector3 q_vector(x, y, z);
-            Vector3 cross1 = cross(q_vector, v);
-            Vector3 cross2 = cross(q_vector, cross1);
+        constexpr Vector3 rotate_vector(const Vector3 &v) const {
+            // v + 2w (q x v) + 2 (q x (q x v))
+            if consteval {
+                const Vector3 q_vector(x, y, z);
+                const Vector3 cross1 = q_vector.cross(v);
+                const Vector3 cross2 = q_vector.cross(cross1);
+                return v + (cross1 * (2.0f * w) + cross2 * 2.0f);
+            }
+
+            const simd::float4 q = simd::load(&x);
+            const simd::float4 vector = simd::set(v.x, v.y, v.z, 0.0f);
+            const simd::float4 cross1 = simd::cross3(q, vector);
+            const simd::float4 cross2 = simd::cross3(q, cross1);
 
-            return v + (cross1 * (2.0f * w) + cross2 * 2.0f);
+            const simd::float4 offset = simd::add(simd::mul(cross1, simd::splat(2.0f * w)),
+                                                  simd::mul(cross2, simd::splat(2.0f)));
+            float result[4];
+            simd::store(result, simd::add(vector, offset));
+            return Vector3(result[0], result[1], result[2]);
         }
 
-        Quaternion operator*(const Quaternion &other) const {
-            return Quaternion(
-                w * other.x + x * other.w + y * other.z - z * other.y,
-                w * other.y - x * other.z + y * other.w + z * other.x,
-                w * other.z + x * other.y - y * other.x + z * other.w,
-                w * other.w - x * other.x - y * other.y - z * other.z
-            );
+        constexpr Quaternion operator*(const Quaternion &other) const {
+            if consteval {
+                return Quaternion(
+                    w * other.x + x * other.w + y * other.z - z * other.y,
+                    w * other.y - x * other.z + y * other.w + z * other.x,
+                    w * other.z + x * other.y - y * other.x + z * other.w,
+                    w * other.w - x * other.x - y * other.y - z * other.z
+                );
+            }
+
+            // Hamilton product as four scaled, sign-flipped permutations of other,
+            // accumulated in the order of the scalar formula.
+            const simd::float4 lhs = simd::load(&x);
+            const simd::float4 rhs = simd::load(&other.x);
+
+            simd::float4 result = simd::mul(simd::broadcast<3>(lhs), rhs);
+            result = simd::add(result, simd::mul(simd::broadcast<0>(lhs),
+                                                 simd::mul(simd::swizzle<3, 2, 1, 0>(rhs),
+                                                           simd::set(1.0f, -1.0f, 1.0f, -1.0f))));
+            result = simd::add(result, simd::mul(simd::broadcast<1>(lhs),
+                                                 simd::mul(simd::swizzle<2, 3, 0, 1>(rhs),
+                                                           simd::set(1.0f, 1.0f, -1.0f, -1.0f))));
+            result = simd::add(result, simd::mul(simd::broadcast<2>(lhs),
+                                                 simd::mul(simd::swizzle<1, 0, 3, 2>(rhs),
+                                                           simd::set(-1.0f, 1.0f, 1.0f, -1.0f))));
+
+            Quaternion product;
+            simd::store(&product.x, result);
+            return product;
         }
 
-        Vector3 operator*(const Vector3 &v) const {
+        constexpr Vector3 operator*(const Vector3 &v) const {
             return rotate_vector(v);
         }
 
-        Quaternion operator+(const Quaternion &other) const {
+        constexpr Quaternion operator+(const Quaternion &other) const {
             return Quaternion(
                 x + other.x,
                 y + other.y,
@@ -312,7 +348,7 @@ namespace softcube {
             );
         }
 
-        Quaternion operator-(const Quaternion &other) const {
+        constexpr Quaternion operator-(const Quaternion &other) const {
             return Quaternion(
                 x - other.x,
                 y - other.y,
@@ -321,7 +357,7 @@ namespace softcube {
             );
         }
 
-        Quaternion operator*(float scalar) const {
+        constexpr Quaternion operator*(float scalar) const {
             return Quaternion(
                 x * scalar,
                 y * scalar,
@@ -330,16 +366,16 @@ namespace softcube {
             );
         }
 
-        Quaternion operator-() const {
+        constexpr Quaternion operator-() const {
             return Quaternion(-x, -y, -z, -w);
         }
 
-        Quaternion &operator*=(const Quaternion &other) {
+        constexpr Quaternion &operator*=(const Quaternion &other) {
             *this = *this * other;
             return *this;
         }
 
-        Quaternion &operator+=(const Quaternion &other) {
+        constexpr Quaternion &operator+=(const Quaternion &other) {
             x += other.x;
             y += other.y;
             z += other.z;
@@ -347,7 +383,7 @@ namespace softcube {
             return *this;
         }
 
-        Quaternion &operator-=(const Quaternion &other) {
+        constexpr Quaternion &operator-=(const Quaternion &other) {
             x -= other.x;
             y -= other.y;
             z -= other.z;
@@ -355,7 +391,7 @@ namespace softcube {
             return *this;
         }
 
-        Quaternion &operator*=(float scalar) {
+        constexpr Quaternion &operator*=(float scalar) {
             x *= scalar;
             y *= scalar;
             z *= scalar;
@@ -363,11 +399,11 @@ namespace softcube {
             return *this;
         }
 
-        bool operator==(const Quaternion &other) const {
+        constexpr bool operator==(const Quaternion &other) const {
             return x == other.x && y == other.y && z == other.z && w == other.w;
         }
 
-        bool operator!=(const Quaternion &other) const {
+        constexpr bool operator!=(const Quaternion &other) const {
             return !(*this == other);
         }
 
@@ -387,11 +423,13 @@ namespace softcube {
         }
     };
 
-    inline Quaternion operator*(float scalar, const Quaternion &q) {
+    static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion is loaded as one SIMD register");
+
+    constexpr Quaternion operator*(float scalar, const Quaternion &q) {
         return q * scalar;
     }
 
-    inline float dot(const Quaternion &a, const Quaternion &b) {
+    constexpr float dot(const Quaternion &a, const Quaternion &b) {
         return a.dot(b);
     }
 
@@ -407,7 +445,7 @@ namespace softcube {
         return a.slerp(b, t);
     }
 
-    inline Vector3 &&Vector3::operator*(const Quaternion &rotation) const {
+    constexpr Vector3 Vector3::operator*(const Quaternion &rotation) const {
         return rotation * *this;
     }
 
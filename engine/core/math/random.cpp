@@ -0,0 +1,30 @@
+#include "random.hpp"
+
+// Reference outputs of the published generators, checked at compile time.
+namespace softcube::math {
+    namespace {
+        constexpr Pcg32 advanced(Pcg32 generator, const u64 delta) {
+            generator.advance(delta);
+            return generator;
+        }
+
+        constexpr u32 nth_output(Pcg32 generator, const u32 n) {
+            for (u32 i = 0; i < n; ++i) {
+                generator.next_u32();
+            }
+            return generator.next_u32();
+        }
+    }
+
+    static_assert(Xoshiro256::from_state({1, 2, 3, 4}).next_u64() == 41943041);
+    static_assert(Xoshiro256(7).next_u64() != Xoshiro256(8).next_u64());
+
+    static_assert(Pcg32(42, 54).next_u32() == 0xA15C02B7u);
+    static_assert(nth_output(Pcg32(42, 54), 1) == 0x7B47F409u);
+    static_assert(nth_output(Pcg32(42, 54), 2) == 0xBA1D3330u);
+    static_assert(advanced(Pcg32(42, 54), 2).next_u32() == 0xBA1D3330u);
+    static_assert(advanced(advanced(Pcg32(42, 54), 5), 0ull - 5).next_u32() == 0xA15C02B7u);
+
+    static_assert(unit_float(0) == 0.0f && unit_float(~0u) < 1.0f);
+    static_assert(rng(1, 2, 3, 4) == rng(1, 2, 3, 4) && rng(1, 2, 3, 4) != rng(2, 2, 3, 4));
+}
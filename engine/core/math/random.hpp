@@ -0,0 +1,314 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/math/hash.hpp"
+
+#include <bit>
+#include <span>
+
+namespace softcube::math {
+    /**
+     * @brief Map the top 24 bits of a random word to a float in [0, 1)
+     *
+     * Every result is a multiple of 2^-24 and the conversion is exact, so the
+     * same bits give the same float on every platform.
+     */
+    constexpr float unit_float(const u32 bits) {
+        return static_cast<float>(bits >> 8) * 0x1.0p-24f;
+    }
+
+    /**
+     * @class RandomEngine
+     * @brief Distributions and batch fills shared by the generators below
+     *
+     * Generator provides next_u32(); when it also provides next_u64(), batch
+     * fills take two 32-bit values from each 64-bit output.
+     */
+    template<typename Generator>
+    class RandomEngine {
+    public:
+        /**
+         * @brief Uniform float in [0, 1)
+         */
+        constexpr float next_float() {
+            return unit_float(self().next_u32());
+        }
+
+        /**
+         * @brief Uniform float between min and max
+         */
+        constexpr float next_float(const float min, const float max) {
+            return min + (max - min) * next_float();
+        }
+
+        /**
+         * @brief Uniform integer in [0, bound) without modulo bias; bound must not be zero
+         *
+         * Lemire's multiply-shift; the rejection loop almost never runs for
+         * bounds far below 2^32.
+         */
+        constexpr u32 next_below(const u32 bound) {
+            u64 product = static_cast<u64>(self().next_u32()) * bound;
+            u32 low = static_cast<u32>(product);
+            if (low < bound) {
+                const u32 threshold = (0u - bound) % bound;
+                while (low < threshold) {
+                    product = static_cast<u64>(self().next_u32()) * bound;
+                    low = static_cast<u32>(product);
+                }
+            }
+            return static_cast<u32>(product >> 32);
+        }
+
+        /**
+         * @brief Uniform integer in [min, max], both inclusive
+         */
+        constexpr i32 next_int(const i32 min, const i32 max) {
+            const u32 span = static_cast<u32>(max) - static_cast<u32>(min) + 1;
+            const u32 offset = span == 0 ? self().next_u32() : next_below(span);
+            return static_cast<i32>(static_cast<u32>(min) + offset);
+        }
+
+        /**
+         * @brief True with the given probability
+         */
+        constexpr bool next_bool(const float probability = 0.5f) {
+            return next_float() < probability;
+        }
+
+        void fill(const std::span<u32> out) {
+            size_t i = 0;
+            if constexpr (wide) {
+                for (; i + 1 < out.size(); i += 2) {
+                    const u64 bits = self().next_u64();
+                    out[i] = static_cast<u32>(bits >> 32);
+                    out[i + 1] = static_cast<u32>(bits);
+                }
+            }
+            for (; i < out.size(); ++i) {
+                out[i] = self().next_u32();
+            }
+        }
+
+        /**
+         * @brief Fill with uniform floats between min and max
+         */
+        void fill(const std::span<float> out, const float min = 0.0f, const float max = 1.0f) {
+            const float scale = max - min;
+            size_t i = 0;
+            if constexpr (wide) {
+                for (; i + 1 < out.size(); i += 2) {
+                    const u64 bits = self().next_u64();
+                    out[i] = min + scale * unit_float(static_cast<u32>(bits >> 32));
+                    out[i + 1] = min + scale * unit_float(static_cast<u32>(bits));
+                }
+            }
+            for (; i < out.size(); ++i) {
+                out[i] = min + scale * unit_float(self().next_u32());
+            }
+        }
+
+        /**
+         * @brief Fill with uniform integers in [min, max], both inclusive
+         */
+        void fill(const std::span<i32> out, const i32 min, const i32 max) {
+            for (i32 &value : out) {
+                value = next_int(min, max);
+            }
+        }
+
+    private:
+        static constexpr bool wide = requires(Generator &generator) { generator.next_u64(); };
+
+        constexpr Generator &self() { return static_cast<Generator &>(*this); }
+    };
+
+    /**
+     * @class Xoshiro256
+     * @brief xoshiro256++: fast 64-bit generator with a 2^256 - 1 period
+     *
+     * The default choice for gameplay and per-thread generators. jump()
+     * advances by 2^128 outputs, so generators made with stream() for
+     * different indices never overlap in practice. Satisfies
+     * UniformRandomBitGenerator, so it works with std::shuffle.
+     */
+    class Xoshiro256 : public RandomEngine<Xoshiro256> {
+    public:
+        using result_type = u64;
+
+        static constexpr u64 default_seed = 0x5EED5C0BE5EED5C0ull;
+
+        /**
+         * @brief Expand a 64-bit seed into the state with splitmix64, so similar seeds give unrelated states
+         */
+        constexpr explicit Xoshiro256(u64 seed = default_seed) : m_state{} {
+            for (u64 &word : m_state) {
+                seed += 0x9E3779B97F4A7C15ull;
+                word = mix64(seed);
+            }
+        }
+
+        /**
+         * @brief Generator with the given raw state, which must not be all zeros
+         */
+        static constexpr Xoshiro256 from_state(const std::array<u64, 4> &state) {
+            Xoshiro256 generator;
+            generator.m_state = state;
+            return generator;
+        }
+
+        /**
+         * @brief The generator for stream index of a seed; index jumps, so keep it to thread counts
+         */
+        static constexpr Xoshiro256 stream(const u64 seed, const u32 index) {
+            Xoshiro256 generator(seed);
+            for (u32 i = 0; i < index; ++i) {
+                generator.jump();
+            }
+            return generator;
+        }
+
+        constexpr u64 next_u64() {
+            const u64 result = std::rotl(m_state[0] + m_state[3], 23) + m_state[0];
+            const u64 t = m_state[1] << 17;
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= t;
+            m_state[3] = std::rotl(m_state[3], 45);
+            return result;
+        }
+
+        // The high bits are the strongest.
+        constexpr u32 next_u32() { return static_cast<u32>(next_u64() >> 32); }
+
+        /**
+         * @brief Advance by 2^128 outputs, as if next_u64() had been called that many times
+         */
+        constexpr void jump() {
+            apply_jump({0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull});
+        }
+
+        /**
+         * @brief Advance by 2^192 outputs; for splitting streams that are themselves split with jump()
+         */
+        constexpr void long_jump() {
+            apply_jump({0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull});
+        }
+
+        [[nodiscard]] constexpr const std::array<u64, 4> &get_state() const { return m_state; }
+
+        constexpr result_type operator()() { return next_u64(); }
+
+        static constexpr result_type min() { return 0; }
+
+        static constexpr result_type max() { return ~0ull; }
+
+    private:
+        constexpr void apply_jump(const std::array<u64, 4> &polynomial) {
+            std::array<u64, 4> state{};
+            for (const u64 word : polynomial) {
+                for (int bit = 0; bit < 64; ++bit) {
+                    if (word & 1ull << bit) {
+                        for (size_t i = 0; i < state.size(); ++i) {
+                            state[i] ^= m_state[i];
+                        }
+                    }
+                    next_u64();
+                }
+            }
+            m_state = state;
+        }
+
+        std::array<u64, 4> m_state;
+    };
+
+    /**
+     * @class Pcg32
+     * @brief PCG32 (XSH RR): 16 bytes of state and 2^63 selectable streams
+     *
+     * Each stream is a different sequence for the same seed, which suits
+     * per-chunk generation: Pcg32(world_seed, chunk.hash()) gives every chunk
+     * its own reproducible sequence regardless of generation order.
+     * advance() skips forward or back in logarithmic time.
+     */
+    class Pcg32 : public RandomEngine<Pcg32> {
+    public:
+        using result_type = u32;
+
+        static constexpr u64 default_seed = 0x853C49E6748FEA9Bull;
+
+        constexpr explicit Pcg32(const u64 seed = default_seed, const u64 stream = 0)
+            : m_state(0), m_increment(stream << 1 | 1) {
+            next_u32();
+            m_state += seed;
+            next_u32();
+        }
+
+        constexpr u32 next_u32() {
+            const u64 state = m_state;
+            m_state = state * multiplier + m_increment;
+            const u32 shifted = static_cast<u32>(((state >> 18) ^ state) >> 27);
+            return std::rotr(shifted, static_cast<int>(state >> 59));
+        }
+
+        /**
+         * @brief Skip delta outputs; wraps modulo 2^64, so advance(-n) steps back n
+         */
+        constexpr void advance(u64 delta) {
+            u64 step_multiplier = multiplier;
+            u64 step_increment = m_increment;
+            u64 total_multiplier = 1;
+            u64 total_increment = 0;
+            while (delta > 0) {
+                if (delta & 1) {
+                    total_multiplier *= step_multiplier;
+                    total_increment = total_increment * step_multiplier + step_increment;
+                }
+                step_increment = (step_multiplier + 1) * step_increment;
+                step_multiplier *= step_multiplier;
+                delta >>= 1;
+            }
+            m_state = total_multiplier * m_state + total_increment;
+        }
+
+        constexpr result_type operator()() { return next_u32(); }
+
+        static constexpr result_type min() { return 0; }
+
+        static constexpr result_type max() { return ~0u; }
+
+    private:
+        static constexpr u64 multiplier = 6364136223846793005ull;
+
+        u64 m_state;
+        u64 m_increment; // Odd; selects the stream
+    };
+
+    /**
+     * @brief Stateless random bits for a block position
+     *
+     * The same seed and coordinates always give the same value, independent
+     * of generation order and thread, so decisions like tree placement do not
+     * need a generator threaded through. Use a different seed per decision,
+     * e.g. hash_combine(world_seed, feature_id), to keep them uncorrelated.
+     */
+    constexpr u64 rng(const u64 seed, const i32 x, const i32 y, const i32 z) {
+        return mix64(hash_coordinates(x, y, z) ^ seed);
+    }
+
+    constexpr u64 rng(const u64 seed, const i32 x, const i32 y) {
+        return mix64(hash_coordinates(x, y) ^ seed);
+    }
+
+    /**
+     * @brief Stateless uniform float in [0, 1) for a block position
+     */
+    constexpr float rng_float(const u64 seed, const i32 x, const i32 y, const i32 z) {
+        return unit_float(static_cast<u32>(rng(seed, x, y, z) >> 32));
+    }
+
+    constexpr float rng_float(const u64 seed, const i32 x, const i32 y) {
+        return unit_float(static_cast<u32>(rng(seed, x, y) >> 32));
+    }
+}
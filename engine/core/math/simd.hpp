@@ -0,0 +1,576 @@
+#pragma once
+#include "core/common.hpp"
+
+#include <bit>
+#include <cmath>
+
+// Backend selection. SSE2 is part of x86-64, so the x86 path needs no extra
+// compiler flags; define SOFTCUBE_NO_SIMD to force the scalar fallback.
+#if defined(SOFTCUBE_NO_SIMD)
+    #define SOFTCUBE_SIMD_SCALAR
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SOFTCUBE_SIMD_SSE
+    #include <emmintrin.h>
+    #if defined(__SSE4_1__)
+        #include <smmintrin.h>
+    #endif
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__GNUC__) || defined(__clang__))
+    #define SOFTCUBE_SIMD_NEON
+    #include <arm_neon.h>
+#else
+    #define SOFTCUBE_SIMD_SCALAR
+#endif
+
+namespace softcube::simd {
+    /**
+     * @brief Four packed floats in one register
+     *
+     * Every operation works lane by lane with the same rounding as the
+     * equivalent scalar expression, so results match the scalar backend bit
+     * for bit as long as callers keep the scalar order of operations and the
+     * compiler does not fuse the scalar multiply-adds (-ffp-contract=off).
+     */
+#if defined(SOFTCUBE_SIMD_SSE)
+    using float4 = __m128;
+#elif defined(SOFTCUBE_SIMD_NEON)
+    using float4 = float32x4_t;
+#else
+    struct float4 {
+        float v[4];
+    };
+#endif
+
+    /**
+     * @brief Four packed 32-bit integers in one register
+     *
+     * Arithmetic wraps around like unsigned integers on every backend.
+     * Comparisons produce masks with all bits of a lane set or clear, for
+     * use with select and the bitwise operations.
+     */
+#if defined(SOFTCUBE_SIMD_SSE)
+    using int4 = __m128i;
+#elif defined(SOFTCUBE_SIMD_NEON)
+    using int4 = int32x4_t;
+#else
+    struct int4 {
+        u32 v[4];
+    };
+#endif
+
+    /**
+     * @brief Name of the backend compiled in, for logs and benchmark reports
+     */
+    constexpr const char *backend_name() {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return "SSE2";
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return "NEON";
+#else
+        return "Scalar";
+#endif
+    }
+
+    /**
+     * @brief Load four floats; the pointer needs no particular alignment
+     */
+    inline float4 load(const float *source) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_loadu_ps(source);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vld1q_f32(source);
+#else
+        return {source[0], source[1], source[2], source[3]};
+#endif
+    }
+
+    /**
+     * @brief Store four floats; the pointer needs no particular alignment
+     */
+    inline void store(float *destination, const float4 value) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        _mm_storeu_ps(destination, value);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        vst1q_f32(destination, value);
+#else
+        destination[0] = value.v[0];
+        destination[1] = value.v[1];
+        destination[2] = value.v[2];
+        destination[3] = value.v[3];
+#endif
+    }
+
+    inline float4 set(const float x, const float y, const float z, const float w) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_setr_ps(x, y, z, w);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return float4{x, y, z, w};
+#else
+        return {x, y, z, w};
+#endif
+    }
+
+    inline float4 splat(const float value) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_set1_ps(value);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vdupq_n_f32(value);
+#else
+        return {value, value, value, value};
+#endif
+    }
+
+    inline float4 add(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_add_ps(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vaddq_f32(a, b);
+#else
+        return {a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]};
+#endif
+    }
+
+    inline float4 sub(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_sub_ps(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vsubq_f32(a, b);
+#else
+        return {a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]};
+#endif
+    }
+
+    inline float4 mul(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_mul_ps(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vmulq_f32(a, b);
+#else
+        return {a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]};
+#endif
+    }
+
+    inline float4 div(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_div_ps(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vdivq_f32(a, b);
+#else
+        return {a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]};
+#endif
+    }
+
+    /**
+     * @brief Lane-wise minimum; returns b where the lanes compare unordered
+     */
+    inline float4 min(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_min_ps(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vbslq_f32(vcltq_f32(a, b), a, b);
+#else
+        return {
+            a.v[0] < b.v[0] ? a.v[0] : b.v[0], a.v[1] < b.v[1] ? a.v[1] : b.v[1],
+            a.v[2] < b.v[2] ? a.v[2] : b.v[2], a.v[3] < b.v[3] ? a.v[3] : b.v[3]
+        };
+#endif
+    }
+
+    /**
+     * @brief Lane-wise maximum; returns b where the lanes compare unordered
+     */
+    inline float4 max(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_max_ps(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vbslq_f32(vcgtq_f32(a, b), a, b);
+#else
+        return {
+            a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1],
+            a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3]
+        };
+#endif
+    }
+
+    /**
+     * @brief Reorder the lanes of one vector: (v[X], v[Y], v[Z], v[W])
+     */
+    template<int X, int Y, int Z, int W>
+    float4 swizzle(const float4 v) {
+        static_assert(X >= 0 && X < 4 && Y >= 0 && Y < 4 && Z >= 0 && Z < 4 && W >= 0 && W < 4);
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return __builtin_shufflevector(v, v, X, Y, Z, W);
+#else
+        return {v.v[X], v.v[Y], v.v[Z], v.v[W]};
+#endif
+    }
+
+    /**
+     * @brief Combine two vectors: (a[X], a[Y], b[Z], b[W])
+     */
+    template<int X, int Y, int Z, int W>
+    float4 shuffle(const float4 a, const float4 b) {
+        static_assert(X >= 0 && X < 4 && Y >= 0 && Y < 4 && Z >= 0 && Z < 4 && W >= 0 && W < 4);
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return __builtin_shufflevector(a, b, X, Y, Z + 4, W + 4);
+#else
+        return {a.v[X], a.v[Y], b.v[Z], b.v[W]};
+#endif
+    }
+
+    /**
+     * @brief Copy one lane to all four
+     */
+    template<int Lane>
+    float4 broadcast(const float4 v) {
+        return swizzle<Lane, Lane, Lane, Lane>(v);
+    }
+
+    inline float get_x(const float4 v) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_cvtss_f32(v);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vgetq_lane_f32(v, 0);
+#else
+        return v.v[0];
+#endif
+    }
+
+    /**
+     * @brief Sum of all four lanes, broadcast to every lane: (x + y) + (z + w)
+     */
+    inline float4 horizontal_sum(const float4 v) {
+        const float4 pairs = add(v, swizzle<1, 0, 3, 2>(v));
+        return add(pairs, swizzle<2, 3, 0, 1>(pairs));
+    }
+
+    /**
+     * @brief 3D cross product of the xyz lanes; w of the result is zero for finite inputs
+     */
+    inline float4 cross3(const float4 a, const float4 b) {
+        return sub(
+            mul(swizzle<1, 2, 0, 3>(a), swizzle<2, 0, 1, 3>(b)),
+            mul(swizzle<2, 0, 1, 3>(a), swizzle<1, 2, 0, 3>(b))
+        );
+    }
+
+    inline float4 sqrt(const float4 v) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_sqrt_ps(v);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vsqrtq_f32(v);
+#else
+        return {std::sqrt(v.v[0]), std::sqrt(v.v[1]), std::sqrt(v.v[2]), std::sqrt(v.v[3])};
+#endif
+    }
+
+    /**
+     * @brief Approximate 1 / sqrt(v), good to about 12 bits
+     *
+     * The hardware estimate differs between CPU vendors, so unlike the rest
+     * of this header the result is not reproducible across machines. The
+     * NEON and scalar backends refine a coarser estimate with one Newton step.
+     */
+    inline float4 rsqrt_estimate(const float4 v) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_rsqrt_ps(v);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        const float32x4_t estimate = vrsqrteq_f32(v);
+        return vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(v, estimate), estimate));
+#else
+        float4 result;
+        for (int i = 0; i < 4; ++i) {
+            const float estimate = std::bit_cast<float>(0x5F375A86u - (std::bit_cast<u32>(v.v[i]) >> 1));
+            result.v[i] = estimate * (1.5f - 0.5f * v.v[i] * estimate * estimate);
+        }
+        return result;
+#endif
+    }
+
+    inline int4 splat(const i32 value) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_set1_epi32(value);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vdupq_n_s32(value);
+#else
+        const auto bits = static_cast<u32>(value);
+        return {bits, bits, bits, bits};
+#endif
+    }
+
+    inline int4 add(const int4 a, const int4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_add_epi32(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vaddq_s32(a, b);
+#else
+        return {a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]};
+#endif
+    }
+
+    inline int4 sub(const int4 a, const int4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_sub_epi32(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vsubq_s32(a, b);
+#else
+        return {a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]};
+#endif
+    }
+
+    /**
+     * @brief Low 32 bits of each lane's product
+     */
+    inline int4 mul(const int4 a, const int4 b) {
+#if defined(SOFTCUBE_SIMD_SSE) && defined(__SSE4_1__)
+        return _mm_mullo_epi32(a, b);
+#elif defined(SOFTCUBE_SIMD_SSE)
+        // SSE2 only multiplies lanes 0 and 2 into 64-bit results; do the odd lanes
+        // separately and interleave the low halves.
+        const __m128i even = _mm_mul_epu32(a, b);
+        const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vmulq_s32(a, b);
+#else
+        return {a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]};
+#endif
+    }
+
+    inline int4 bit_and(const int4 a, const int4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_and_si128(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vandq_s32(a, b);
+#else
+        return {a.v[0] & b.v[0], a.v[1] & b.v[1], a.v[2] & b.v[2], a.v[3] & b.v[3]};
+#endif
+    }
+
+    inline int4 bit_or(const int4 a, const int4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_or_si128(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vorrq_s32(a, b);
+#else
+        return {a.v[0] | b.v[0], a.v[1] | b.v[1], a.v[2] | b.v[2], a.v[3] | b.v[3]};
+#endif
+    }
+
+    inline int4 bit_xor(const int4 a, const int4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_xor_si128(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return veorq_s32(a, b);
+#else
+        return {a.v[0] ^ b.v[0], a.v[1] ^ b.v[1], a.v[2] ^ b.v[2], a.v[3] ^ b.v[3]};
+#endif
+    }
+
+    template<int Bits>
+    int4 shift_left(const int4 v) {
+        static_assert(Bits >= 0 && Bits < 32);
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_slli_epi32(v, Bits);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vshlq_n_s32(v, Bits);
+#else
+        return {v.v[0] << Bits, v.v[1] << Bits, v.v[2] << Bits, v.v[3] << Bits};
+#endif
+    }
+
+    /**
+     * @brief Shift right filling with zeros
+     */
+    template<int Bits>
+    int4 shift_right(const int4 v) {
+        static_assert(Bits > 0 && Bits < 32);
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_srli_epi32(v, Bits);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), Bits));
+#else
+        return {v.v[0] >> Bits, v.v[1] >> Bits, v.v[2] >> Bits, v.v[3] >> Bits};
+#endif
+    }
+
+    /**
+     * @brief Lane mask of a == b
+     */
+    inline int4 equal(const int4 a, const int4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_cmpeq_epi32(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vreinterpretq_s32_u32(vceqq_s32(a, b));
+#else
+        return {
+            a.v[0] == b.v[0] ? ~0u : 0u, a.v[1] == b.v[1] ? ~0u : 0u,
+            a.v[2] == b.v[2] ? ~0u : 0u, a.v[3] == b.v[3] ? ~0u : 0u
+        };
+#endif
+    }
+
+    /**
+     * @brief Reinterpret the bits of four floats as integers
+     */
+    inline int4 as_int4(const float4 v) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_castps_si128(v);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vreinterpretq_s32_f32(v);
+#else
+        return std::bit_cast<int4>(v);
+#endif
+    }
+
+    /**
+     * @brief Reinterpret the bits of four integers as floats
+     */
+    inline float4 as_float4(const int4 v) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_castsi128_ps(v);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vreinterpretq_f32_s32(v);
+#else
+        return std::bit_cast<float4>(v);
+#endif
+    }
+
+    /**
+     * @brief Lane mask of a < b, as float bits
+     */
+    inline float4 less(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_cmplt_ps(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vreinterpretq_f32_u32(vcltq_f32(a, b));
+#else
+        return as_float4({
+            a.v[0] < b.v[0] ? ~0u : 0u, a.v[1] < b.v[1] ? ~0u : 0u,
+            a.v[2] < b.v[2] ? ~0u : 0u, a.v[3] < b.v[3] ? ~0u : 0u
+        });
+#endif
+    }
+
+    /**
+     * @brief Lane mask of a <= b, as float bits
+     */
+    inline float4 less_equal(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_cmple_ps(a, b);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vreinterpretq_f32_u32(vcleq_f32(a, b));
+#else
+        return as_float4({
+            a.v[0] <= b.v[0] ? ~0u : 0u, a.v[1] <= b.v[1] ? ~0u : 0u,
+            a.v[2] <= b.v[2] ? ~0u : 0u, a.v[3] <= b.v[3] ? ~0u : 0u
+        });
+#endif
+    }
+
+    inline float4 bit_and(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_and_ps(a, b);
+#else
+        return as_float4(bit_and(as_int4(a), as_int4(b)));
+#endif
+    }
+
+    inline float4 bit_xor(const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_xor_ps(a, b);
+#else
+        return as_float4(bit_xor(as_int4(a), as_int4(b)));
+#endif
+    }
+
+    /**
+     * @brief Pick a where the mask lane is set and b where it is clear
+     */
+    inline float4 select(const float4 mask, const float4 a, const float4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+#else
+        return as_float4(bit_or(bit_and(as_int4(mask), as_int4(a)), bit_and(bit_xor(as_int4(mask), splat(-1)),
+                                                                                 as_int4(b))));
+#endif
+    }
+
+    inline int4 select(const int4 mask, const int4 a, const int4 b) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vbslq_s32(vreinterpretq_u32_s32(mask), a, b);
+#else
+        return bit_or(bit_and(mask, a), bit_and(bit_xor(mask, splat(-1)), b));
+#endif
+    }
+
+    /**
+     * @brief Convert to integers rounding toward zero; lanes must be within the i32 range
+     */
+    inline int4 to_int4(const float4 v) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_cvttps_epi32(v);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vcvtq_s32_f32(v);
+#else
+        return {
+            static_cast<u32>(static_cast<i32>(v.v[0])), static_cast<u32>(static_cast<i32>(v.v[1])),
+            static_cast<u32>(static_cast<i32>(v.v[2])), static_cast<u32>(static_cast<i32>(v.v[3]))
+        };
+#endif
+    }
+
+    inline float4 to_float4(const int4 v) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        return _mm_cvtepi32_ps(v);
+#elif defined(SOFTCUBE_SIMD_NEON)
+        return vcvtq_f32_s32(v);
+#else
+        return {
+            static_cast<float>(static_cast<i32>(v.v[0])), static_cast<float>(static_cast<i32>(v.v[1])),
+            static_cast<float>(static_cast<i32>(v.v[2])), static_cast<float>(static_cast<i32>(v.v[3]))
+        };
+#endif
+    }
+
+    /**
+     * @brief Round toward negative infinity; lanes must be within the i32 range
+     *
+     * Truncates and steps down where that rounded up, which needs nothing
+     * beyond SSE2 and gives the same bits on every backend.
+     */
+    inline float4 floor(const float4 v) {
+        const float4 truncated = to_float4(to_int4(v));
+        return sub(truncated, bit_and(less(v, truncated), splat(1.0f)));
+    }
+
+    inline float4 abs(const float4 v) {
+        return bit_and(v, as_float4(splat(0x7FFFFFFF)));
+    }
+
+    /**
+     * @brief Transpose four rows in place
+     */
+    inline void transpose(float4 &row0, float4 &row1, float4 &row2, float4 &row3) {
+#if defined(SOFTCUBE_SIMD_SSE)
+        _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+#else
+        const float4 t0 = shuffle<0, 1, 0, 1>(row0, row1); // 00 01 10 11
+        const float4 t1 = shuffle<2, 3, 2, 3>(row0, row1); // 02 03 12 13
+        const float4 t2 = shuffle<0, 1, 0, 1>(row2, row3); // 20 21 30 31
+        const float4 t3 = shuffle<2, 3, 2, 3>(row2, row3); // 22 23 32 33
+        row0 = shuffle<0, 2, 0, 2>(t0, t2);
+        row1 = shuffle<1, 3, 1, 3>(t0, t2);
+        row2 = shuffle<0, 2, 0, 2>(t1, t3);
+        row3 = shuffle<1, 3, 1, 3>(t1, t3);
+#endif
+    }
+}
@@ -0,0 +1,211 @@
+#include "stream.hpp"
+#include "simd.hpp"
+
+namespace softcube::math {
+    namespace {
+        using simd::float4;
+
+        constexpr size_t lane_count = 4;
+
+        // The last block of a stream may hold fewer than four elements; those
+        // go through a zero-padded copy so every block runs the same code.
+        float4 load_lanes(const float *source, const size_t count) {
+            if (count == lane_count) {
+                return simd::load(source);
+            }
+
+            float lanes[lane_count]{};
+            std::copy_n(source, count, lanes);
+            return simd::load(lanes);
+        }
+
+        void store_lanes(float *destination, const float4 value, const size_t count) {
+            if (count == lane_count) {
+                simd::store(destination, value);
+                return;
+            }
+
+            float lanes[lane_count];
+            simd::store(lanes, value);
+            std::copy_n(lanes, count, destination);
+        }
+
+        /**
+         * @brief Matrix elements broadcast to all lanes, for streams sharing one matrix
+         */
+        struct SplatMatrix {
+            float4 m[3][4];
+
+            explicit SplatMatrix(const Matrix4 &matrix) {
+                for (int row = 0; row < 3; ++row) {
+                    for (int column = 0; column < 4; ++column) {
+                        m[row][column] = simd::splat(matrix.m[row][column]);
+                    }
+                }
+            }
+        };
+
+        float4 dot3(const float4 *row, const float4 x, const float4 y, const float4 z) {
+            return simd::add(simd::add(simd::mul(row[0], x), simd::mul(row[1], y)), simd::mul(row[2], z));
+        }
+    }
+
+    void transform_points(const Matrix4 &matrix, const ConstVector3Stream points, const Vector3Stream out) {
+        SOFTCUBE_ASSERT(out.size() == points.size(), "Output stream size must match the input");
+
+        const SplatMatrix m(matrix);
+        for (size_t i = 0; i < points.size(); i += lane_count) {
+            const size_t count = std::min(lane_count, points.size() - i);
+            const float4 x = load_lanes(&points.x[i], count);
+            const float4 y = load_lanes(&points.y[i], count);
+            const float4 z = load_lanes(&points.z[i], count);
+
+            store_lanes(&out.x[i], simd::add(dot3(m.m[0], x, y, z), m.m[0][3]), count);
+            store_lanes(&out.y[i], simd::add(dot3(m.m[1], x, y, z), m.m[1][3]), count);
+            store_lanes(&out.z[i], simd::add(dot3(m.m[2], x, y, z), m.m[2][3]), count);
+        }
+    }
+
+    void transform_directions(const Matrix4 &matrix, const ConstVector3Stream directions, const Vector3Stream out) {
+        SOFTCUBE_ASSERT(out.size() == directions.size(), "Output stream size must match the input");
+
+        const SplatMatrix m(matrix);
+        for (size_t i = 0; i < directions.size(); i += lane_count) {
+            const size_t count = std::min(lane_count, directions.size() - i);
+            const float4 x = load_lanes(&directions.x[i], count);
+            const float4 y = load_lanes(&directions.y[i], count);
+            const float4 z = load_lanes(&directions.z[i], count);
+
+            store_lanes(&out.x[i], dot3(m.m[0], x, y, z), count);
+            store_lanes(&out.y[i], dot3(m.m[1], x, y, z), count);
+            store_lanes(&out.z[i], dot3(m.m[2], x, y, z), count);
+        }
+    }
+
+    void transform_aabbs(const std::span<const Matrix4> matrices, const ConstVector3Stream local_min,
+                         const ConstVector3Stream local_max, const Vector3Stream world_min,
+                         const Vector3Stream world_max) {
+        SOFTCUBE_ASSERT(local_min.size() == matrices.size() && local_max.size() == matrices.size() &&
+                        world_min.size() == matrices.size() && world_max.size() == matrices.size(),
+                        "Box streams must have one entry per matrix");
+
+        static const Matrix4 padding = Matrix4::identity();
+
+        for (size_t i = 0; i < matrices.size(); i += lane_count) {
+            const size_t count = std::min(lane_count, matrices.size() - i);
+            const Matrix4 *box[lane_count];
+            for (size_t lane = 0; lane < lane_count; ++lane) {
+                box[lane] = lane < count ? &matrices[i + lane] : &padding;
+            }
+
+            const float4 min[3] = {
+                load_lanes(&local_min.x[i], count),
+                load_lanes(&local_min.y[i], count),
+                load_lanes(&local_min.z[i], count)
+            };
+            const float4 max[3] = {
+                load_lanes(&local_max.x[i], count),
+                load_lanes(&local_max.y[i], count),
+                load_lanes(&local_max.z[i], count)
+            };
+
+            float4 out_min[3];
+            float4 out_max[3];
+            for (int row = 0; row < 3; ++row) {
+                // Transposing the same row of four matrices gives each element across the boxes.
+                float4 m[4] = {
+                    simd::load(box[0]->m[row]),
+                    simd::load(box[1]->m[row]),
+                    simd::load(box[2]->m[row]),
+                    simd::load(box[3]->m[row])
+                };
+                simd::transpose(m[0], m[1], m[2], m[3]);
+
+                out_min[row] = m[3];
+                out_max[row] = m[3];
+                for (int axis = 0; axis < 3; ++axis) {
+                    const float4 a = simd::mul(m[axis], min[axis]);
+                    const float4 b = simd::mul(m[axis], max[axis]);
+                    out_min[row] = simd::add(out_min[row], simd::min(a, b));
+                    out_max[row] = simd::add(out_max[row], simd::max(a, b));
+                }
+            }
+
+            store_lanes(&world_min.x[i], out_min[0], count);
+            store_lanes(&world_min.y[i], out_min[1], count);
+            store_lanes(&world_min.z[i], out_min[2], count);
+            store_lanes(&world_max.x[i], out_max[0], count);
+            store_lanes(&world_max.y[i], out_max[1], count);
+            store_lanes(&world_max.z[i], out_max[2], count);
+        }
+    }
+
+    void compose_trs(const ConstVector3Stream positions, const ConstQuaternionStream rotations,
+                     const ConstVector3Stream scales, const std::span<Matrix4> out) {
+        SOFTCUBE_ASSERT(rotations.size() == positions.size() && scales.size() == positions.size() &&
+                        out.size() == positions.size(), "Input streams and output must have the same size");
+
+        const float4 one = simd::splat(1.0f);
+        const float4 two = simd::splat(2.0f);
+        const float4 last_row = simd::set(0.0f, 0.0f, 0.0f, 1.0f);
+
+        for (size_t i = 0; i < positions.size(); i += lane_count) {
+            const size_t count = std::min(lane_count, positions.size() - i);
+            const float4 x = load_lanes(&rotations.x[i], count);
+            const float4 y = load_lanes(&rotations.y[i], count);
+            const float4 z = load_lanes(&rotations.z[i], count);
+            const float4 w = load_lanes(&rotations.w[i], count);
+            const float4 sx = load_lanes(&scales.x[i], count);
+            const float4 sy = load_lanes(&scales.y[i], count);
+            const float4 sz = load_lanes(&scales.z[i], count);
+
+            // Quaternion::to_rotation_matrix, four rotations at a time.
+            const float4 xx = simd::mul(x, x);
+            const float4 xy = simd::mul(x, y);
+            const float4 xz = simd::mul(x, z);
+            const float4 xw = simd::mul(x, w);
+            const float4 yy = simd::mul(y, y);
+            const float4 yz = simd::mul(y, z);
+            const float4 yw = simd::mul(y, w);
+            const float4 zz = simd::mul(z, z);
+            const float4 zw = simd::mul(z, w);
+
+            float4 rows[3][4] = {
+                {
+                    simd::sub(one, simd::mul(two, simd::add(yy, zz))),
+                    simd::mul(two, simd::sub(xy, zw)),
+                    simd::mul(two, simd::add(xz, yw)),
+                    load_lanes(&positions.x[i], count)
+                },
+                {
+                    simd::mul(two, simd::add(xy, zw)),
+                    simd::sub(one, simd::mul(two, simd::add(xx, zz))),
+                    simd::mul(two, simd::sub(yz, xw)),
+                    load_lanes(&positions.y[i], count)
+                },
+                {
+                    simd::mul(two, simd::sub(xz, yw)),
+                    simd::mul(two, simd::add(yz, xw)),
+                    simd::sub(one, simd::mul(two, simd::add(xx, yy))),
+                    load_lanes(&positions.z[i], count)
+                }
+            };
+
+            for (auto &row: rows) {
+                row[0] = simd::mul(row[0], sx);
+                row[1] = simd::mul(row[1], sy);
+                row[2] = simd::mul(row[2], sz);
+                simd::transpose(row[0], row[1], row[2], row[3]);
+            }
+
+            // After the transposes rows[r][lane] is row r of that lane's matrix.
+            for (size_t lane = 0; lane < count; ++lane) {
+                auto &matrix = out[i + lane];
+                simd::store(matrix.m[0], rows[0][lane]);
+                simd::store(matrix.m[1], rows[1][lane]);
+                simd::store(matrix.m[2], rows[2][lane]);
+                simd::store(matrix.m[3], last_row);
+            }
+        }
+    }
+}
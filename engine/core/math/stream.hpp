@@ -0,0 +1,218 @@
+#pragma once
+#include "core/common.hpp"
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include "matrix.hpp"
+
+#include <span>
+
+namespace softcube {
+    /**
+     * @struct BasicVector3Stream
+     * @brief Structure-of-arrays view of Vector3 values: one span per component
+     *
+     * All spans must have the same size.
+     */
+    template<typename Float>
+    struct BasicVector3Stream {
+        std::span<Float> x;
+        std::span<Float> y;
+        std::span<Float> z;
+
+        BasicVector3Stream() = default;
+
+        BasicVector3Stream(const std::span<Float> x, const std::span<Float> y, const std::span<Float> z)
+            : x(x), y(y), z(z) {
+        }
+
+        template<typename Other> requires std::is_convertible_v<Other (*)[], Float (*)[]>
+        BasicVector3Stream(const BasicVector3Stream<Other> &other) // NOLINT(*-explicit-constructor)
+            : x(other.x), y(other.y), z(other.z) {
+        }
+
+        [[nodiscard]] size_t size() const { return x.size(); }
+
+        [[nodiscard]] Vector3 get(const size_t index) const {
+            return Vector3(x[index], y[index], z[index]);
+        }
+
+        void set(const size_t index, const Vector3 &value) const requires (!std::is_const_v<Float>) {
+            x[index] = value.x;
+            y[index] = value.y;
+            z[index] = value.z;
+        }
+    };
+
+    using Vector3Stream = BasicVector3Stream<float>;
+    using ConstVector3Stream = BasicVector3Stream<const float>;
+
+    /**
+     * @struct BasicQuaternionStream
+     * @brief Structure-of-arrays view of Quaternion values: one span per component
+     *
+     * All spans must have the same size.
+     */
+    template<typename Float>
+    struct BasicQuaternionStream {
+        std::span<Float> x;
+        std::span<Float> y;
+        std::span<Float> z;
+        std::span<Float> w;
+
+        BasicQuaternionStream() = default;
+
+        BasicQuaternionStream(const std::span<Float> x, const std::span<Float> y, const std::span<Float> z,
+                              const std::span<Float> w)
+            : x(x), y(y), z(z), w(w) {
+        }
+
+        template<typename Other> requires std::is_convertible_v<Other (*)[], Float (*)[]>
+        BasicQuaternionStream(const BasicQuaternionStream<Other> &other) // NOLINT(*-explicit-constructor)
+            : x(other.x), y(other.y), z(other.z), w(other.w) {
+        }
+
+        [[nodiscard]] size_t size() const { return x.size(); }
+
+        [[nodiscard]] Quaternion get(const size_t index) const {
+            return Quaternion(x[index], y[index], z[index], w[index]);
+        }
+
+        void set(const size_t index, const Quaternion &value) const requires (!std::is_const_v<Float>) {
+            x[index] = value.x;
+            y[index] = value.y;
+            z[index] = value.z;
+            w[index] = value.w;
+        }
+    };
+
+    using QuaternionStream = BasicQuaternionStream<float>;
+    using ConstQuaternionStream = BasicQuaternionStream<const float>;
+
+    /**
+     * @struct Vector3Array
+     * @brief Owning structure-of-arrays storage for Vector3 values
+     *
+     * Meant as reusable scratch: resize keeps the capacity, so gathering into
+     * the same array every frame stops allocating once it has grown.
+     */
+    struct Vector3Array {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        void resize(const size_t size) {
+            x.resize(size);
+            y.resize(size);
+            z.resize(size);
+        }
+
+        [[nodiscard]] size_t size() const { return x.size(); }
+
+        void set(const size_t index, const Vector3 &value) {
+            x[index] = value.x;
+            y[index] = value.y;
+            z[index] = value.z;
+        }
+
+        [[nodiscard]] Vector3 get(const size_t index) const {
+            return Vector3(x[index], y[index], z[index]);
+        }
+
+        operator Vector3Stream() { return {x, y, z}; } // NOLINT(*-explicit-constructor)
+
+        operator ConstVector3Stream() const { return {x, y, z}; } // NOLINT(*-explicit-constructor)
+    };
+
+    /**
+     * @struct QuaternionArray
+     * @brief Owning structure-of-arrays storage for Quaternion values
+     */
+    struct QuaternionArray {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<float> w;
+
+        void resize(const size_t size) {
+            x.resize(size);
+            y.resize(size);
+            z.resize(size);
+            w.resize(size);
+        }
+
+        [[nodiscard]] size_t size() const { return x.size(); }
+
+        void set(const size_t index, const Quaternion &value) {
+            x[index] = value.x;
+            y[index] = value.y;
+            z[index] = value.z;
+            w[index] = value.w;
+        }
+
+        [[nodiscard]] Quaternion get(const size_t index) const {
+            return Quaternion(x[index], y[index], z[index], w[index]);
+        }
+
+        operator QuaternionStream() { return {x, y, z, w}; } // NOLINT(*-explicit-constructor)
+
+        operator ConstQuaternionStream() const { return {x, y, z, w}; } // NOLINT(*-explicit-constructor)
+    };
+
+    namespace math {
+        /**
+         * @brief Transform points by an affine matrix, four at a time
+         *
+         * Gives the same result as Matrix4::transform_point for matrices whose
+         * bottom row is (0, 0, 0, 1); the projective row is not applied.
+         * Output may alias the input.
+         *
+         * @param matrix Affine transform
+         * @param points Points to transform
+         * @param out Transformed points; same size as points
+         */
+        void transform_points(const Matrix4 &matrix, ConstVector3Stream points, Vector3Stream out);
+
+        /**
+         * @brief Transform directions by the upper 3x3 of a matrix, four at a time
+         *
+         * Same result as Matrix4::transform_vector(Vector3); the output is not
+         * normalized. Output may alias the input.
+         *
+         * @param matrix Transform
+         * @param directions Directions to transform
+         * @param out Transformed directions; same size as directions
+         */
+        void transform_directions(const Matrix4 &matrix, ConstVector3Stream directions, Vector3Stream out);
+
+        /**
+         * @brief Transform boxes by one affine matrix each with Arvo's method
+         *
+         * Each output row starts at the translation and adds the smaller and
+         * larger of the matrix element times the box's min and max on every
+         * axis, which bounds all eight corners without transforming them. Same
+         * result as AABB::transform.
+         *
+         * @param matrices Affine transform of each box
+         * @param local_min Minimum corner of each box
+         * @param local_max Maximum corner of each box
+         * @param world_min Minimum corner of each transformed box
+         * @param world_max Maximum corner of each transformed box
+         */
+        void transform_aabbs(std::span<const Matrix4> matrices, ConstVector3Stream local_min,
+                             ConstVector3Stream local_max, Vector3Stream world_min, Vector3Stream world_max);
+
+        /**
+         * @brief Build translation * rotation * scale matrices, four at a time
+         *
+         * Same result as Matrix4::translation(p) * Matrix4(r.to_rotation_matrix()) * Matrix4::scale(s)
+         * without the two general matrix products.
+         *
+         * @param positions Translation of each matrix
+         * @param rotations Rotation of each matrix; expected to be normalized
+         * @param scales Scale of each matrix
+         * @param out Composed matrices; same size as the inputs
+         */
+        void compose_trs(ConstVector3Stream positions, ConstQuaternionStream rotations, ConstVector3Stream scales,
+                         std::span<Matrix4> out);
+    }
+}
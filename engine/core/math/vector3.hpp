@@ -18,20 +18,20 @@ namespace softcube {
 
         Vector3() = default;
 
-        Vector3(float x, float y, float z) : x(x), y(y), z(z) {
+        constexpr Vector3(float x, float y, float z) : x(x), y(y), z(z) {
         }
 
-        explicit Vector3(float value) : x(value), y(value), z(value) {
+        explicit constexpr Vector3(float value) : x(value), y(value), z(value) {
         }
 
-        Vector3(const Vector2 &v, float z) : x(v.x), y(v.y), z(z) {
+        constexpr Vector3(const Vector2 &v, float z) : x(v.x), y(v.y), z(z) {
         }
 
         Vector3(const Vector3 &) = default;
 
         Vector3 &operator=(const Vector3 &) = default;
 
-        Vector3 &&operator*(const Quaternion &rotation) const;
+        constexpr Vector3 operator*(const Quaternion &rotation) const;
 
         Vector3(Vector3 &&) = default;
 
@@ -42,97 +42,97 @@ namespace softcube {
 
         operator bx::Vec3() const { return {x, y, z}; }
 
-        static Vector3 zero() { return Vector3(0.0f, 0.0f, 0.0f); }
-        static Vector3 one() { return Vector3(1.0f, 1.0f, 1.0f); }
-        static Vector3 unit_x() { return Vector3(1.0f, 0.0f, 0.0f); }
-        static Vector3 unit_y() { return Vector3(0.0f, 1.0f, 0.0f); }
-        static Vector3 unit_z() { return Vector3(0.0f, 0.0f, 1.0f); }
-        static Vector3 forward() { return Vector3(0.0f, 0.0f, 1.0f); }
-        static Vector3 back() { return Vector3(0.0f, 0.0f, -1.0f); }
-        static Vector3 up() { return Vector3(0.0f, 1.0f, 0.0f); }
-        static Vector3 down() { return Vector3(0.0f, -1.0f, 0.0f); }
-        static Vector3 right() { return Vector3(1.0f, 0.0f, 0.0f); }
-        static Vector3 left() { return Vector3(-1.0f, 0.0f, 0.0f); }
-
-        Vector2 xy() const { return Vector2(x, y); }
-        Vector2 xz() const { return Vector2(x, z); }
-        Vector2 yz() const { return Vector2(y, z); }
-
-        Vector3 operator+(const Vector3 &other) const {
+        static constexpr Vector3 zero() { return Vector3(0.0f, 0.0f, 0.0f); }
+        static constexpr Vector3 one() { return Vector3(1.0f, 1.0f, 1.0f); }
+        static constexpr Vector3 unit_x() { return Vector3(1.0f, 0.0f, 0.0f); }
+        static constexpr Vector3 unit_y() { return Vector3(0.0f, 1.0f, 0.0f); }
+        static constexpr Vector3 unit_z() { return Vector3(0.0f, 0.0f, 1.0f); }
+        static constexpr Vector3 forward() { return Vector3(0.0f, 0.0f, 1.0f); }
+        static constexpr Vector3 back() { return Vector3(0.0f, 0.0f, -1.0f); }
+        static constexpr Vector3 up() { return Vector3(0.0f, 1.0f, 0.0f); }
+        static constexpr Vector3 down() { return Vector3(0.0f, -1.0f, 0.0f); }
+        static constexpr Vector3 right() { return Vector3(1.0f, 0.0f, 0.0f); }
+        static constexpr Vector3 left() { return Vector3(-1.0f, 0.0f, 0.0f); }
+
+        constexpr Vector2 xy() const { return Vector2(x, y); }
+        constexpr Vector2 xz() const { return Vector2(x, z); }
+        constexpr Vector2 yz() const { return Vector2(y, z); }
+
+        constexpr Vector3 operator+(const Vector3 &other) const {
             return Vector3(x + other.x, y + other.y, z + other.z);
         }
 
-        Vector3 operator-(const Vector3 &other) const {
+        constexpr Vector3 operator-(const Vector3 &other) const {
             return Vector3(x - other.x, y - other.y, z - other.z);
         }
 
-        Vector3 operator*(float scalar) const {
+        constexpr Vector3 operator*(float scalar) const {
             return Vector3(x * scalar, y * scalar, z * scalar);
         }
 
-        Vector3 operator/(float scalar) const {
+        constexpr Vector3 operator/(float scalar) const {
             return Vector3(x / scalar, y / scalar, z / scalar);
         }
 
-        Vector3 operator*(const Vector3 &other) const {
+        constexpr Vector3 operator*(const Vector3 &other) const {
             return Vector3(x * other.x, y * other.y, z * other.z);
         }
 
-        Vector3 operator/(const Vector3 &other) const {
+        constexpr Vector3 operator/(const Vector3 &other) const {
             return Vector3(x / other.x, y / other.y, z / other.z);
         }
 
-        Vector3 operator-() const {
+        constexpr Vector3 operator-() const {
             return Vector3(-x, -y, -z);
         }
 
-        Vector3 &operator+=(const Vector3 &other) {
+        constexpr Vector3 &operator+=(const Vector3 &other) {
             x += other.x;
             y += other.y;
             z += other.z;
             return *this;
         }
 
-        Vector3 &operator-=(const Vector3 &other) {
+        constexpr Vector3 &operator-=(const Vector3 &other) {
             x -= other.x;
             y -= other.y;
             z -= other.z;
             return *this;
         }
 
-        Vector3 &operator*=(float scalar) {
+        constexpr Vector3 &operator*=(float scalar) {
             x *= scalar;
             y *= scalar;
             z *= scalar;
             return *this;
         }
 
-        Vector3 &operator/=(float scalar) {
+        constexpr Vector3 &operator/=(float scalar) {
             x /= scalar;
             y /= scalar;
             z /= scalar;
             return *this;
         }
 
-        Vector3 &operator*=(const Vector3 &other) {
+        constexpr Vector3 &operator*=(const Vector3 &other) {
             x *= other.x;
             y *= other.y;
             z *= other.z;
             return *this;
         }
 
-        Vector3 &operator/=(const Vector3 &other) {
+        constexpr Vector3 &operator/=(const Vector3 &other) {
             x /= other.x;
             y /= other.y;
             z /= other.z;
             return *this;
         }
 
-        bool operator==(const Vector3 &other) const {
+        constexpr bool operator==(const Vector3 &other) const {
             return x == other.x && y == other.y && z == other.z;
         }
 
-        bool operator!=(const Vector3 &other) const {
+        constexpr bool operator!=(const Vector3 &other) const {
             return !(*this == other);
         }
 
@@ -140,7 +140,7 @@ namespace softcube {
             return std::sqrt(x * x + y * y + z * z);
         }
 
-        float length_squared() const {
+        constexpr float length_squared() const {
             return x * x + y * y + z * z;
         }
 
@@ -161,11 +161,11 @@ namespace softcube {
             }
         }
 
-        float dot(const Vector3 &other) const {
+        constexpr float dot(const Vector3 &other) const {
             return x * other.x + y * other.y + z * other.z;
         }
 
-        Vector3 cross(const Vector3 &other) const {
+        constexpr Vector3 cross(const Vector3 &other) const {
             return Vector3(
                 y * other.z - z * other.y,
                 z * other.x - x * other.z,
@@ -177,11 +177,11 @@ namespace softcube {
             return (*this - other).length();
         }
 
-        float distance_squared(const Vector3 &other) const {
+        constexpr float distance_squared(const Vector3 &other) const {
             return (*this - other).length_squared();
         }
 
-        Vector3 lerp(const Vector3 &other, float t) const {
+        constexpr Vector3 lerp(const Vector3 &other, float t) const {
             return Vector3(
                 x + (other.x - x) * t,
                 y + (other.y - y) * t,
@@ -189,15 +189,15 @@ namespace softcube {
             );
         }
 
-        Vector3 reflect(const Vector3 &normal) const {
+        constexpr Vector3 reflect(const Vector3 &normal) const {
             return *this - normal * (2.0f * dot(normal));
         }
 
-        Vector3 project(const Vector3 &normal) const {
+        constexpr Vector3 project(const Vector3 &normal) const {
             return normal * (dot(normal) / normal.length_squared());
         }
 
-        Vector3 project_onto_plane(const Vector3 &normal) const {
+        constexpr Vector3 project_onto_plane(const Vector3 &normal) const {
             return *this - project(normal);
         }
 
@@ -207,22 +207,22 @@ namespace softcube {
             return std::acos(cos_angle);
         }
 
-        bool is_zero() const {
+        constexpr bool is_zero() const {
             return x == 0.0f && y == 0.0f && z == 0.0f;
         }
 
         Vector3 rotate_around_axis(const Vector3 &axis, float angle) const;
     };
 
-    inline Vector3 operator*(float scalar, const Vector3 &vec) {
+    constexpr Vector3 operator*(float scalar, const Vector3 &vec) {
         return vec * scalar;
     }
 
-    inline float dot(const Vector3 &a, const Vector3 &b) {
+    constexpr float dot(const Vector3 &a, const Vector3 &b) {
         return a.dot(b);
     }
 
-    inline Vector3 cross(const Vector3 &a, const Vector3 &b) {
+    constexpr Vector3 cross(const Vector3 &a, const Vector3 &b) {
         return a.cross(b);
     }
 
@@ -230,15 +230,15 @@ namespace softcube {
         return v.normalized();
     }
 
-    inline Vector3 lerp(const Vector3 &a, const Vector3 &b, float t) {
+    constexpr Vector3 lerp(const Vector3 &a, const Vector3 &b, float t) {
         return a.lerp(b, t);
     }
 
-    inline Vector3 reflect(const Vector3 &vec, const Vector3 &normal) {
+    constexpr Vector3 reflect(const Vector3 &vec, const Vector3 &normal) {
         return vec.reflect(normal);
     }
 
-    inline Vector3 project(const Vector3 &vec, const Vector3 &onto) {
+    constexpr Vector3 project(const Vector3 &vec, const Vector3 &onto) {
         return vec.project(onto);
     }
 
@@ -246,7 +246,7 @@ namespace softcube {
         return a.angle(b);
     }
 
-    inline Vector3 min(const Vector3 &a, const Vector3 &b) {
+    constexpr Vector3 min(const Vector3 &a, const Vector3 &b) {
         return Vector3(
             std::min(a.x, b.x),
             std::min(a.y, b.y),
@@ -254,7 +254,7 @@ namespace softcube {
         );
     }
 
-    inline Vector3 max(const Vector3 &a, const Vector3 &b) {
+    constexpr Vector3 max(const Vector3 &a, const Vector3 &b) {
         return Vector3(
             std::max(a.x, b.x),
             std::max(a.y, b.y),
@@ -262,7 +262,7 @@ namespace softcube {
         );
     }
 
-    inline Vector3 clamp(const Vector3 &value, const Vector3 &min_value, const Vector3 &max_value) {
+    constexpr Vector3 clamp(const Vector3 &value, const Vector3 &min_value, const Vector3 &max_value) {
         return Vector3(
             std::clamp(value.x, min_value.x, max_value.x),
             std::clamp(value.y, min_value.y, max_value.y),
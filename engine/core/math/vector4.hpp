@@ -15,16 +15,16 @@ namespace softcube {
 
         Vector4() = default;
 
-        Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {
+        constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {
         }
 
-        explicit Vector4(float value) : x(value), y(value), z(value), w(value) {
+        explicit constexpr Vector4(float value) : x(value), y(value), z(value), w(value) {
         }
 
-        Vector4(const Vector2 &v, float z, float w) : x(v.x), y(v.y), z(z), w(w) {
+        constexpr Vector4(const Vector2 &v, float z, float w) : x(v.x), y(v.y), z(z), w(w) {
         }
 
-        Vector4(const Vector3 &v, float w) : x(v.x), y(v.y), z(v.z), w(w) {
+        constexpr Vector4(const Vector3 &v, float w) : x(v.x), y(v.y), z(v.z), w(w) {
         }
 
         Vector4(const Vector4 &) = default;
@@ -35,45 +35,45 @@ namespace softcube {
 
         Vector4 &operator=(Vector4 &&) = default;
 
-        static Vector4 zero() { return Vector4(0.0f, 0.0f, 0.0f, 0.0f); }
-        static Vector4 one() { return Vector4(1.0f, 1.0f, 1.0f, 1.0f); }
-        static Vector4 unit_x() { return Vector4(1.0f, 0.0f, 0.0f, 0.0f); }
-        static Vector4 unit_y() { return Vector4(0.0f, 1.0f, 0.0f, 0.0f); }
-        static Vector4 unit_z() { return Vector4(0.0f, 0.0f, 1.0f, 0.0f); }
-        static Vector4 unit_w() { return Vector4(0.0f, 0.0f, 0.0f, 1.0f); }
+        static constexpr Vector4 zero() { return Vector4(0.0f, 0.0f, 0.0f, 0.0f); }
+        static constexpr Vector4 one() { return Vector4(1.0f, 1.0f, 1.0f, 1.0f); }
+        static constexpr Vector4 unit_x() { return Vector4(1.0f, 0.0f, 0.0f, 0.0f); }
+        static constexpr Vector4 unit_y() { return Vector4(0.0f, 1.0f, 0.0f, 0.0f); }
+        static constexpr Vector4 unit_z() { return Vector4(0.0f, 0.0f, 1.0f, 0.0f); }
+        static constexpr Vector4 unit_w() { return Vector4(0.0f, 0.0f, 0.0f, 1.0f); }
 
-        Vector2 xy() const { return Vector2(x, y); }
-        Vector3 xyz() const { return Vector3(x, y, z); }
+        constexpr Vector2 xy() const { return Vector2(x, y); }
+        constexpr Vector3 xyz() const { return Vector3(x, y, z); }
 
-        Vector4 operator+(const Vector4 &other) const {
+        constexpr Vector4 operator+(const Vector4 &other) const {
             return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
         }
 
-        Vector4 operator-(const Vector4 &other) const {
+        constexpr Vector4 operator-(const Vector4 &other) const {
             return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
         }
 
-        Vector4 operator*(float scalar) const {
+        constexpr Vector4 operator*(float scalar) const {
             return Vector4(x * scalar, y * scalar, z * scalar, w * scalar);
         }
 
-        Vector4 operator/(float scalar) const {
+        constexpr Vector4 operator/(float scalar) const {
             return Vector4(x / scalar, y / scalar, z / scalar, w / scalar);
         }
 
-        Vector4 operator*(const Vector4 &other) const {
+        constexpr Vector4 operator*(const Vector4 &other) const {
             return Vector4(x * other.x, y * other.y, z * other.z, w * other.w);
         }
 
-        Vector4 operator/(const Vector4 &other) const {
+        constexpr Vector4 operator/(const Vector4 &other) const {
             return Vector4(x / other.x, y / other.y, z / other.z, w / other.w);
         }
 
-        Vector4 operator-() const {
+        constexpr Vector4 operator-() const {
             return Vector4(-x, -y, -z, -w);
         }
 
-        Vector4 &operator+=(const Vector4 &other) {
+        constexpr Vector4 &operator+=(const Vector4 &other) {
             x += other.x;
             y += other.y;
             z += other.z;
@@ -81,7 +81,7 @@ namespace softcube {
             return *this;
         }
 
-        Vector4 &operator-=(const Vector4 &other) {
+        constexpr Vector4 &operator-=(const Vector4 &other) {
             x -= other.x;
             y -= other.y;
             z -= other.z;
@@ -89,7 +89,7 @@ namespace softcube {
             return *this;
         }
 
-        Vector4 &operator*=(float scalar) {
+        constexpr Vector4 &operator*=(float scalar) {
             x *= scalar;
             y *= scalar;
             z *= scalar;
@@ -97,7 +97,7 @@ namespace softcube {
             return *this;
         }
 
-        Vector4 &operator/=(float scalar) {
+        constexpr Vector4 &operator/=(float scalar) {
             x /= scalar;
             y /= scalar;
             z /= scalar;
@@ -105,7 +105,7 @@ namespace softcube {
             return *this;
         }
 
-        Vector4 &operator*=(const Vector4 &other) {
+        constexpr Vector4 &operator*=(const Vector4 &other) {
             x *= other.x;
             y *= other.y;
             z *= other.z;
@@ -113,7 +113,7 @@ namespace softcube {
             return *this;
         }
 
-        Vector4 &operator/=(const Vector4 &other) {
+        constexpr Vector4 &operator/=(const Vector4 &other) {
             x /= other.x;
             y /= other.y;
             z /= other.z;
@@ -121,11 +121,11 @@ namespace softcube {
             return *this;
         }
 
-        bool operator==(const Vector4 &other) const {
+        constexpr bool operator==(const Vector4 &other) const {
             return x == other.x && y == other.y && z == other.z && w == other.w;
         }
 
-        bool operator!=(const Vector4 &other) const {
+        constexpr bool operator!=(const Vector4 &other) const {
             return !(*this == other);
         }
 
@@ -133,7 +133,7 @@ namespace softcube {
             return std::sqrt(x * x + y * y + z * z + w * w);
         }
 
-        float length_squared() const {
+        constexpr float length_squared() const {
             return x * x + y * y + z * z + w * w;
         }
 
@@ -155,7 +155,7 @@ namespace softcube {
             }
         }
 
-        float dot(const Vector4 &other) const {
+        constexpr float dot(const Vector4 &other) const {
             return x * other.x + y * other.y + z * other.z + w * other.w;
         }
 
@@ -163,11 +163,11 @@ namespace softcube {
             return (*this - other).length();
         }
 
-        float distance_squared(const Vector4 &other) const {
+        constexpr float distance_squared(const Vector4 &other) const {
             return (*this - other).length_squared();
         }
 
-        Vector4 lerp(const Vector4 &other, float t) const {
+        constexpr Vector4 lerp(const Vector4 &other, float t) const {
             return Vector4(
                 x + (other.x - x) * t,
                 y + (other.y - y) * t,
@@ -176,7 +176,7 @@ namespace softcube {
             );
         }
 
-        Vector3 homogenize() const {
+        constexpr Vector3 homogenize() const {
             if (w != 0.0f) {
                 float inv_w = 1.0f / w;
                 return Vector3(x * inv_w, y * inv_w, z * inv_w);
@@ -185,11 +185,11 @@ namespace softcube {
         }
     };
 
-    inline Vector4 operator*(float scalar, const Vector4 &vec) {
+    constexpr Vector4 operator*(float scalar, const Vector4 &vec) {
         return vec * scalar;
     }
 
-    inline float dot(const Vector4 &a, const Vector4 &b) {
+    constexpr float dot(const Vector4 &a, const Vector4 &b) {
         return a.dot(b);
     }
 
@@ -197,11 +197,11 @@ namespace softcube {
         return v.normalized();
     }
 
-    inline Vector4 lerp(const Vector4 &a, const Vector4 &b, float t) {
+    constexpr Vector4 lerp(const Vector4 &a, const Vector4 &b, float t) {
         return a.lerp(b, t);
     }
 
-    inline Vector4 min(const Vector4 &a, const Vector4 &b) {
+    constexpr Vector4 min(const Vector4 &a, const Vector4 &b) {
         return Vector4(
             std::min(a.x, b.x),
             std::min(a.y, b.y),
@@ -210,7 +210,7 @@ namespace softcube {
         );
     }
 
-    inline Vector4 max(const Vector4 &a, const Vector4 &b) {
+    constexpr Vector4 max(const Vector4 &a, const Vector4 &b) {
         return Vector4(
             std::max(a.x, b.x),
             std::max(a.y, b.y),
@@ -219,7 +219,7 @@ namespace softcube {
         );
     }
 
-    inline Vector4 clamp(const Vector4 &value, const Vector4 &min_value, const Vector4 &max_value) {
+    constexpr Vector4 clamp(const Vector4 &value, const Vector4 &min_value, const Vector4 &max_value) {
         return Vector4(
             std::clamp(value.x, min_value.x, max_value.x),
             std::clamp(value.y, min_value.y, max_value.y),
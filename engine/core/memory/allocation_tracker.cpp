@@ -0,0 +1,392 @@
+#include "core/memory/allocation_tracker.hpp"
+
+namespace softcube {
+    namespace {
+        /**
+         * @struct ThreadCounters
+         * @brief One thread's allocation counts since it started
+         *
+         * Only the owning thread writes the counts, with a relaxed load and store
+         * rather than a read-modify-write, so operator new never bounces a shared
+         * cache line between cores. begin_frame reads them under s_threads_mutex
+         * and subtracts what it folded last time.
+         */
+        struct ThreadCounters {
+            std::array<std::atomic<u64>, AllocationTracker::max_tags> allocations{};
+            std::array<std::atomic<u64>, AllocationTracker::max_tags> bytes{};
+            std::atomic<u64> frees{0};
+
+            // Counts already folded into a frame; under s_threads_mutex
+            std::array<u64, AllocationTracker::max_tags> folded_allocations{};
+            std::array<u64, AllocationTracker::max_tags> folded_bytes{};
+            u64 folded_frees = 0;
+
+            ThreadCounters *next = nullptr; // Under s_threads_mutex
+            bool registered = false;
+            bool retired = false; // Set once the thread's registration is destroyed
+        };
+
+        struct alignas(64) TagCounters {
+            std::atomic<u64> allocations{0};
+            std::atomic<u64> bytes{0};
+        };
+
+        // Plain atomics and a constexpr-constructed mutex, so they need no
+        // construction before the first allocation. s_retired holds what exited
+        // threads counted since the last frame, and allocations made during
+        // thread teardown after a thread's counters were unlinked.
+        constinit std::array<TagCounters, AllocationTracker::max_tags> s_retired{};
+        constinit std::atomic<u64> s_retired_frees{0};
+        constinit std::mutex s_threads_mutex;
+        constinit ThreadCounters *s_threads = nullptr;
+
+        constinit std::atomic<u64> s_violations{0};
+        constinit std::atomic<const char *> s_violation_zone{nullptr};
+        constinit std::atomic<u32> s_violation_tag{0};
+
+        constinit thread_local ThreadCounters t_counters;
+        constinit thread_local u32 t_tag = AllocationTracker::untagged;
+        constinit thread_local const char *t_no_allocation_zone = nullptr;
+
+        void add_local(std::atomic<u64> &counter, const u64 amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        u64 take_delta(const std::atomic<u64> &counter, u64 &folded) {
+            const u64 value = counter.load(std::memory_order_relaxed);
+            const u64 delta = value - folded;
+            folded = value;
+            return delta;
+        }
+
+        /**
+         * @struct ThreadRegistration
+         * @brief Links this thread's counters into s_threads and unlinks them at thread exit
+         */
+        struct ThreadRegistration {
+            ThreadRegistration() {
+                std::scoped_lock lock(s_threads_mutex);
+                t_counters.next = s_threads;
+                s_threads = &t_counters;
+            }
+
+            ~ThreadRegistration() {
+                std::scoped_lock lock(s_threads_mutex);
+                for (ThreadCounters **link = &s_threads; *link; link = &(*link)->next) {
+                    if (*link == &t_counters) {
+                        *link = t_counters.next;
+                        break;
+                    }
+                }
+
+                for (size_t i = 0; i < AllocationTracker::max_tags; ++i) {
+                    s_retired[i].allocations.fetch_add(take_delta(t_counters.allocations[i],
+                                                                  t_counters.folded_allocations[i]),
+                                                       std::memory_order_relaxed);
+                    s_retired[i].bytes.fetch_add(take_delta(t_counters.bytes[i], t_counters.folded_bytes[i]),
+                                                 std::memory_order_relaxed);
+                }
+                s_retired_frees.fetch_add(take_delta(t_counters.frees, t_counters.folded_frees),
+                                          std::memory_order_relaxed);
+                t_counters.retired = true;
+            }
+        };
+
+        /**
+         * @brief Get the calling thread's counters, registering them on first use
+         * @return Null during thread teardown, once the counters have been unlinked
+         */
+        ThreadCounters *get_thread_counters() {
+            if (!t_counters.registered) {
+                t_counters.registered = true;
+                thread_local const ThreadRegistration registration;
+            }
+            return t_counters.retired ? nullptr : &t_counters;
+        }
+
+        // Everything read and written only under the mutex.
+        struct State {
+            std::mutex mutex;
+            std::vector<AllocationTracker::TagStats> tags;
+            AllocationTracker::FrameStats last_frame;
+            std::array<float, AllocationTracker::history_size> history{};
+            size_t history_head = 0;
+            size_t history_count = 0;
+
+            State() {
+                tags.reserve(AllocationTracker::max_tags);
+                tags.emplace_back().name = "Untagged";
+            }
+        };
+
+        State &get_state() {
+            static State state;
+            return state;
+        }
+    }
+
+    u32 AllocationTracker::register_tag(const std::string_view name) {
+        auto &state = get_state();
+        std::scoped_lock lock(state.mutex);
+
+        for (u32 i = 0; i < state.tags.size(); ++i) {
+            if (state.tags[i].name == name) {
+                return i;
+            }
+        }
+
+        if (state.tags.size() == max_tags) {
+            SC_WARN("Allocation tag limit of {} reached; '{}' is counted as untagged", max_tags, name);
+            return untagged;
+        }
+
+        state.tags.emplace_back().name = name;
+        return static_cast<u32>(state.tags.size() - 1);
+    }
+
+    void AllocationTracker::begin_frame() {
+        auto &state = get_state();
+        const char *violation_zone = nullptr;
+        std::string violation_tag;
+
+        std::array<u64, max_tags> allocations{};
+        std::array<u64, max_tags> bytes{};
+        u64 frees = 0;
+        {
+            std::scoped_lock lock(s_threads_mutex);
+            for (ThreadCounters *counters = s_threads; counters; counters = counters->next) {
+                for (size_t i = 0; i < max_tags; ++i) {
+                    allocations[i] += take_delta(counters->allocations[i], counters->folded_allocations[i]);
+                    bytes[i] += take_delta(counters->bytes[i], counters->folded_bytes[i]);
+                }
+                frees += take_delta(counters->frees, counters->folded_frees);
+            }
+        }
+        for (size_t i = 0; i < max_tags; ++i) {
+            allocations[i] += s_retired[i].allocations.exchange(0, std::memory_order_relaxed);
+            bytes[i] += s_retired[i].bytes.exchange(0, std::memory_order_relaxed);
+        }
+        frees += s_retired_frees.exchange(0, std::memory_order_relaxed);
+
+        FrameStats frame;
+        {
+            std::scoped_lock lock(state.mutex);
+
+            for (size_t i = 0; i < state.tags.size(); ++i) {
+                auto &tag = state.tags[i];
+                tag.last_allocations = allocations[i];
+                tag.last_bytes = bytes[i];
+                tag.peak_allocations = std::max(tag.peak_allocations, tag.last_allocations);
+                tag.peak_bytes = std::max(tag.peak_bytes, tag.last_bytes);
+                tag.total_allocations += tag.last_allocations;
+                tag.total_bytes += tag.last_bytes;
+
+                frame.allocations += tag.last_allocations;
+                frame.bytes += tag.last_bytes;
+            }
+
+            frame.frees = frees;
+            frame.violations = s_violations.exchange(0, std::memory_order_relaxed);
+            if (frame.violations > 0) {
+                violation_zone = s_violation_zone.load(std::memory_order_relaxed);
+                violation_tag = state.tags[s_violation_tag.load(std::memory_order_relaxed)].name;
+            }
+
+            state.last_frame = frame;
+            state.history[state.history_head] = static_cast<float>(frame.allocations);
+            state.history_head = (state.history_head + 1) % history_size;
+            state.history_count = std::min(state.history_count + 1, history_size);
+        }
+
+        if (frame.violations > 0) {
+            SC_WARN("{} allocations inside no-allocation scopes last frame (last in '{}', tag '{}')",
+                    frame.violations, violation_zone ? violation_zone : "?", violation_tag);
+        }
+    }
+
+    void AllocationTracker::record_allocation(const size_t size) {
+        const u32 tag = t_tag;
+        if (auto *counters = get_thread_counters()) {
+            add_local(counters->allocations[tag], 1);
+            add_local(counters->bytes[tag], size);
+        } else {
+            s_retired[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+            s_retired[tag].bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+
+        if (t_no_allocation_zone) {
+            s_violations.fetch_add(1, std::memory_order_relaxed);
+            s_violation_zone.store(t_no_allocation_zone, std::memory_order_relaxed);
+            s_violation_tag.store(tag, std::memory_order_relaxed);
+        }
+    }
+
+    void AllocationTracker::record_free() {
+        if (auto *counters = get_thread_counters()) {
+            add_local(counters->frees, 1);
+        } else {
+            s_retired_frees.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    AllocationTracker::FrameStats AllocationTracker::get_last_frame() {
+        auto &state = get_state();
+        std::scoped_lock lock(state.mutex);
+        return state.last_frame;
+    }
+
+    std::vector<AllocationTracker::TagStats> AllocationTracker::get_tag_stats() {
+        auto &state = get_state();
+        std::scoped_lock lock(state.mutex);
+        return state.tags;
+    }
+
+    size_t AllocationTracker::get_history(std::array<float, history_size> &out) {
+        auto &state = get_state();
+        std::scoped_lock lock(state.mutex);
+
+        const size_t first = (state.history_head + history_size - state.history_count) % history_size;
+        for (size_t i = 0; i < state.history_count; ++i) {
+            out[i] = state.history[(first + i) % history_size];
+        }
+
+        return state.history_count;
+    }
+
+    bool AllocationTracker::dump_csv(const std::filesystem::path &path) {
+        std::ofstream file(path);
+        if (!file) {
+            SC_ERROR("Failed to open {} for writing", path.string());
+            return false;
+        }
+
+        const auto tags = get_tag_stats();
+
+        file << "tag,last_allocs,last_bytes,peak_allocs,peak_bytes,total_allocs,total_bytes\n";
+        for (const auto &tag: tags) {
+            file << tag.name << ','
+                    << tag.last_allocations << ','
+                    << tag.last_bytes << ','
+                    << tag.peak_allocations << ','
+                    << tag.peak_bytes << ','
+                    << tag.total_allocations << ','
+                    << tag.total_bytes << '\n';
+        }
+
+        SC_INFO("Wrote allocation report for {} tags to {}", tags.size(), path.string());
+        return true;
+    }
+
+    void AllocationTracker::reset() {
+        auto &state = get_state();
+        std::scoped_lock lock(state.mutex);
+
+        for (auto &tag: state.tags) {
+            tag.last_allocations = tag.last_bytes = 0;
+            tag.peak_allocations = tag.peak_bytes = 0;
+            tag.total_allocations = tag.total_bytes = 0;
+        }
+
+        state.last_frame = {};
+        state.history_head = 0;
+        state.history_count = 0;
+    }
+
+    AllocationScope::AllocationScope(const u32 tag) : m_previous(t_tag) {
+        t_tag = tag;
+    }
+
+    AllocationScope::~AllocationScope() {
+        t_tag = m_previous;
+    }
+
+    NoAllocationScope::NoAllocationScope(const char *name) : m_previous(t_no_allocation_zone) {
+        t_no_allocation_zone = name;
+    }
+
+    NoAllocationScope::~NoAllocationScope() {
+        t_no_allocation_zone = m_previous;
+    }
+}
+
+#ifdef SOFTCUBE_TRACK_ALLOCATIONS
+
+// The plain, aligned and sized forms are replaced here; the standard library's
+// array and nothrow forms forward to them.
+
+namespace {
+    void *allocate_tracked(size_t size, const size_t alignment) {
+        softcube::AllocationTracker::record_allocation(size);
+
+        if (size == 0) {
+            size = 1;
+        }
+
+        while (true) {
+            void *pointer;
+            if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                pointer = std::malloc(size);
+            } else {
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+                pointer = _aligned_malloc(size, alignment);
+#else
+                pointer = std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+            }
+
+            if (pointer) {
+                return pointer;
+            }
+
+            const auto handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void free_tracked(void *pointer, const size_t alignment) noexcept {
+        if (!pointer) {
+            return;
+        }
+
+        softcube::AllocationTracker::record_free();
+
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            _aligned_free(pointer);
+            return;
+        }
+#else
+        (void) alignment;
+#endif
+        std::free(pointer);
+    }
+}
+
+void *operator new(const size_t size) {
+    return allocate_tracked(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(const size_t size, const std::align_val_t alignment) {
+    return allocate_tracked(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept {
+    free_tracked(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void *pointer, const std::align_val_t alignment) noexcept {
+    free_tracked(pointer, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    free_tracked(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void *pointer, size_t, const std::align_val_t alignment) noexcept {
+    free_tracked(pointer, static_cast<size_t>(alignment));
+}
+
+#endif
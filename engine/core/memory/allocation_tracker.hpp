@@ -0,0 +1,182 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+
+#define SOFTCUBE_CONCAT_IMPL(a, b) a##b
+#define SOFTCUBE_CONCAT(a, b) SOFTCUBE_CONCAT_IMPL(a, b)
+
+#ifdef SOFTCUBE_TRACK_ALLOCATIONS
+    /**
+     * @brief Attribute heap allocations on this thread to a subsystem until the end of the enclosing block
+     */
+    #define SC_ALLOCATION_SCOPE(name) \
+        static const ::softcube::u32 SOFTCUBE_CONCAT(sc_allocation_tag_, __LINE__) = \
+            ::softcube::AllocationTracker::register_tag(name); \
+        const ::softcube::AllocationScope SOFTCUBE_CONCAT(sc_allocation_scope_, __LINE__){ \
+            SOFTCUBE_CONCAT(sc_allocation_tag_, __LINE__)}
+
+    /**
+     * @brief Report every heap allocation on this thread until the end of the enclosing block
+     */
+    #define SC_NO_ALLOCATION_SCOPE(name) \
+        const ::softcube::NoAllocationScope SOFTCUBE_CONCAT(sc_no_allocation_scope_, __LINE__){name}
+#else
+    #define SC_ALLOCATION_SCOPE(name) (void)0
+    #define SC_NO_ALLOCATION_SCOPE(name) (void)0
+#endif
+
+namespace softcube {
+    /**
+     * @class AllocationTracker
+     * @brief Counts global heap allocations per frame and per subsystem tag
+     *
+     * When built with SOFTCUBE_TRACK_ALLOCATIONS the global operator new and
+     * delete are replaced to count every allocation against the tag of the
+     * innermost AllocationScope on the calling thread. Each thread counts into
+     * its own counters, which begin_frame sums, so the hot path touches no
+     * shared cache line; nothing is stored per allocation, so frees are
+     * counted but not attributed.
+     *
+     * Allocations inside a NoAllocationScope are counted as violations and
+     * reported once per frame, which catches per-frame work that should not
+     * touch the heap. Memory allocated outside operator new (malloc, bgfx's
+     * allocator) is not seen.
+     */
+    class AllocationTracker {
+        SC_LOG_GROUP(CORE::ALLOCATION_TRACKER);
+
+    public:
+        static constexpr size_t max_tags = 64;
+        static constexpr size_t history_size = 240;
+        static constexpr u32 untagged = 0;
+
+        /**
+         * @struct FrameStats
+         * @brief Heap activity of one frame
+         */
+        struct FrameStats {
+            u64 allocations = 0;
+            u64 bytes = 0;
+            u64 frees = 0;
+            u64 violations = 0; // Allocations inside no-allocation scopes
+        };
+
+        /**
+         * @struct TagStats
+         * @brief Heap activity attributed to one tag
+         */
+        struct TagStats {
+            std::string name;
+            u64 last_allocations = 0; // In the last finished frame
+            u64 last_bytes = 0;
+            u64 peak_allocations = 0; // Most in any one frame
+            u64 peak_bytes = 0;
+            u64 total_allocations = 0;
+            u64 total_bytes = 0;
+        };
+
+        /**
+         * @brief Check whether allocations are being counted in this build
+         */
+        [[nodiscard]] static constexpr bool is_enabled() {
+#ifdef SOFTCUBE_TRACK_ALLOCATIONS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Get the id of a tag, registering it on first use
+         * @param name Tag name; the same name always maps to the same id
+         * @return Tag id, or untagged once max_tags tags exist
+         */
+        static u32 register_tag(std::string_view name);
+
+        /**
+         * @brief Close the current frame and start counting a new one; main thread only
+         *
+         * Folds the frame into the per-tag totals and the history and logs the
+         * no-allocation violations it contained.
+         */
+        static void begin_frame();
+
+        /**
+         * @brief Count one allocation; called by the global operator new
+         */
+        static void record_allocation(size_t size);
+
+        /**
+         * @brief Count one free; called by the global operator delete
+         */
+        static void record_free();
+
+        /**
+         * @brief Get the totals of the last finished frame
+         */
+        [[nodiscard]] static FrameStats get_last_frame();
+
+        /**
+         * @brief Get the statistics of every registered tag
+         */
+        [[nodiscard]] static std::vector<TagStats> get_tag_stats();
+
+        /**
+         * @brief Copy the allocation count of recent frames into chronological order
+         * @param out Destination, oldest frame first
+         * @return Number of frames written
+         */
+        static size_t get_history(std::array<float, history_size> &out);
+
+        /**
+         * @brief Write the statistics of every tag to a CSV file
+         * @param path Destination file
+         * @return True if the file was written
+         */
+        [[nodiscard]] static bool dump_csv(const std::filesystem::path &path);
+
+        /**
+         * @brief Discard the totals, peaks and history of every tag
+         */
+        static void reset();
+    };
+
+    /**
+     * @class AllocationScope
+     * @brief Attributes allocations on the current thread to a tag while alive
+     */
+    class AllocationScope {
+    public:
+        explicit AllocationScope(u32 tag);
+
+        ~AllocationScope();
+
+        AllocationScope(const AllocationScope &) = delete;
+
+        AllocationScope &operator=(const AllocationScope &) = delete;
+
+    private:
+        u32 m_previous;
+    };
+
+    /**
+     * @class NoAllocationScope
+     * @brief Marks a region of the current thread that must not allocate
+     */
+    class NoAllocationScope {
+    public:
+        /**
+         * @param name Region name reported with violations; must be a string literal
+         */
+        explicit NoAllocationScope(const char *name);
+
+        ~NoAllocationScope();
+
+        NoAllocationScope(const NoAllocationScope &) = delete;
+
+        NoAllocationScope &operator=(const NoAllocationScope &) = delete;
+
+    private:
+        const char *m_previous;
+    };
+}
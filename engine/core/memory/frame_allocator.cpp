@@ -0,0 +1,129 @@
+#include "core/memory/frame_allocator.hpp"
+
+namespace softcube {
+    namespace {
+        // Chunk of the current frame buffer owned by this thread.
+        struct ThreadChunk {
+            u64 owner = 0;
+            u64 frame = 0;
+            std::byte *cursor = nullptr;
+            std::byte *end = nullptr;
+        };
+
+        thread_local ThreadChunk t_chunk;
+
+        // Ids rather than addresses, so a new allocator at a freed address never sees an old chunk.
+        std::atomic<u64> s_next_id{1};
+    }
+
+    FrameAllocator::FrameAllocator(const size_t capacity, const size_t chunk_size)
+        : m_id(s_next_id.fetch_add(1, std::memory_order_relaxed)),
+          m_capacity(capacity),
+          m_chunk_size(std::min(chunk_size, capacity)) {
+        for (auto &buffer: m_buffers) {
+            buffer.memory = std::make_unique_for_overwrite<std::byte[]>(m_capacity);
+        }
+    }
+
+    FrameAllocator::~FrameAllocator() {
+        for (auto &buffer: m_buffers) {
+            reset(buffer);
+        }
+    }
+
+    void FrameAllocator::begin_frame() {
+        const u64 frame = m_frame.load(std::memory_order_relaxed);
+
+        const auto &finished = m_buffers[frame & 1];
+        const size_t used = std::min(finished.offset.load(std::memory_order_relaxed), m_capacity) +
+                            finished.overflow_bytes.load(std::memory_order_relaxed);
+        m_high_water = std::max(m_high_water, used);
+
+        reset(m_buffers[(frame + 1) & 1]);
+        m_frame.store(frame + 1, std::memory_order_release);
+    }
+
+    void *FrameAllocator::allocate(const size_t size, const size_t alignment) {
+        SOFTCUBE_ASSERT(memory::is_power_of_two(alignment), "Alignment must be a power of two");
+
+        const u64 frame = m_frame.load(std::memory_order_acquire);
+        auto &buffer = m_buffers[frame & 1];
+
+        auto &chunk = t_chunk;
+        if (chunk.owner != m_id || chunk.frame != frame) {
+            chunk = {m_id, frame, nullptr, nullptr};
+        }
+
+        if (chunk.cursor) {
+            if (auto *aligned = memory::align_up(chunk.cursor, alignment); size <= static_cast<size_t>(chunk.end - aligned)) {
+                chunk.cursor = aligned + size;
+                return aligned;
+            }
+        }
+
+        const size_t padded = size + alignment - 1;
+
+        // Large requests get their own piece and leave the thread's chunk alone.
+        if (padded > m_chunk_size / 4) {
+            if (auto *memory = take_chunk(buffer, padded)) {
+                return memory::align_up(memory, alignment);
+            }
+            return allocate_overflow(buffer, size, alignment);
+        }
+
+        auto *memory = take_chunk(buffer, m_chunk_size);
+        if (!memory) {
+            return allocate_overflow(buffer, size, alignment);
+        }
+
+        auto *aligned = memory::align_up(memory, alignment);
+        chunk.cursor = aligned + size;
+        chunk.end = memory + m_chunk_size;
+        return aligned;
+    }
+
+    FrameAllocator::Stats FrameAllocator::get_stats() const {
+        const u64 frame = m_frame.load(std::memory_order_relaxed);
+        const auto &buffer = m_buffers[frame & 1];
+
+        Stats stats;
+        stats.capacity = m_capacity;
+        stats.overflow = buffer.overflow_bytes.load(std::memory_order_relaxed);
+        stats.used = std::min(buffer.offset.load(std::memory_order_relaxed), m_capacity) + stats.overflow;
+        stats.high_water = m_high_water;
+        stats.frame = frame;
+        return stats;
+    }
+
+    std::byte *FrameAllocator::take_chunk(Buffer &buffer, const size_t size) {
+        const size_t offset = buffer.offset.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size > m_capacity) {
+            return nullptr;
+        }
+        return buffer.memory.get() + offset;
+    }
+
+    void *FrameAllocator::allocate_overflow(Buffer &buffer, const size_t size, const size_t alignment) {
+        void *pointer = ::operator new(size, std::align_val_t{alignment});
+
+        std::scoped_lock lock(buffer.overflow_mutex);
+        buffer.overflow.push_back({pointer, alignment});
+        buffer.overflow_bytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (!m_overflow_warned.exchange(true, std::memory_order_relaxed)) {
+            SC_WARN("Frame buffer of {} bytes exhausted; falling back to the heap", m_capacity);
+        }
+
+        return pointer;
+    }
+
+    void FrameAllocator::reset(Buffer &buffer) {
+        for (const auto &[pointer, alignment]: buffer.overflow) {
+            ::operator delete(pointer, std::align_val_t{alignment});
+        }
+
+        buffer.overflow.clear();
+        buffer.overflow_bytes.store(0, std::memory_order_relaxed);
+        buffer.offset.store(0, std::memory_order_relaxed);
+    }
+}
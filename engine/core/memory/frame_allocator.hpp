@@ -0,0 +1,147 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "core/memory/memory.hpp"
+
+#include <memory_resource>
+#include <span>
+
+namespace softcube {
+    /**
+     * @class FrameAllocator
+     * @brief Double-buffered linear allocator for memory that lives at most until the end of the next frame
+     *
+     * Each frame bumps through one of two fixed buffers; begin_frame() switches
+     * to the other buffer and resets it, so an allocation stays valid for the
+     * rest of its frame and all of the next one. Nothing is freed individually.
+     *
+     * Every thread bumps through its own chunk of the buffer, so allocations
+     * take no lock and only refilling a chunk touches an atomic. When a buffer
+     * runs out, allocations fall back to the heap until the next reset and are
+     * reported as overflow, a sign that the capacity should be raised.
+     *
+     * Use get_resource() with std::pmr containers (FrameVector, FrameString) to
+     * keep per-frame temporaries off the global heap.
+     */
+    class FrameAllocator {
+        SC_LOG_GROUP(CORE::FRAME_ALLOCATOR);
+
+    public:
+        /**
+         * @struct Stats
+         * @brief Usage of the frame buffers
+         */
+        struct Stats {
+            size_t capacity = 0; // Size of each of the two buffers
+            size_t used = 0; // Bytes taken by the current frame, including chunk slack and overflow
+            size_t overflow = 0; // Bytes of the current frame served by the heap
+            size_t high_water = 0; // Most bytes any finished frame used
+            u64 frame = 0;
+        };
+
+        /**
+         * @brief Allocate both frame buffers
+         * @param capacity Size of each buffer
+         * @param chunk_size Size of the chunks threads take from the buffer
+         */
+        explicit FrameAllocator(size_t capacity = 8 * memory::MiB, size_t chunk_size = 64 * memory::KiB);
+
+        ~FrameAllocator();
+
+        FrameAllocator(const FrameAllocator &) = delete;
+
+        FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+        /**
+         * @brief Switch buffers and reset the one being reused
+         *
+         * Invalidates everything allocated two frames ago. Must not run while
+         * another thread is allocating.
+         */
+        void begin_frame();
+
+        /**
+         * @brief Allocate uninitialized memory; any thread
+         * @param size Number of bytes
+         * @param alignment Power-of-two alignment
+         * @return Memory valid until the end of the next frame
+         */
+        [[nodiscard]] void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Allocate an uninitialized array
+         * @tparam T Trivially destructible element type; destructors are never run
+         * @param count Number of elements
+         */
+        template<typename T>
+        [[nodiscard]] std::span<T> allocate_array(const size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "Frame memory is never destroyed");
+            return {static_cast<T *>(allocate(count * sizeof(T), alignof(T))), count};
+        }
+
+        /**
+         * @brief Get a memory resource allocating from this allocator, for std::pmr containers
+         */
+        [[nodiscard]] std::pmr::memory_resource *get_resource() { return &m_resource; }
+
+        [[nodiscard]] Stats get_stats() const;
+
+    private:
+        class Resource final : public std::pmr::memory_resource {
+        public:
+            explicit Resource(FrameAllocator &allocator) : m_allocator(allocator) {
+            }
+
+        private:
+            void *do_allocate(const size_t bytes, const size_t alignment) override {
+                return m_allocator.allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void *, size_t, size_t) override {
+            }
+
+            [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override {
+                return this == &other;
+            }
+
+            FrameAllocator &m_allocator;
+        };
+
+        struct Overflow {
+            void *pointer;
+            size_t alignment;
+        };
+
+        struct Buffer {
+            std::unique_ptr<std::byte[]> memory;
+            std::atomic<size_t> offset{0};
+
+            std::mutex overflow_mutex;
+            std::vector<Overflow> overflow;
+            std::atomic<size_t> overflow_bytes{0};
+        };
+
+        std::byte *take_chunk(Buffer &buffer, size_t size);
+
+        void *allocate_overflow(Buffer &buffer, size_t size, size_t alignment);
+
+        void reset(Buffer &buffer);
+
+        u64 m_id;
+        size_t m_capacity;
+        size_t m_chunk_size;
+
+        std::array<Buffer, 2> m_buffers;
+        std::atomic<u64> m_frame{0}; // Parity selects the current buffer; a change invalidates every thread's chunk
+
+        size_t m_high_water = 0;
+        std::atomic<bool> m_overflow_warned{false};
+
+        Resource m_resource{*this};
+    };
+
+    template<typename T>
+    using FrameVector = std::pmr::vector<T>;
+
+    using FrameString = std::pmr::string;
+}
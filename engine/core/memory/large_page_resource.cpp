@@ -0,0 +1,117 @@
+#include "core/memory/large_page_resource.hpp"
+
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+    // windows.h comes in through common.hpp
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace softcube {
+    namespace {
+        // Blocks are rounded to this so nearby sizes share a free list.
+        constexpr size_t block_granularity = 64;
+    }
+
+    LargePageResource::LargePageResource(const size_t chunk_size)
+        : m_chunk_size(memory::align_up(std::max(chunk_size, huge_page_size), huge_page_size)) {
+    }
+
+    LargePageResource::~LargePageResource() {
+        if (m_used > 0) {
+            SC_WARN("Destroying large page resource with {} bytes still in use", m_used);
+        }
+
+        for (const auto &[memory, size]: m_chunks) {
+            unmap(memory, size);
+        }
+    }
+
+    LargePageResource::Stats LargePageResource::get_stats() const {
+        std::scoped_lock lock(m_mutex);
+        Stats stats;
+        stats.reserved = m_reserved;
+        stats.used = m_used;
+        stats.chunk_count = m_chunks.size();
+        return stats;
+    }
+
+    void *LargePageResource::do_allocate(const size_t bytes, const size_t alignment) {
+        const size_t size = memory::align_up(std::max<size_t>(bytes, 1), block_granularity);
+        std::scoped_lock lock(m_mutex);
+
+        if (alignment <= block_granularity) {
+            if (const auto it = m_free_blocks.find(size); it != m_free_blocks.end() && !it->second.empty()) {
+                void *block = it->second.back();
+                it->second.pop_back();
+                m_used += size;
+                return block;
+            }
+        }
+
+        auto *aligned = m_cursor ? memory::align_up(m_cursor, alignment) : nullptr;
+        if (!aligned || aligned + size > m_end) {
+            // The tail of the previous chunk is abandoned; blocks are small next to a chunk.
+            const size_t chunk_size = memory::align_up(size + alignment, m_chunk_size);
+            auto *chunk = map(chunk_size);
+            m_chunks.push_back({chunk, chunk_size});
+            m_reserved += chunk_size;
+            m_end = chunk + chunk_size;
+            aligned = memory::align_up(chunk, alignment);
+        }
+
+        m_cursor = aligned + size;
+        m_used += size;
+        return aligned;
+    }
+
+    void LargePageResource::do_deallocate(void *pointer, const size_t bytes, const size_t alignment) {
+        const size_t size = memory::align_up(std::max<size_t>(bytes, 1), block_granularity);
+        std::scoped_lock lock(m_mutex);
+        m_used -= size;
+
+        // Over-aligned blocks are rare and not worth a free list keyed by alignment.
+        if (alignment <= block_granularity) {
+            m_free_blocks[size].push_back(pointer);
+        }
+    }
+
+    std::byte *LargePageResource::map(const size_t size) {
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+        // Large pages need SeLockMemoryPrivilege, so plain pages are used here.
+        void *memory = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+#else
+        // Over-map so the chunk can start on a huge page boundary.
+        const size_t mapped_size = size + huge_page_size;
+        void *mapping = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        auto *start = static_cast<std::byte *>(mapping);
+        auto *memory = memory::align_up(start, huge_page_size);
+        if (memory > start) {
+            munmap(start, static_cast<size_t>(memory - start));
+        }
+        if (const size_t tail = static_cast<size_t>(start + mapped_size - (memory + size)); tail > 0) {
+            munmap(memory + size, tail);
+        }
+
+    #ifdef MADV_HUGEPAGE
+        madvise(memory, size, MADV_HUGEPAGE);
+    #endif
+#endif
+        return static_cast<std::byte *>(memory);
+    }
+
+    void LargePageResource::unmap(std::byte *memory, const size_t size) {
+#ifdef SOFTCUBE_PLATFORM_WINDOWS
+        (void) size;
+        VirtualFree(memory, 0, MEM_RELEASE);
+#else
+        munmap(memory, size);
+#endif
+    }
+}
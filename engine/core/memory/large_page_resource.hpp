@@ -0,0 +1,80 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "core/memory/memory.hpp"
+
+#include <memory_resource>
+
+namespace softcube {
+    /**
+     * @class LargePageResource
+     * @brief Memory resource carving blocks out of large, contiguous, huge-page-backed chunks
+     *
+     * Meant for containers that allocate many equally sized pages, such as
+     * EnTT component storages: the pages end up packed into a few chunks, so
+     * walking the storage touches far fewer TLB entries than with scattered
+     * heap pages. Freed blocks are kept per size and reused; chunks are only
+     * returned to the system when the resource is destroyed.
+     *
+     * Chunks are mapped directly from the OS and, on Linux, advised for
+     * transparent huge pages. Thread-safe; a mutex guards the chunks, which is
+     * cheap next to the page-sized blocks storages ask for.
+     */
+    class LargePageResource final : public std::pmr::memory_resource {
+        SC_LOG_GROUP(CORE::LARGE_PAGE_RESOURCE);
+
+    public:
+        static constexpr size_t huge_page_size = 2 * memory::MiB;
+
+        /**
+         * @struct Stats
+         * @brief Memory held by the resource
+         */
+        struct Stats {
+            size_t reserved = 0; // Bytes mapped in chunks
+            size_t used = 0; // Bytes handed out and not yet returned
+            size_t chunk_count = 0;
+        };
+
+        /**
+         * @param chunk_size Size of each mapped chunk; rounded up to the huge page size
+         */
+        explicit LargePageResource(size_t chunk_size = 32 * memory::MiB);
+
+        ~LargePageResource() override;
+
+        LargePageResource(const LargePageResource &) = delete;
+
+        LargePageResource &operator=(const LargePageResource &) = delete;
+
+        [[nodiscard]] Stats get_stats() const;
+
+    private:
+        struct Chunk {
+            std::byte *memory;
+            size_t size;
+        };
+
+        void *do_allocate(size_t bytes, size_t alignment) override;
+
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+
+        [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+
+        [[nodiscard]] static std::byte *map(size_t size);
+
+        static void unmap(std::byte *memory, size_t size);
+
+        mutable std::mutex m_mutex;
+        size_t m_chunk_size;
+        std::vector<Chunk> m_chunks;
+        std::byte *m_cursor = nullptr;
+        std::byte *m_end = nullptr;
+
+        std::unordered_map<size_t, std::vector<void *> > m_free_blocks; // By rounded block size
+        size_t m_reserved = 0;
+        size_t m_used = 0;
+    };
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "core/common.hpp"
+
+namespace softcube::memory {
+    constexpr size_t KiB = 1024;
+    constexpr size_t MiB = 1024 * KiB;
+
+    /**
+     * @brief Typical cache line size, for padding data written by different threads
+     */
+    constexpr size_t cache_line_size = 64;
+
+    [[nodiscard]] constexpr bool is_power_of_two(const size_t value) {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+
+    /**
+     * @brief Round a size or address up to a multiple of a power-of-two alignment
+     */
+    [[nodiscard]] constexpr size_t align_up(const size_t value, const size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    [[nodiscard]] inline std::byte *align_up(std::byte *pointer, const size_t alignment) {
+        return reinterpret_cast<std::byte *>(align_up(reinterpret_cast<uintptr_t>(pointer), alignment));
+    }
+}
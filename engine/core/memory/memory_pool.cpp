@@ -0,0 +1,290 @@
+#include "core/memory/memory_pool.hpp"
+
+namespace softcube {
+    namespace {
+        constexpr std::byte freed_pattern{0xDD};
+        constexpr std::byte allocated_pattern{0xCD};
+
+        /**
+         * @struct SlotRegistry
+         * @brief Cache slots shared by every concurrent pool and the pools a thread must drain when it exits
+         */
+        struct SlotRegistry {
+            std::mutex mutex;
+            std::vector<size_t> free_slots;
+            size_t next_slot = 0;
+            std::vector<ConcurrentMemoryPool *> pools;
+        };
+
+        SlotRegistry &get_slot_registry() {
+            // Never destroyed, so threads exiting during static destruction can still release their slot.
+            static auto *registry = new SlotRegistry();
+            return *registry;
+        }
+    }
+
+    /**
+     * @struct ConcurrentMemoryPool::ThreadSlot
+     * @brief Cache index of one thread, taken on first use and released when the thread exits
+     */
+    struct ConcurrentMemoryPool::ThreadSlot {
+        size_t index;
+
+        ThreadSlot() {
+            auto &registry = get_slot_registry();
+            std::scoped_lock lock(registry.mutex);
+            if (registry.free_slots.empty()) {
+                index = registry.next_slot++;
+            } else {
+                index = registry.free_slots.back();
+                registry.free_slots.pop_back();
+            }
+        }
+
+        ~ThreadSlot() {
+            // Holding the registry lock keeps every pool in the list alive while its cache is drained.
+            auto &registry = get_slot_registry();
+            std::scoped_lock lock(registry.mutex);
+            if (index < max_thread_caches) {
+                for (auto *pool: registry.pools) {
+                    pool->drain_cache(pool->m_caches[index]);
+                }
+            }
+            registry.free_slots.push_back(index);
+        }
+
+        ThreadSlot(const ThreadSlot &) = delete;
+
+        ThreadSlot &operator=(const ThreadSlot &) = delete;
+    };
+
+    MemoryPool::MemoryPool(const size_t block_size, const size_t alignment, const size_t blocks_per_page)
+        : m_block_size(memory::align_up(std::max(block_size, sizeof(FreeBlock)),
+                                        std::max(alignment, alignof(FreeBlock)))),
+          m_alignment(std::max(alignment, alignof(FreeBlock))),
+          m_blocks_per_page(std::max<size_t>(blocks_per_page, 1)) {
+        SOFTCUBE_ASSERT(memory::is_power_of_two(alignment), "Alignment must be a power of two");
+    }
+
+    MemoryPool::~MemoryPool() {
+        if (m_used > 0) {
+            SC_WARN("Destroying pool of {}-byte blocks with {} blocks still in use", m_block_size, m_used);
+        }
+
+        for (auto *page: m_pages) {
+            ::operator delete(page, std::align_val_t{m_alignment});
+        }
+    }
+
+    void *MemoryPool::allocate() {
+        void *block;
+        if (m_free) {
+            block = m_free;
+            m_free = m_free->next;
+            check_poison(block);
+        } else {
+            if (m_page_cursor == m_page_end) {
+                add_page();
+            }
+            block = m_page_cursor;
+            m_page_cursor += m_block_size;
+        }
+
+#if SOFTCUBE_POOL_POISON
+        std::memset(block, std::to_integer<int>(allocated_pattern), m_block_size);
+#endif
+
+        m_high_water = std::max(m_high_water, ++m_used);
+        return block;
+    }
+
+    void MemoryPool::deallocate(void *block) {
+        if (!block) {
+            return;
+        }
+
+        SOFTCUBE_ASSERT(owns(block), "Block was not allocated by this pool");
+        SOFTCUBE_ASSERT(m_used > 0, "More blocks freed than allocated");
+
+        poison(block);
+
+        auto *free_block = static_cast<FreeBlock *>(block);
+        free_block->next = m_free;
+        m_free = free_block;
+        --m_used;
+    }
+
+    bool MemoryPool::owns(const void *pointer) const {
+        const auto *byte = static_cast<const std::byte *>(pointer);
+        const size_t page_size = m_block_size * m_blocks_per_page;
+
+        return std::ranges::any_of(m_pages, [&](const std::byte *page) {
+            return byte >= page && byte < page + page_size && (byte - page) % m_block_size == 0;
+        });
+    }
+
+    MemoryPool::Stats MemoryPool::get_stats() const {
+        Stats stats;
+        stats.block_size = m_block_size;
+        stats.page_count = m_pages.size();
+        stats.capacity = m_pages.size() * m_blocks_per_page;
+        stats.used = m_used;
+        stats.high_water = m_high_water;
+        return stats;
+    }
+
+    void MemoryPool::add_page() {
+        auto *page = static_cast<std::byte *>(::operator new(m_block_size * m_blocks_per_page,
+                                                             std::align_val_t{m_alignment}));
+        m_pages.push_back(page);
+        m_page_cursor = page;
+        m_page_end = page + m_block_size * m_blocks_per_page;
+    }
+
+    void MemoryPool::poison(void *block) const {
+#if SOFTCUBE_POOL_POISON
+        std::memset(static_cast<std::byte *>(block) + sizeof(FreeBlock), std::to_integer<int>(freed_pattern),
+                    m_block_size - sizeof(FreeBlock));
+#else
+        (void) block;
+#endif
+    }
+
+    void MemoryPool::check_poison(const void *block) const {
+#if SOFTCUBE_POOL_POISON
+        const auto *bytes = static_cast<const std::byte *>(block);
+        for (size_t i = sizeof(FreeBlock); i < m_block_size; ++i) {
+            if (bytes[i] != freed_pattern) {
+                SC_ERROR("Pool block {} was written to after being freed (byte {})", block, i);
+                SOFTCUBE_ASSERT(false, "Use after free in pool block");
+                break;
+            }
+        }
+#else
+        (void) block;
+#endif
+    }
+
+    ConcurrentMemoryPool::ConcurrentMemoryPool(const size_t block_size, const size_t alignment,
+                                               const size_t blocks_per_page, const size_t cache_size)
+        : m_pool(block_size, alignment, blocks_per_page), m_cache_size(cache_size) {
+        auto &registry = get_slot_registry();
+        std::scoped_lock lock(registry.mutex);
+        registry.pools.push_back(this);
+    }
+
+    ConcurrentMemoryPool::~ConcurrentMemoryPool() {
+        {
+            // Once unlisted, exiting threads no longer touch this pool's caches.
+            auto &registry = get_slot_registry();
+            std::scoped_lock lock(registry.mutex);
+            std::erase(registry.pools, this);
+        }
+
+        for (auto &cache: m_caches) {
+            drain_cache(cache);
+        }
+    }
+
+    void *ConcurrentMemoryPool::allocate() {
+        auto *cache = get_cache();
+        if (!cache) {
+            std::scoped_lock lock(m_mutex);
+            return m_pool.allocate();
+        }
+
+        size_t count = cache->count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            // Refill half the cache and hand out one more block directly.
+            std::scoped_lock lock(m_mutex);
+            for (size_t i = 0; i < m_cache_size / 2; ++i) {
+                auto *block = static_cast<MemoryPool::FreeBlock *>(m_pool.allocate());
+                m_pool.poison(block);
+                block->next = cache->head;
+                cache->head = block;
+                ++count;
+            }
+            cache->count.store(count, std::memory_order_relaxed);
+            return m_pool.allocate();
+        }
+
+        auto *block = cache->head;
+        cache->head = block->next;
+        cache->count.store(count - 1, std::memory_order_relaxed);
+
+        m_pool.check_poison(block);
+#if SOFTCUBE_POOL_POISON
+        std::memset(block, std::to_integer<int>(allocated_pattern), m_pool.m_block_size);
+#endif
+        return block;
+    }
+
+    void ConcurrentMemoryPool::deallocate(void *block) {
+        if (!block) {
+            return;
+        }
+
+        auto *cache = get_cache();
+        if (!cache) {
+            std::scoped_lock lock(m_mutex);
+            m_pool.deallocate(block);
+            return;
+        }
+
+        size_t count = cache->count.load(std::memory_order_relaxed);
+        if (count >= m_cache_size) {
+            // Drain half the cache, then return this block with it.
+            std::scoped_lock lock(m_mutex);
+            for (; count > m_cache_size / 2; --count) {
+                auto *cached = cache->head;
+                cache->head = cached->next;
+                m_pool.deallocate(cached);
+            }
+            cache->count.store(count, std::memory_order_relaxed);
+            m_pool.deallocate(block);
+            return;
+        }
+
+        m_pool.poison(block);
+        auto *free_block = static_cast<MemoryPool::FreeBlock *>(block);
+        free_block->next = cache->head;
+        cache->head = free_block;
+        cache->count.store(count + 1, std::memory_order_relaxed);
+    }
+
+    bool ConcurrentMemoryPool::owns(const void *pointer) const {
+        std::scoped_lock lock(m_mutex);
+        return m_pool.owns(pointer);
+    }
+
+    MemoryPool::Stats ConcurrentMemoryPool::get_stats() const {
+        MemoryPool::Stats stats;
+        {
+            std::scoped_lock lock(m_mutex);
+            stats = m_pool.get_stats();
+        }
+
+        for (const auto &cache: m_caches) {
+            stats.cached += cache.count.load(std::memory_order_relaxed);
+        }
+        stats.used -= std::min(stats.used, stats.cached);
+        return stats;
+    }
+
+    ConcurrentMemoryPool::Cache *ConcurrentMemoryPool::get_cache() {
+        thread_local const ThreadSlot slot;
+        if (m_cache_size < 2 || slot.index >= max_thread_caches) {
+            return nullptr;
+        }
+        return &m_caches[slot.index];
+    }
+
+    void ConcurrentMemoryPool::drain_cache(Cache &cache) {
+        std::scoped_lock lock(m_mutex);
+        while (auto *block = cache.head) {
+            cache.head = block->next;
+            m_pool.deallocate(block);
+        }
+        cache.count.store(0, std::memory_order_relaxed);
+    }
+}
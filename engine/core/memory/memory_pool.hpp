@@ -0,0 +1,217 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "core/memory/memory.hpp"
+
+// Freed blocks are filled with a pattern that is checked when they are handed
+// out again, catching writes through dangling pointers. On in debug builds.
+#if defined(SOFTCUBE_DEBUG) && !defined(SOFTCUBE_POOL_POISON)
+    #define SOFTCUBE_POOL_POISON 1
+#endif
+
+namespace softcube {
+    /**
+     * @class MemoryPool
+     * @brief Fixed-size block allocator growing a page of blocks at a time
+     *
+     * Freed blocks go on an intrusive free list and are reused before a new
+     * page is carved, so allocation and deallocation are a few pointer moves.
+     * Pages are only released when the pool is destroyed. Not thread-safe; see
+     * ConcurrentMemoryPool.
+     */
+    class MemoryPool {
+        SC_LOG_GROUP(CORE::MEMORY_POOL);
+
+    public:
+        /**
+         * @struct Stats
+         * @brief Occupancy of a pool
+         */
+        struct Stats {
+            size_t block_size = 0; // Bytes per block, after padding for alignment
+            size_t page_count = 0;
+            size_t capacity = 0; // Blocks in all pages
+            size_t used = 0; // Blocks handed out and not yet returned
+            size_t high_water = 0; // Most blocks ever in use at once
+            size_t cached = 0; // Free blocks parked in thread caches, not counted as used
+        };
+
+        /**
+         * @brief Create an empty pool; no memory is allocated until the first block
+         * @param block_size Size of each block; raised to hold a pointer and rounded to the alignment
+         * @param alignment Power-of-two alignment of every block
+         * @param blocks_per_page Number of blocks added each time the pool grows
+         */
+        explicit MemoryPool(size_t block_size, size_t alignment = alignof(std::max_align_t),
+                            size_t blocks_per_page = 256);
+
+        ~MemoryPool();
+
+        MemoryPool(const MemoryPool &) = delete;
+
+        MemoryPool &operator=(const MemoryPool &) = delete;
+
+        /**
+         * @brief Take a block, growing the pool by a page if none is free
+         */
+        [[nodiscard]] void *allocate();
+
+        /**
+         * @brief Return a block taken from this pool
+         */
+        void deallocate(void *block);
+
+        /**
+         * @brief Check whether a pointer lies inside one of this pool's pages; linear in the page count
+         */
+        [[nodiscard]] bool owns(const void *pointer) const;
+
+        [[nodiscard]] size_t get_block_size() const { return m_block_size; }
+
+        [[nodiscard]] Stats get_stats() const;
+
+    private:
+        friend class ConcurrentMemoryPool;
+
+        struct FreeBlock {
+            FreeBlock *next;
+        };
+
+        void add_page();
+
+        void poison(void *block) const;
+
+        void check_poison(const void *block) const;
+
+        size_t m_block_size;
+        size_t m_alignment;
+        size_t m_blocks_per_page;
+
+        std::vector<std::byte *> m_pages;
+        FreeBlock *m_free = nullptr;
+        std::byte *m_page_cursor = nullptr; // Never-used blocks left in the newest page
+        std::byte *m_page_end = nullptr;
+
+        size_t m_used = 0;
+        size_t m_high_water = 0;
+    };
+
+    /**
+     * @class ConcurrentMemoryPool
+     * @brief Thread-safe MemoryPool with a small per-thread cache of free blocks
+     *
+     * Each thread keeps up to cache_size free blocks of its own and only takes
+     * the lock to refill or drain half of them at once, so steady churn on one
+     * thread rarely contends. A block may be freed on a different thread than
+     * the one that allocated it. With a cache size of 0 every call locks.
+     *
+     * Cache slots are shared by all concurrent pools and recycled: when a
+     * thread exits, its caches in every live pool are returned to their pools
+     * and its slot goes to the next new thread.
+     */
+    class ConcurrentMemoryPool {
+    public:
+        /**
+         * @param block_size Size of each block
+         * @param alignment Power-of-two alignment of every block
+         * @param blocks_per_page Number of blocks added each time the pool grows
+         * @param cache_size Free blocks each thread may hold on to
+         */
+        explicit ConcurrentMemoryPool(size_t block_size, size_t alignment = alignof(std::max_align_t),
+                                      size_t blocks_per_page = 256, size_t cache_size = 32);
+
+        ~ConcurrentMemoryPool();
+
+        ConcurrentMemoryPool(const ConcurrentMemoryPool &) = delete;
+
+        ConcurrentMemoryPool &operator=(const ConcurrentMemoryPool &) = delete;
+
+        [[nodiscard]] void *allocate();
+
+        void deallocate(void *block);
+
+        [[nodiscard]] bool owns(const void *pointer) const;
+
+        [[nodiscard]] size_t get_block_size() const { return m_pool.get_block_size(); }
+
+        [[nodiscard]] MemoryPool::Stats get_stats() const;
+
+    private:
+        // Threads running at once past this many get no cache and always take the lock.
+        static constexpr size_t max_thread_caches = 64;
+
+        struct alignas(memory::cache_line_size) Cache {
+            MemoryPool::FreeBlock *head = nullptr;
+            std::atomic<size_t> count{0}; // Written by the owning thread only
+        };
+
+        struct ThreadSlot;
+
+        Cache *get_cache();
+
+        /**
+         * @brief Return every block of a cache to the shared pool
+         */
+        void drain_cache(Cache &cache);
+
+        MemoryPool m_pool;
+        mutable std::mutex m_mutex;
+        size_t m_cache_size;
+        std::array<Cache, max_thread_caches> m_caches;
+    };
+
+    /**
+     * @class ObjectPool
+     * @brief Typed front end constructing and destroying objects in pool blocks
+     * @tparam T Object type
+     * @tparam Pool MemoryPool, or ConcurrentMemoryPool to share the pool between threads
+     */
+    template<typename T, typename Pool = MemoryPool>
+    class ObjectPool {
+    public:
+        /**
+         * @param objects_per_page Number of objects added each time the pool grows
+         */
+        explicit ObjectPool(const size_t objects_per_page = 256)
+            : m_pool(sizeof(T), alignof(T), objects_per_page) {
+        }
+
+        /**
+         * @brief Construct an object in a pool block
+         * @param args Constructor arguments
+         */
+        template<typename... Args>
+        [[nodiscard]] T *create(Args &&... args) {
+            void *block = m_pool.allocate();
+            if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+                return new(block) T(std::forward<Args>(args)...);
+            } else {
+                try {
+                    return new(block) T(std::forward<Args>(args)...);
+                } catch (...) {
+                    m_pool.deallocate(block);
+                    throw;
+                }
+            }
+        }
+
+        /**
+         * @brief Destroy an object created by this pool and return its block
+         */
+        void destroy(T *object) {
+            if (!object) {
+                return;
+            }
+
+            object->~T();
+            m_pool.deallocate(object);
+        }
+
+        [[nodiscard]] MemoryPool::Stats get_stats() const { return m_pool.get_stats(); }
+
+        [[nodiscard]] Pool &get_pool() { return m_pool; }
+
+    private:
+        Pool m_pool;
+    };
+}
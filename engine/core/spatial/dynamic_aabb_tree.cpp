@@ -0,0 +1,300 @@
+#include "dynamic_aabb_tree.hpp"
+
+namespace softcube {
+    DynamicAabbTree::DynamicAabbTree(const float margin, const float displacement_multiplier)
+        : m_margin(margin), m_displacement_multiplier(displacement_multiplier) {
+    }
+
+    i32 DynamicAabbTree::create_proxy(const AABB &aabb, const u32 user_data) {
+        const i32 proxy_id = allocate_node();
+
+        auto &node = m_nodes[proxy_id];
+        node.aabb = fatten(aabb);
+        node.user_data = user_data;
+        node.height = 0;
+
+        insert_leaf(proxy_id);
+        ++m_proxy_count;
+
+        return proxy_id;
+    }
+
+    void DynamicAabbTree::destroy_proxy(const i32 proxy_id) {
+        SOFTCUBE_ASSERT(proxy_id >= 0 && proxy_id < static_cast<i32>(m_nodes.size()), "Invalid proxy id");
+        SOFTCUBE_ASSERT(m_nodes[proxy_id].is_leaf(), "Proxy id does not refer to a leaf");
+
+        remove_leaf(proxy_id);
+        free_node(proxy_id);
+        --m_proxy_count;
+    }
+
+    bool DynamicAabbTree::move_proxy(const i32 proxy_id, const AABB &aabb, const Vector3 &displacement) {
+        SOFTCUBE_ASSERT(proxy_id >= 0 && proxy_id < static_cast<i32>(m_nodes.size()), "Invalid proxy id");
+        SOFTCUBE_ASSERT(m_nodes[proxy_id].is_leaf(), "Proxy id does not refer to a leaf");
+
+        AABB fat = fatten(aabb);
+        const auto &current = m_nodes[proxy_id].aabb;
+
+        if (current.contains(aabb)) {
+            // Still enclosed; only reinsert if the leaf has become much larger than
+            // it needs to be, otherwise queries would keep returning stale hits.
+            AABB huge = fat;
+            huge.expand(4.0f * m_margin);
+            if (huge.contains(current)) {
+                return false;
+            }
+        }
+
+        const Vector3 predicted = displacement * m_displacement_multiplier;
+        if (predicted.x < 0.0f) fat.min.x += predicted.x; else fat.max.x += predicted.x;
+        if (predicted.y < 0.0f) fat.min.y += predicted.y; else fat.max.y += predicted.y;
+        if (predicted.z < 0.0f) fat.min.z += predicted.z; else fat.max.z += predicted.z;
+
+        remove_leaf(proxy_id);
+        m_nodes[proxy_id].aabb = fat;
+        insert_leaf(proxy_id);
+
+        return true;
+    }
+
+    void DynamicAabbTree::clear() {
+        m_nodes.clear();
+        m_root = null_node;
+        m_free_list = null_node;
+        m_proxy_count = 0;
+    }
+
+    AABB DynamicAabbTree::fatten(const AABB &aabb) const {
+        AABB fat = aabb;
+        fat.expand(m_margin);
+        return fat;
+    }
+
+    i32 DynamicAabbTree::allocate_node() {
+        if (m_free_list == null_node) {
+            m_nodes.emplace_back();
+            return static_cast<i32>(m_nodes.size() - 1);
+        }
+
+        const i32 node_id = m_free_list;
+        m_free_list = m_nodes[node_id].parent;
+        m_nodes[node_id] = Node{};
+        return node_id;
+    }
+
+    void DynamicAabbTree::free_node(const i32 node_id) {
+        auto &node = m_nodes[node_id];
+        node.parent = m_free_list;
+        node.child1 = null_node;
+        node.child2 = null_node;
+        node.height = -1;
+        m_free_list = node_id;
+    }
+
+    void DynamicAabbTree::insert_leaf(const i32 leaf) {
+        if (m_root == null_node) {
+            m_root = leaf;
+            m_nodes[leaf].parent = null_node;
+            return;
+        }
+
+        // Descend towards the sibling that minimizes the surface area heuristic.
+        const AABB leaf_aabb = m_nodes[leaf].aabb;
+        i32 index = m_root;
+
+        while (!m_nodes[index].is_leaf()) {
+            const auto &node = m_nodes[index];
+            const i32 child1 = node.child1;
+            const i32 child2 = node.child2;
+
+            const float area = node.aabb.surface_area();
+            const float combined_area = AABB::merge(node.aabb, leaf_aabb).surface_area();
+
+            const float cost = 2.0f * combined_area;
+            const float inheritance_cost = 2.0f * (combined_area - area);
+
+            auto descend_cost = [&](const i32 child) {
+                const auto &child_node = m_nodes[child];
+                const float merged = AABB::merge(leaf_aabb, child_node.aabb).surface_area();
+                return child_node.is_leaf()
+                           ? merged + inheritance_cost
+                           : merged - child_node.aabb.surface_area() + inheritance_cost;
+            };
+
+            const float cost1 = descend_cost(child1);
+            const float cost2 = descend_cost(child2);
+
+            if (cost < cost1 && cost < cost2) {
+                break;
+            }
+
+            index = cost1 < cost2 ? child1 : child2;
+        }
+
+        const i32 sibling = index;
+        const i32 old_parent = m_nodes[sibling].parent;
+        const i32 new_parent = allocate_node();
+
+        m_nodes[new_parent].parent = old_parent;
+        m_nodes[new_parent].aabb = AABB::merge(leaf_aabb, m_nodes[sibling].aabb);
+        m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+        m_nodes[new_parent].child1 = sibling;
+        m_nodes[new_parent].child2 = leaf;
+        m_nodes[sibling].parent = new_parent;
+        m_nodes[leaf].parent = new_parent;
+
+        if (old_parent != null_node) {
+            if (m_nodes[old_parent].child1 == sibling) {
+                m_nodes[old_parent].child1 = new_parent;
+            } else {
+                m_nodes[old_parent].child2 = new_parent;
+            }
+        } else {
+            m_root = new_parent;
+        }
+
+        refit_ancestors(m_nodes[leaf].parent);
+    }
+
+    void DynamicAabbTree::remove_leaf(const i32 leaf) {
+        if (leaf == m_root) {
+            m_root = null_node;
+            return;
+        }
+
+        const i32 parent = m_nodes[leaf].parent;
+        const i32 grand_parent = m_nodes[parent].parent;
+        const i32 sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+        if (grand_parent != null_node) {
+            if (m_nodes[grand_parent].child1 == parent) {
+                m_nodes[grand_parent].child1 = sibling;
+            } else {
+                m_nodes[grand_parent].child2 = sibling;
+            }
+            m_nodes[sibling].parent = grand_parent;
+            free_node(parent);
+
+            refit_ancestors(grand_parent);
+        } else {
+            m_root = sibling;
+            m_nodes[sibling].parent = null_node;
+            free_node(parent);
+        }
+    }
+
+    void DynamicAabbTree::refit_ancestors(i32 node_id) {
+        while (node_id != null_node) {
+            node_id = balance(node_id);
+
+            auto &node = m_nodes[node_id];
+            const auto &child1 = m_nodes[node.child1];
+            const auto &child2 = m_nodes[node.child2];
+
+            node.height = 1 + std::max(child1.height, child2.height);
+            node.aabb = AABB::merge(child1.aabb, child2.aabb);
+
+            node_id = node.parent;
+        }
+    }
+
+    i32 DynamicAabbTree::balance(const i32 node_id) {
+        auto &a = m_nodes[node_id];
+        if (a.is_leaf() || a.height < 2) {
+            return node_id;
+        }
+
+        const i32 ib = a.child1;
+        const i32 ic = a.child2;
+        auto &b = m_nodes[ib];
+        auto &c = m_nodes[ic];
+
+        const i32 balance_factor = c.height - b.height;
+
+        // Rotate C up
+        if (balance_factor > 1) {
+            const i32 i_f = c.child1;
+            const i32 i_g = c.child2;
+            auto &f = m_nodes[i_f];
+            auto &g = m_nodes[i_g];
+
+            c.child1 = node_id;
+            c.parent = a.parent;
+            a.parent = ic;
+
+            if (c.parent != null_node) {
+                if (m_nodes[c.parent].child1 == node_id) {
+                    m_nodes[c.parent].child1 = ic;
+                } else {
+                    m_nodes[c.parent].child2 = ic;
+                }
+            } else {
+                m_root = ic;
+            }
+
+            if (f.height > g.height) {
+                c.child2 = i_f;
+                a.child2 = i_g;
+                g.parent = node_id;
+                a.aabb = AABB::merge(b.aabb, g.aabb);
+                c.aabb = AABB::merge(a.aabb, f.aabb);
+                a.height = 1 + std::max(b.height, g.height);
+                c.height = 1 + std::max(a.height, f.height);
+            } else {
+                c.child2 = i_g;
+                a.child2 = i_f;
+                f.parent = node_id;
+                a.aabb = AABB::merge(b.aabb, f.aabb);
+                c.aabb = AABB::merge(a.aabb, g.aabb);
+                a.height = 1 + std::max(b.height, f.height);
+                c.height = 1 + std::max(a.height, g.height);
+            }
+
+            return ic;
+        }
+
+        // Rotate B up
+        if (balance_factor < -1) {
+            const i32 i_d = b.child1;
+            const i32 i_e = b.child2;
+            auto &d = m_nodes[i_d];
+            auto &e = m_nodes[i_e];
+
+            b.child1 = node_id;
+            b.parent = a.parent;
+            a.parent = ib;
+
+            if (b.parent != null_node) {
+                if (m_nodes[b.parent].child1 == node_id) {
+                    m_nodes[b.parent].child1 = ib;
+                } else {
+                    m_nodes[b.parent].child2 = ib;
+                }
+            } else {
+                m_root = ib;
+            }
+
+            if (d.height > e.height) {
+                b.child2 = i_d;
+                a.child1 = i_e;
+                e.parent = node_id;
+                a.aabb = AABB::merge(c.aabb, e.aabb);
+                b.aabb = AABB::merge(a.aabb, d.aabb);
+                a.height = 1 + std::max(c.height, e.height);
+                b.height = 1 + std::max(a.height, d.height);
+            } else {
+                b.child2 = i_e;
+                a.child1 = i_d;
+                d.parent = node_id;
+                a.aabb = AABB::merge(c.aabb, d.aabb);
+                b.aabb = AABB::merge(a.aabb, e.aabb);
+                a.height = 1 + std::max(c.height, d.height);
+                b.height = 1 + std::max(a.height, e.height);
+            }
+
+            return ib;
+        }
+
+        return node_id;
+    }
+}
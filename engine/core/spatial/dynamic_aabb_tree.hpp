@@ -0,0 +1,228 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/math/aabb.hpp"
+#include "core/math/frustum.hpp"
+
+namespace softcube {
+    /**
+     * @class DynamicAabbTree
+     * @brief Incrementally maintained bounding volume hierarchy of fattened AABBs
+     *
+     * Leaves store a box enlarged by a margin, so a proxy that moves a little stays
+     * inside its leaf and costs a single containment test. A proxy that escapes is
+     * removed and reinserted in O(log n), and the path back to the root is refitted
+     * and rebalanced with AVL-style rotations. The tree is never rebuilt.
+     *
+     * Queries test the fattened boxes only; callers refine against tight bounds.
+     */
+    class DynamicAabbTree {
+    public:
+        static constexpr i32 null_node = -1;
+
+        /**
+         * @brief Construct an empty tree
+         * @param margin Distance each leaf box is enlarged by on every side
+         * @param displacement_multiplier How far ahead of the motion each leaf box is extended
+         */
+        explicit DynamicAabbTree(float margin = 0.1f, float displacement_multiplier = 2.0f);
+
+        /**
+         * @brief Insert a proxy
+         * @param aabb Tight bounds of the object
+         * @param user_data Value handed back by queries
+         * @return Proxy id
+         */
+        i32 create_proxy(const AABB &aabb, u32 user_data);
+
+        /**
+         * @brief Remove a proxy
+         * @param proxy_id Proxy returned by create_proxy
+         */
+        void destroy_proxy(i32 proxy_id);
+
+        /**
+         * @brief Update a proxy after its object moved
+         * @param proxy_id Proxy to update
+         * @param aabb New tight bounds of the object
+         * @param displacement Motion since the last update, used to predict the next one
+         * @return True if the proxy had to be reinserted
+         */
+        bool move_proxy(i32 proxy_id, const AABB &aabb, const Vector3 &displacement);
+
+        [[nodiscard]] u32 get_user_data(const i32 proxy_id) const { return m_nodes[proxy_id].user_data; }
+        [[nodiscard]] const AABB &get_fat_aabb(const i32 proxy_id) const { return m_nodes[proxy_id].aabb; }
+
+        /**
+         * @brief Get the height of the tree
+         * @return Height of the root node, or 0 if the tree is empty
+         */
+        [[nodiscard]] i32 get_height() const { return m_root == null_node ? 0 : m_nodes[m_root].height; }
+
+        [[nodiscard]] size_t get_proxy_count() const { return m_proxy_count; }
+
+        /**
+         * @brief Remove every proxy while keeping allocated node storage
+         */
+        void clear();
+
+        /**
+         * @brief Visit every proxy whose fat box overlaps a box
+         * @param aabb Query box
+         * @param callback Invoked as bool(u32 user_data); return false to stop
+         */
+        template<typename Callback>
+        void query(const AABB &aabb, Callback &&callback) const {
+            traverse([&aabb](const AABB &node) { return node.intersects(aabb); }, callback);
+        }
+
+        /**
+         * @brief Visit every proxy whose fat box is not fully outside a frustum
+         * @param frustum Query frustum
+         * @param callback Invoked as bool(u32 user_data); return false to stop
+         */
+        template<typename Callback>
+        void query(const Frustum &frustum, Callback &&callback) const {
+            traverse([&frustum](const AABB &node) { return frustum.intersects(node); }, callback);
+        }
+
+        /**
+         * @brief Visit every proxy whose fat box overlaps a sphere
+         * @param center Sphere center
+         * @param radius Sphere radius
+         * @param callback Invoked as bool(u32 user_data); return false to stop
+         */
+        template<typename Callback>
+        void query_sphere(const Vector3 &center, const float radius, Callback &&callback) const {
+            const float radius_squared = radius * radius;
+            traverse([&center, radius_squared](const AABB &node) {
+                const Vector3 closest = clamp(center, node.min, node.max);
+                return closest.distance_squared(center) <= radius_squared;
+            }, callback);
+        }
+
+        /**
+         * @brief Visit proxies along a ray, nearest candidates first
+         *
+         * The callback returns the distance to keep searching up to: return the hit
+         * distance to clip the ray, or the current maximum to ignore the proxy.
+         * Subtrees entered beyond the current maximum are skipped.
+         *
+         * @param origin Ray origin
+         * @param direction Ray direction (need not be normalized; distances are in units of it)
+         * @param max_distance Maximum distance along the ray
+         * @param callback Invoked as float(u32 user_data, float max_distance)
+         */
+        template<typename Callback>
+        void raycast(const Vector3 &origin, const Vector3 &direction, float max_distance,
+                     Callback &&callback) const {
+            if (m_root == null_node) {
+                return;
+            }
+
+            std::array<i32, max_stack_depth> stack{};
+            size_t stack_size = 0;
+            stack[stack_size++] = m_root;
+
+            while (stack_size > 0) {
+                const auto &node = m_nodes[stack[--stack_size]];
+
+                float t_min = 0.0f;
+                float t_max = 0.0f;
+                if (!node.aabb.intersect_ray(origin, direction, t_min, t_max) ||
+                    t_max < 0.0f || t_min > max_distance) {
+                    continue;
+                }
+
+                if (node.is_leaf()) {
+                    max_distance = std::min(max_distance, callback(node.user_data, max_distance));
+                    if (max_distance <= 0.0f) {
+                        return;
+                    }
+                    continue;
+                }
+
+                SOFTCUBE_ASSERT(stack_size + 2 <= max_stack_depth, "DynamicAabbTree stack overflow");
+
+                // Push the farther child first so the nearer one is visited first and
+                // clips the ray as early as possible.
+                const auto &child1 = m_nodes[node.child1];
+                const auto &child2 = m_nodes[node.child2];
+                const float d1 = child1.aabb.center().distance_squared(origin);
+                const float d2 = child2.aabb.center().distance_squared(origin);
+
+                if (d1 < d2) {
+                    stack[stack_size++] = node.child2;
+                    stack[stack_size++] = node.child1;
+                } else {
+                    stack[stack_size++] = node.child1;
+                    stack[stack_size++] = node.child2;
+                }
+            }
+        }
+
+    private:
+        // AVL balancing bounds the height to ~1.44 log2(n), far below this for any realistic n.
+        static constexpr size_t max_stack_depth = 256;
+
+        struct Node {
+            AABB aabb;
+            i32 parent = null_node; // Next free node while on the free list
+            i32 child1 = null_node;
+            i32 child2 = null_node;
+            i32 height = -1; // 0 for leaves, -1 for free nodes
+            u32 user_data = 0;
+
+            [[nodiscard]] bool is_leaf() const { return child1 == null_node; }
+        };
+
+        template<typename Overlap, typename Callback>
+        void traverse(Overlap &&overlap, Callback &callback) const {
+            if (m_root == null_node) {
+                return;
+            }
+
+            std::array<i32, max_stack_depth> stack{};
+            size_t stack_size = 0;
+            stack[stack_size++] = m_root;
+
+            while (stack_size > 0) {
+                const auto &node = m_nodes[stack[--stack_size]];
+                if (!overlap(node.aabb)) {
+                    continue;
+                }
+
+                if (node.is_leaf()) {
+                    if (!callback(node.user_data)) {
+                        return;
+                    }
+                    continue;
+                }
+
+                SOFTCUBE_ASSERT(stack_size + 2 <= max_stack_depth, "DynamicAabbTree stack overflow");
+                stack[stack_size++] = node.child1;
+                stack[stack_size++] = node.child2;
+            }
+        }
+
+        [[nodiscard]] AABB fatten(const AABB &aabb) const;
+
+        i32 allocate_node();
+
+        void free_node(i32 node_id);
+
+        void insert_leaf(i32 leaf);
+
+        void remove_leaf(i32 leaf);
+
+        void refit_ancestors(i32 node_id);
+
+        i32 balance(i32 node_id);
+
+        std::vector<Node> m_nodes;
+        i32 m_root = null_node;
+        i32 m_free_list = null_node;
+        size_t m_proxy_count = 0;
+        float m_margin;
+        float m_displacement_multiplier;
+    };
+}
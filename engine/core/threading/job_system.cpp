@@ -0,0 +1,302 @@
+#include "core/threading/job_system.hpp"
+
+namespace softcube {
+    namespace {
+        struct CurrentThread {
+            const JobSystem *system = nullptr;
+            void *state = nullptr;
+        };
+
+        thread_local CurrentThread t_current;
+    }
+
+    JobSystem::ThreadState::ThreadState(const u32 index, const size_t capacity)
+        : deque(capacity),
+          jobs(std::make_unique<detail::Job[]>(deque.get_capacity())),
+          job_mask(deque.get_capacity() - 1),
+          index(index),
+          random_state(index * 0x9E3779B9u + 1u) {
+    }
+
+    JobSystem::JobSystem() : JobSystem(Config{}) {
+    }
+
+    JobSystem::JobSystem(const Config &config) {
+        u32 worker_count = config.worker_count;
+        if (worker_count == 0) {
+            worker_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        }
+
+        m_threads.reserve(worker_count + 1);
+        for (u32 i = 0; i <= worker_count; ++i) {
+            m_threads.push_back(std::make_unique<ThreadState>(i, config.queue_capacity));
+        }
+
+        t_current = {this, m_threads[0].get()};
+
+        for (u32 i = 1; i <= worker_count; ++i) {
+            auto &state = *m_threads[i];
+            state.thread = std::thread([this, &state] { worker_main(state); });
+        }
+
+        SC_INFO("Job system started with {} workers", worker_count);
+    }
+
+    JobSystem::~JobSystem() {
+        m_running.store(false, std::memory_order_release);
+        {
+            std::scoped_lock lock(m_sleep_mutex);
+            m_wake.notify_all();
+        }
+
+        for (size_t i = 1; i < m_threads.size(); ++i) {
+            if (m_threads[i]->thread.joinable()) {
+                m_threads[i]->thread.join();
+            }
+        }
+
+        // Every worker has stopped, so the deques can be drained from here.
+        size_t discarded = 0;
+        for (const auto &state: m_threads) {
+            while (auto *job = state->deque.pop()) {
+                discard(job);
+                ++discarded;
+            }
+        }
+
+        for (auto *job: m_injected) {
+            discard(job);
+            ++discarded;
+        }
+
+        for (auto *job: m_main_jobs) {
+            discard(job);
+            ++discarded;
+        }
+
+        if (discarded > 0) {
+            SC_WARN("Discarded {} jobs that never ran", discarded);
+        }
+
+        if (t_current.system == this) {
+            t_current = {};
+        }
+    }
+
+    void JobSystem::wait(const JobCounter &counter) {
+        auto *state = get_current_state();
+        const bool main_thread = state && state->index == 0;
+
+        while (!counter.is_done()) {
+            if (main_thread) {
+                run_main_thread_jobs();
+            }
+
+            if (auto *job = find_job(state)) {
+                execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::run_main_thread_jobs() {
+        SOFTCUBE_ASSERT(is_main_thread(), "Main-thread jobs must run on the main thread");
+
+        if (!m_main_pending.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        // Taken as a batch; jobs scheduled by these jobs run on the next call.
+        std::vector<detail::Job *> jobs;
+        {
+            std::scoped_lock lock(m_main_mutex);
+            jobs.swap(m_main_jobs);
+            m_main_pending.store(false, std::memory_order_relaxed);
+        }
+
+        for (auto *job: jobs) {
+            execute(job);
+        }
+    }
+
+    bool JobSystem::is_main_thread() const {
+        return get_current_state() == m_threads[0].get();
+    }
+
+    JobSystem::Stats JobSystem::get_stats() const {
+        Stats stats;
+        for (const auto &state: m_threads) {
+            stats.executed += state->executed.load(std::memory_order_relaxed);
+            stats.stolen += state->stolen.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    JobSystem::ThreadState *JobSystem::get_current_state() const {
+        return t_current.system == this ? static_cast<ThreadState *>(t_current.state) : nullptr;
+    }
+
+    void JobSystem::submit(detail::Job *job) {
+        m_queued.fetch_add(1, std::memory_order_seq_cst);
+
+        if (auto *state = get_current_state()) {
+            if (!state->deque.push(job)) {
+                // Deque full: the caller is producing faster than anyone consumes.
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                execute(job);
+                return;
+            }
+        } else {
+            std::scoped_lock lock(m_injected_mutex);
+            m_injected.push_back(job);
+            m_has_injected.store(true, std::memory_order_release);
+        }
+
+        if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+            std::scoped_lock lock(m_sleep_mutex);
+            m_wake.notify_one();
+        }
+    }
+
+    void JobSystem::add_continuation(JobCounter &dependency, detail::Job *job) {
+        {
+            std::scoped_lock lock(dependency.m_mutex);
+
+            u32 value = dependency.m_value.load(std::memory_order_acquire);
+            while ((value & JobCounter::count_mask) != 0) {
+                if (dependency.m_value.compare_exchange_weak(value, value | JobCounter::continuation_flag,
+                                                             std::memory_order_acq_rel,
+                                                             std::memory_order_acquire)) {
+                    dependency.m_continuations.push_back(job);
+                    return;
+                }
+            }
+        }
+
+        submit(job);
+    }
+
+    void JobSystem::release(JobCounter &counter) {
+        const u32 previous = counter.m_value.fetch_sub(1, std::memory_order_acq_rel);
+        if ((previous & JobCounter::count_mask) != 1 || (previous & JobCounter::continuation_flag) == 0) {
+            return; // The counter may already be gone; do not touch it again
+        }
+
+        std::vector<detail::Job *> continuations;
+        {
+            std::scoped_lock lock(counter.m_mutex);
+            continuations.swap(counter.m_continuations);
+        }
+
+        // Clearing the flag is what lets waiters see the counter as done, so it
+        // must be the last access.
+        counter.m_value.fetch_and(~JobCounter::continuation_flag, std::memory_order_release);
+
+        for (auto *job: continuations) {
+            submit(job);
+        }
+    }
+
+    detail::Job *JobSystem::find_job(ThreadState *state) {
+        if (state) {
+            if (auto *job = state->deque.pop()) {
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        if (m_has_injected.load(std::memory_order_acquire)) {
+            std::scoped_lock lock(m_injected_mutex);
+            if (!m_injected.empty()) {
+                auto *job = m_injected.front();
+                m_injected.pop_front();
+                m_has_injected.store(!m_injected.empty(), std::memory_order_relaxed);
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        const size_t thread_count = m_threads.size();
+        size_t start = 0;
+        if (state) {
+            // xorshift32
+            state->random_state ^= state->random_state << 13;
+            state->random_state ^= state->random_state >> 17;
+            state->random_state ^= state->random_state << 5;
+            start = state->random_state % thread_count;
+        }
+
+        for (size_t i = 0; i < thread_count; ++i) {
+            auto &victim = *m_threads[(start + i) % thread_count];
+            if (&victim == state) {
+                continue;
+            }
+
+            if (auto *job = victim.deque.steal()) {
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                if (state) {
+                    state->stolen.fetch_add(1, std::memory_order_relaxed);
+                }
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::execute(detail::Job *job) {
+        job->invoke(*job);
+        job->destroy(*job);
+
+        auto *counter = job->counter;
+        if (job->heap_allocated) {
+            delete job;
+        } else {
+            job->pending.store(false, std::memory_order_release);
+        }
+
+        if (auto *state = get_current_state()) {
+            state->executed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (counter) {
+            release(*counter);
+        }
+    }
+
+    void JobSystem::discard(detail::Job *job) {
+        job->destroy(*job);
+        if (job->heap_allocated) {
+            delete job;
+        } else {
+            job->pending.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void JobSystem::worker_main(ThreadState &state) {
+        t_current = {this, &state};
+
+        u32 idle_spins = 0;
+        while (m_running.load(std::memory_order_acquire)) {
+            if (auto *job = find_job(&state)) {
+                execute(job);
+                idle_spins = 0;
+                continue;
+            }
+
+            if (++idle_spins < idle_spin_count) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(m_sleep_mutex);
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            m_wake.wait(lock, [this] {
+                return m_queued.load(std::memory_order_seq_cst) > 0 || !m_running.load(std::memory_order_acquire);
+            });
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            idle_spins = 0;
+        }
+    }
+}
@@ -0,0 +1,329 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "core/threading/work_stealing_deque.hpp"
+
+#include <deque>
+
+namespace softcube {
+    class JobCounter;
+
+    namespace detail {
+        /**
+         * @struct Job
+         * @brief A scheduled callable, stored inline when it is small enough
+         */
+        struct Job {
+            static constexpr size_t inline_size = 64;
+
+            void (*invoke)(Job &job) = nullptr;
+            void (*destroy)(Job &job) = nullptr;
+            JobCounter *counter = nullptr;
+            std::atomic<bool> pending{false}; // Set while a ring slot is in use
+            bool heap_allocated = false;
+            alignas(std::max_align_t) std::byte storage[inline_size];
+
+            template<typename F>
+            void set(F &&function) {
+                using Function = std::decay_t<F>;
+
+                if constexpr (sizeof(Function) <= inline_size && alignof(Function) <= alignof(std::max_align_t) &&
+                              std::is_nothrow_move_constructible_v<Function>) {
+                    new(storage) Function(std::forward<F>(function));
+                    invoke = [](Job &job) { (*std::launder(reinterpret_cast<Function *>(job.storage)))(); };
+                    destroy = [](Job &job) { std::launder(reinterpret_cast<Function *>(job.storage))->~Function(); };
+                } else {
+                    auto *boxed = new Function(std::forward<F>(function));
+                    std::memcpy(storage, &boxed, sizeof(boxed));
+                    invoke = [](Job &job) { (*unbox<Function>(job))(); };
+                    destroy = [](Job &job) { delete unbox<Function>(job); };
+                }
+            }
+
+        private:
+            template<typename Function>
+            static Function *unbox(const Job &job) {
+                Function *function = nullptr;
+                std::memcpy(&function, job.storage, sizeof(function));
+                return function;
+            }
+        };
+    }
+
+    /**
+     * @class JobCounter
+     * @brief Number of unfinished jobs in a batch, used to wait on it or to chain work after it
+     *
+     * Pass the same counter to every job of a batch, then wait() on it or
+     * schedule_after() it. A counter may be reused once it is done. It must
+     * outlive the jobs and continuations that refer to it.
+     */
+    class JobCounter {
+    public:
+        JobCounter() = default;
+
+        JobCounter(const JobCounter &) = delete;
+
+        JobCounter &operator=(const JobCounter &) = delete;
+
+        /**
+         * @brief Check whether every job and pending continuation hand-off has finished
+         */
+        [[nodiscard]] bool is_done() const { return m_value.load(std::memory_order_acquire) == 0; }
+
+        /**
+         * @brief Get the number of unfinished jobs
+         */
+        [[nodiscard]] u32 get_value() const { return m_value.load(std::memory_order_relaxed) & count_mask; }
+
+    private:
+        friend class JobSystem;
+
+        // The top bit marks registered continuations so the common release path
+        // never has to look at the mutex or the list.
+        static constexpr u32 continuation_flag = 1u << 31;
+        static constexpr u32 count_mask = continuation_flag - 1;
+
+        std::atomic<u32> m_value{0};
+        std::mutex m_mutex;
+        std::vector<detail::Job *> m_continuations;
+    };
+
+    /**
+     * @class JobSystem
+     * @brief Work-stealing job scheduler with one deque per thread
+     *
+     * The thread that constructs the system is the main thread and takes part
+     * in the work whenever it waits. Every other thread is a background worker
+     * that pops from its own deque and otherwise steals from a random victim.
+     * Jobs are allocated from a per-thread ring, so scheduling does not allocate
+     * unless the callable is larger than the inline storage or the ring slot is
+     * still in flight.
+     *
+     * Jobs scheduled from threads the system does not own go through a shared,
+     * locked queue. Jobs still queued when the system is destroyed are discarded.
+     */
+    class JobSystem {
+        SC_LOG_GROUP(CORE::JOB_SYSTEM);
+
+    public:
+        /**
+         * @struct Config
+         * @brief Settings of a job system
+         */
+        struct Config {
+            u32 worker_count = 0; // Background workers; 0 uses one per hardware thread besides the main thread
+            size_t queue_capacity = 4096; // Per-thread deque and job ring size
+        };
+
+        /**
+         * @struct Stats
+         * @brief Totals since the system was created
+         */
+        struct Stats {
+            u64 executed = 0;
+            u64 stolen = 0;
+        };
+
+        /**
+         * @brief Start one worker per spare hardware thread; the calling thread becomes the main thread
+         */
+        JobSystem();
+
+        /**
+         * @brief Start the workers; the calling thread becomes the main thread
+         * @param config Job system settings
+         */
+        explicit JobSystem(const Config &config);
+
+        ~JobSystem();
+
+        JobSystem(const JobSystem &) = delete;
+
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        /**
+         * @brief Run a callable on any thread
+         * @param function Callable invoked as void()
+         * @param counter Counter incremented now and decremented when the job finishes
+         */
+        template<typename F>
+        void schedule(F &&function, JobCounter *counter = nullptr) {
+            submit(allocate(std::forward<F>(function), counter));
+        }
+
+        /**
+         * @brief Run a callable on any thread once every job of another counter has finished
+         * @param dependency Counter to wait for; may already be done
+         * @param function Callable invoked as void()
+         * @param counter Counter incremented now and decremented when the job finishes
+         */
+        template<typename F>
+        void schedule_after(JobCounter &dependency, F &&function, JobCounter *counter = nullptr) {
+            add_continuation(dependency, allocate(std::forward<F>(function), counter));
+        }
+
+        /**
+         * @brief Run a callable on the main thread, for work touching the renderer, window or ImGui
+         *
+         * Main-thread jobs run from run_main_thread_jobs() and while the main
+         * thread waits on a counter.
+         *
+         * @param function Callable invoked as void()
+         * @param counter Counter incremented now and decremented when the job finishes
+         */
+        template<typename F>
+        void schedule_main_thread(F &&function, JobCounter *counter = nullptr) {
+            auto *job = allocate(std::forward<F>(function), counter);
+
+            std::scoped_lock lock(m_main_mutex);
+            m_main_jobs.push_back(job);
+            m_main_pending.store(true, std::memory_order_release);
+        }
+
+        /**
+         * @brief Split a range across all threads and wait for it
+         *
+         * The range is split lazily: each job hands the upper half of its range
+         * to thieves and keeps halving until it reaches the grain size, so an idle
+         * thread always finds large pieces to steal. The calling thread helps and
+         * nested calls from inside jobs are allowed.
+         *
+         * @param begin First index
+         * @param end One past the last index
+         * @param function Callable invoked as void(size_t begin, size_t end) on sub-ranges
+         * @param grain Smallest range worth a job; 0 picks one from the range size and thread count
+         */
+        template<typename F>
+        void parallel_for(const size_t begin, const size_t end, F &&function, size_t grain = 0) {
+            if (begin >= end) {
+                return;
+            }
+
+            const size_t count = end - begin;
+            if (grain == 0) {
+                grain = std::max<size_t>(1, count / (get_thread_count() * chunks_per_thread));
+            }
+
+            if (count <= grain || get_worker_count() == 0) {
+                function(begin, end);
+                return;
+            }
+
+            JobCounter counter;
+            split_range(begin, end, grain, function, counter);
+            wait(counter);
+        }
+
+        /**
+         * @brief Block until a counter is done, running other jobs meanwhile
+         * @param counter Counter to wait for
+         */
+        void wait(const JobCounter &counter);
+
+        /**
+         * @brief Run every queued main-thread job; main thread only
+         */
+        void run_main_thread_jobs();
+
+        [[nodiscard]] u32 get_worker_count() const { return static_cast<u32>(m_threads.size() - 1); }
+
+        [[nodiscard]] u32 get_thread_count() const { return static_cast<u32>(m_threads.size()); }
+
+        [[nodiscard]] bool is_main_thread() const;
+
+        [[nodiscard]] Stats get_stats() const;
+
+    private:
+        static constexpr size_t chunks_per_thread = 8;
+        static constexpr u32 idle_spin_count = 64;
+
+        struct alignas(64) ThreadState {
+            ThreadState(u32 index, size_t capacity);
+
+            WorkStealingDeque<detail::Job> deque;
+            std::unique_ptr<detail::Job[]> jobs;
+            size_t job_mask;
+            size_t next_job = 0;
+            u32 index;
+            u32 random_state;
+            std::atomic<u64> executed{0};
+            std::atomic<u64> stolen{0};
+            std::thread thread;
+        };
+
+        template<typename F>
+        detail::Job *allocate(F &&function, JobCounter *counter) {
+            detail::Job *job = nullptr;
+
+            if (auto *state = get_current_state()) {
+                auto &slot = state->jobs[state->next_job++ & state->job_mask];
+                if (!slot.pending.load(std::memory_order_acquire)) {
+                    job = &slot;
+                    job->heap_allocated = false;
+                }
+            }
+
+            if (!job) {
+                job = new detail::Job;
+                job->heap_allocated = true;
+            }
+
+            job->pending.store(true, std::memory_order_relaxed);
+            job->set(std::forward<F>(function));
+            job->counter = counter;
+
+            if (counter) {
+                counter->m_value.fetch_add(1, std::memory_order_acq_rel);
+            }
+
+            return job;
+        }
+
+        template<typename F>
+        void split_range(const size_t begin, size_t end, const size_t grain, F &function, JobCounter &counter) {
+            while (end - begin > grain) {
+                const size_t middle = begin + (end - begin) / 2;
+                schedule([this, middle, end, grain, &function, &counter] {
+                    split_range(middle, end, grain, function, counter);
+                }, &counter);
+                end = middle;
+            }
+
+            function(begin, end);
+        }
+
+        [[nodiscard]] ThreadState *get_current_state() const;
+
+        void submit(detail::Job *job);
+
+        void add_continuation(JobCounter &dependency, detail::Job *job);
+
+        void release(JobCounter &counter);
+
+        detail::Job *find_job(ThreadState *state);
+
+        void execute(detail::Job *job);
+
+        static void discard(detail::Job *job);
+
+        void worker_main(ThreadState &state);
+
+        std::vector<std::unique_ptr<ThreadState> > m_threads; // [0] is the main thread
+
+        std::atomic<bool> m_running{true};
+        std::atomic<i64> m_queued{0}; // Jobs pushed but not yet taken, for waking workers
+
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_wake;
+        std::atomic<u32> m_sleeping{0};
+
+        std::mutex m_injected_mutex;
+        std::deque<detail::Job *> m_injected; // Jobs scheduled from threads the system does not own
+        std::atomic<bool> m_has_injected{false};
+
+        std::mutex m_main_mutex;
+        std::vector<detail::Job *> m_main_jobs;
+        std::atomic<bool> m_main_pending{false};
+    };
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "core/common.hpp"
+
+#include <bit>
+
+namespace softcube {
+    /**
+     * @class WorkStealingDeque
+     * @brief Fixed-capacity Chase-Lev deque of pointers
+     *
+     * The owning thread pushes and pops at the bottom without locks or atomic
+     * read-modify-write operations, except when racing a thief for the last
+     * element. Any other thread may steal from the top. Memory orderings follow
+     * Lê, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for
+     * Weak Memory Models" (PPoPP 2013).
+     *
+     * The buffer never grows; push() reports a full deque and the caller decides
+     * what to do with the item.
+     *
+     * @tparam T Pointee type
+     */
+    template<typename T>
+    class WorkStealingDeque {
+    public:
+        /**
+         * @brief Construct an empty deque
+         * @param capacity Maximum number of items; rounded up to a power of two
+         */
+        explicit WorkStealingDeque(const size_t capacity = 4096)
+            : m_capacity(std::bit_ceil(std::max<size_t>(capacity, 2))),
+              m_mask(static_cast<i64>(m_capacity) - 1),
+              m_buffer(std::make_unique<std::atomic<T *>[]>(m_capacity)) {
+        }
+
+        WorkStealingDeque(const WorkStealingDeque &) = delete;
+
+        WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+        /**
+         * @brief Push an item at the bottom; owner thread only
+         * @param item Item to push
+         * @return False if the deque is full
+         */
+        bool push(T *item) {
+            const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+            const i64 top = m_top.load(std::memory_order_acquire);
+            if (bottom - top >= static_cast<i64>(m_capacity)) {
+                return false;
+            }
+
+            // A release store rather than the paper's release fence; same guarantee,
+            // and visible to ThreadSanitizer.
+            m_buffer[bottom & m_mask].store(item, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pop the most recently pushed item; owner thread only
+         * @return The item, or nullptr if the deque is empty
+         */
+        T *pop() {
+            const i64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            i64 top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T *item = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+            if (top == bottom) {
+                // Last item; a thief may be taking it at the same time.
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        /**
+         * @brief Take the oldest item; any thread
+         * @return The item, or nullptr if the deque is empty or another thread won the race
+         */
+        T *steal() {
+            i64 top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const i64 bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) {
+                return nullptr;
+            }
+
+            T *item = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)) {
+                return nullptr;
+            }
+
+            return item;
+        }
+
+        /**
+         * @brief Approximate number of items; exact only when no other thread is using the deque
+         */
+        [[nodiscard]] size_t size() const {
+            const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+            const i64 top = m_top.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+        }
+
+        [[nodiscard]] size_t get_capacity() const { return m_capacity; }
+
+    private:
+        // Owner and thieves write different ends; keep them on separate cache lines.
+        alignas(64) std::atomic<i64> m_top{0};
+        alignas(64) std::atomic<i64> m_bottom{0};
+
+        size_t m_capacity;
+        i64 m_mask;
+        std::unique_ptr<std::atomic<T *>[]> m_buffer;
+    };
+}
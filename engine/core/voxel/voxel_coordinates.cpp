@@ -0,0 +1,25 @@
+#include "voxel_coordinates.hpp"
+#include "world_position.hpp"
+
+namespace softcube::voxel {
+    // Shift and mask must split negative coordinates the same way floor division does.
+    static_assert(block_to_chunk(IVector3(-1, 0, 15)) == IVector3(-1, 0, 0));
+    static_assert(block_to_local(IVector3(-1, 0, 15)) == IVector3(chunk_size - 1, 0, 15));
+    static_assert(block_to_chunk(IVector3(-33, 33, -16)) == floor_div(IVector3(-33, 33, -16), chunk_size));
+    static_assert(block_to_local(IVector3(-33, 33, -16)) == floor_mod(IVector3(-33, 33, -16), chunk_size));
+    static_assert(chunk_to_block(block_to_chunk(IVector3(-33, 33, -16)), block_to_local(IVector3(-33, 33, -16))) ==
+                  IVector3(-33, 33, -16));
+
+    static_assert(world_to_block(Vector3(-0.25f, 0.0f, 15.75f)) == IVector3(-1, 0, 15));
+
+    static_assert(local_to_index(IVector3::zero()) == 0);
+    static_assert(local_to_index(IVector3(chunk_size - 1)) == chunk_volume - 1);
+    static_assert(index_to_local(local_to_index(IVector3(3, 9, 14))) == IVector3(3, 9, 14));
+
+    static_assert(WorldPosition(IVector3::zero(), Vector3(-0.5f, 16.0f, 40.25f)).normalized() ==
+                  WorldPosition(IVector3(-1, 1, 2), Vector3(15.5f, 0.0f, 8.25f)));
+    static_assert(WorldPosition::from_block(IVector3(-1, 17, 0)) ==
+                  WorldPosition(IVector3(-1, 1, 0), Vector3(15.0f, 1.0f, 0.0f)));
+    static_assert(WorldPosition(IVector3(100000, 0, 0), Vector3(0.25f, 0, 0)).relative_to(
+                      WorldPosition(IVector3(99999, 0, 0), Vector3(15.75f, 0, 0))) == Vector3(0.5f, 0.0f, 0.0f));
+}
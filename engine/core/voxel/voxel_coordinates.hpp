@@ -0,0 +1,64 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/math/ivector3.hpp"
+
+namespace softcube::voxel {
+    /**
+     * @brief Blocks along each edge of a cubic chunk, as a power of two
+     *
+     * Keeping it a power of two turns the world to chunk split into an
+     * arithmetic shift and a mask, which round toward negative infinity on
+     * negative coordinates the same way floor_div and floor_mod do.
+     */
+    constexpr i32 chunk_size_log2 = 4;
+    constexpr i32 chunk_size = 1 << chunk_size_log2;
+    constexpr i32 chunk_volume = chunk_size * chunk_size * chunk_size;
+
+    /**
+     * @brief Block containing a world-space position; blocks are one unit wide
+     */
+    constexpr IVector3 world_to_block(const Vector3 &position) {
+        return IVector3::floor(position);
+    }
+
+    /**
+     * @brief Chunk containing a block
+     */
+    constexpr IVector3 block_to_chunk(const IVector3 &block) {
+        return IVector3(block.x >> chunk_size_log2, block.y >> chunk_size_log2, block.z >> chunk_size_log2);
+    }
+
+    /**
+     * @brief Position of a block inside its chunk, each component in [0, chunk_size)
+     */
+    constexpr IVector3 block_to_local(const IVector3 &block) {
+        constexpr i32 mask = chunk_size - 1;
+        return IVector3(block.x & mask, block.y & mask, block.z & mask);
+    }
+
+    /**
+     * @brief Block at a local position inside a chunk; inverse of block_to_chunk and block_to_local
+     */
+    constexpr IVector3 chunk_to_block(const IVector3 &chunk, const IVector3 &local = IVector3::zero()) {
+        return IVector3(
+            chunk.x * chunk_size + local.x,
+            chunk.y * chunk_size + local.y,
+            chunk.z * chunk_size + local.z
+        );
+    }
+
+    /**
+     * @brief Index of a local position in a chunk's block array, x fastest, then z, then y
+     */
+    constexpr i32 local_to_index(const IVector3 &local) {
+        return (local.y << chunk_size_log2 | local.z) << chunk_size_log2 | local.x;
+    }
+
+    /**
+     * @brief Local position of an index in a chunk's block array
+     */
+    constexpr IVector3 index_to_local(const i32 index) {
+        constexpr i32 mask = chunk_size - 1;
+        return IVector3(index & mask, index >> 2 * chunk_size_log2, index >> chunk_size_log2 & mask);
+    }
+}
@@ -0,0 +1,41 @@
+#include "voxel_raycast.hpp"
+
+namespace softcube::voxel {
+    VoxelRay::VoxelRay(const Vector3 &origin, const Vector3 &direction, const i32 cell_size_log2)
+        : m_origin{origin.x, origin.y, origin.z},
+          m_inverse_direction{},
+          m_cell_size(static_cast<float>(1 << cell_size_log2)),
+          m_cell{},
+          m_step{},
+          m_boundary{} {
+        const IVector3 block = world_to_block(origin);
+        m_cell = {block.x >> cell_size_log2, block.y >> cell_size_log2, block.z >> cell_size_log2};
+
+        const std::array components{direction.x, direction.y, direction.z};
+        int dominant = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            m_step[axis] = (components[axis] > 0.0f) - (components[axis] < 0.0f);
+            if (m_step[axis] != 0) {
+                m_inverse_direction[axis] = 1.0f / components[axis];
+            }
+            if (std::abs(components[axis]) > std::abs(components[dominant])) {
+                dominant = axis;
+            }
+        }
+        m_face = entry_face(dominant);
+        compute_boundaries();
+    }
+
+    void VoxelRay::enter(const IVector3 &cell, const float distance, const Face face) {
+        m_cell = {cell.x, cell.y, cell.z};
+        m_distance = distance;
+        m_face = face;
+        compute_boundaries();
+    }
+
+    void VoxelRay::compute_boundaries() {
+        for (int axis = 0; axis < 3; ++axis) {
+            m_boundary[axis] = m_step[axis] != 0 ? boundary(axis) : std::numeric_limits<float>::infinity();
+        }
+    }
+}
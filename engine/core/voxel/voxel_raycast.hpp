@@ -0,0 +1,224 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/math/vector3.hpp"
+#include "core/math/ivector3.hpp"
+#include "core/voxel/voxel_coordinates.hpp"
+#include "core/voxel/voxel_tables.hpp"
+
+#include <span>
+
+namespace softcube::voxel {
+    /**
+     * @struct VoxelRayHit
+     * @brief A block crossed by a ray
+     */
+    struct VoxelRayHit {
+        IVector3 block;
+        Face face; // Face of the block the ray entered through; block + face_offsets[face] is the cell before it
+        float distance; // Along the ray where it enters the block, in units of the direction
+    };
+
+    /**
+     * @class VoxelRay
+     * @brief Amanatides-Woo walk over the cells of a grid that a ray crosses, in order
+     *
+     * Cells are 2^cell_size_log2 blocks wide, so the same walker steps
+     * through blocks (0) or whole chunks (chunk_size_log2). The first cell
+     * is the one containing the origin, reported at distance 0 with the face
+     * the ray would have entered through along its dominant axis.
+     */
+    class VoxelRay {
+    public:
+        /**
+         * @param origin Ray origin
+         * @param direction Ray direction (need not be normalized; distances are in units of it)
+         * @param cell_size_log2 Cell width in blocks, as a power of two
+         */
+        VoxelRay(const Vector3 &origin, const Vector3 &direction, i32 cell_size_log2 = 0);
+
+        [[nodiscard]] IVector3 get_cell() const { return IVector3(m_cell[0], m_cell[1], m_cell[2]); }
+
+        [[nodiscard]] Face get_face() const { return m_face; }
+
+        /**
+         * @brief Distance at which the ray entered the current cell
+         */
+        [[nodiscard]] float get_distance() const { return m_distance; }
+
+        /**
+         * @brief Distance at which the ray leaves the current cell
+         */
+        [[nodiscard]] float get_exit_distance() const {
+            return std::min(m_boundary[0], std::min(m_boundary[1], m_boundary[2]));
+        }
+
+        /**
+         * @brief Move to the next cell along the ray
+         *
+         * Crosses the nearest cell boundary; ties go to x, then y, then z. A
+         * zero direction never leaves the first cell and the distance becomes
+         * infinite.
+         */
+        void step() {
+            const int axis = m_boundary[0] <= m_boundary[1]
+                                 ? (m_boundary[0] <= m_boundary[2] ? 0 : 2)
+                                 : (m_boundary[1] <= m_boundary[2] ? 1 : 2);
+            m_cell[axis] += m_step[axis];
+            m_distance = std::max(m_distance, m_boundary[axis]);
+            m_boundary[axis] = boundary(axis);
+            m_face = entry_face(axis);
+        }
+
+        /**
+         * @brief Continue the walk from a given cell, e.g. one a coarser walk over chunks reached
+         *
+         * @param cell Cell the ray is entering
+         * @param distance Distance at which it enters
+         * @param face Face it enters through
+         */
+        void enter(const IVector3 &cell, float distance, Face face);
+
+    private:
+        [[nodiscard]] Face entry_face(const int axis) const {
+            // Moving towards +axis enters through the cell's negative face on that axis.
+            return static_cast<Face>(axis * 2 + (m_step[axis] > 0 ? 1 : 0));
+        }
+
+        /**
+         * @brief Distance to the far boundary of the current cell on an axis the ray moves along
+         *
+         * Computed from the cell index rather than accumulated, so the walk
+         * does not drift over long rays and a walk resumed with enter() makes
+         * the same choices as one that stepped there block by block.
+         */
+        [[nodiscard]] float boundary(const int axis) const {
+            const float edge = static_cast<float>(m_cell[axis] + (m_step[axis] > 0 ? 1 : 0)) * m_cell_size;
+            return (edge - m_origin[axis]) * m_inverse_direction[axis];
+        }
+
+        void compute_boundaries();
+
+        std::array<float, 3> m_origin;
+        std::array<float, 3> m_inverse_direction; // Unused on axes the ray does not move along
+        float m_cell_size;
+
+        std::array<i32, 3> m_cell;
+        std::array<i32, 3> m_step; // -1, 0 or 1 per axis
+        std::array<float, 3> m_boundary; // Distance to the next cell boundary on each axis
+        float m_distance = 0.0f;
+        Face m_face = Face::PositiveX;
+    };
+
+    /**
+     * @brief Visit blocks along a ray, nearest first, until the callback accepts one
+     *
+     * @param origin Ray origin
+     * @param direction Ray direction (need not be normalized; distances are in units of it)
+     * @param max_distance Maximum distance along the ray; must be finite
+     * @param visit Invoked as bool(const VoxelRayHit &) for each block; return true to stop there
+     * @return The block the callback stopped at, if any
+     */
+    template<typename Visit>
+    std::optional<VoxelRayHit> raycast(const Vector3 &origin, const Vector3 &direction, const float max_distance,
+                                       Visit &&visit) {
+        VoxelRay ray(origin, direction);
+        while (ray.get_distance() <= max_distance) {
+            const VoxelRayHit candidate{ray.get_cell(), ray.get_face(), ray.get_distance()};
+            if (visit(candidate)) {
+                return candidate;
+            }
+            ray.step();
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Visit blocks along a ray, stepping over whole chunks the world reports as empty
+     *
+     * The ray is first walked chunk by chunk; only chunks that may hold
+     * solid blocks are walked block by block, so a pick across open sky
+     * costs a few chunk lookups instead of one per block.
+     *
+     * @param origin Ray origin
+     * @param direction Ray direction (need not be normalized; distances are in units of it)
+     * @param max_distance Maximum distance along the ray; must be finite
+     * @param is_chunk_empty Invoked as bool(const IVector3 &chunk); true skips the chunk
+     * @param visit Invoked as bool(const VoxelRayHit &) for each block; return true to stop there
+     * @return The block the callback stopped at, if any
+     */
+    template<typename IsChunkEmpty, typename Visit>
+    std::optional<VoxelRayHit> raycast(const Vector3 &origin, const Vector3 &direction, const float max_distance,
+                                       IsChunkEmpty &&is_chunk_empty, Visit &&visit) {
+        VoxelRay chunks(origin, direction, chunk_size_log2);
+        VoxelRay blocks(origin, direction);
+        bool first = true;
+
+        while (chunks.get_distance() <= max_distance) {
+            const IVector3 chunk = chunks.get_cell();
+            if (!is_chunk_empty(chunk)) {
+                if (!first) {
+                    // Start on the block where the ray crosses into the chunk, clamped into
+                    // it in case rounding put the crossing point just outside.
+                    const IVector3 low = chunk_to_block(chunk);
+                    const IVector3 block = min(max(world_to_block(origin + direction * chunks.get_distance()), low),
+                                               low + IVector3(chunk_size - 1));
+                    blocks.enter(block, chunks.get_distance(), chunks.get_face());
+                }
+
+                while (block_to_chunk(blocks.get_cell()) == chunk) {
+                    if (blocks.get_distance() > max_distance) {
+                        return std::nullopt;
+                    }
+                    const VoxelRayHit candidate{blocks.get_cell(), blocks.get_face(), blocks.get_distance()};
+                    if (visit(candidate)) {
+                        return candidate;
+                    }
+                    blocks.step();
+                }
+            }
+            first = false;
+            chunks.step();
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Whether no opaque block lies on the segment between two points
+     *
+     * @param from Start of the segment, e.g. an eye position
+     * @param to End of the segment
+     * @param is_chunk_empty Invoked as bool(const IVector3 &chunk); true skips the chunk
+     * @param is_opaque Invoked as bool(const IVector3 &block)
+     */
+    template<typename IsChunkEmpty, typename IsOpaque>
+    bool has_line_of_sight(const Vector3 &from, const Vector3 &to, IsChunkEmpty &&is_chunk_empty,
+                           IsOpaque &&is_opaque) {
+        return !raycast(from, to - from, 1.0f, is_chunk_empty, [&is_opaque](const VoxelRayHit &hit) {
+            return is_opaque(hit.block);
+        });
+    }
+
+    /**
+     * @brief Line of sight for many segments at once, e.g. every AI agent against its target
+     *
+     * Callbacks run on the calling thread; to spread a large batch over
+     * workers, hand sub-spans to JobSystem::parallel_for with callbacks that
+     * are safe to call concurrently.
+     *
+     * @param from Start of each segment
+     * @param to End of each segment, same count as from
+     * @param visible Output, one flag per segment
+     * @param is_chunk_empty Invoked as bool(const IVector3 &chunk); true skips the chunk
+     * @param is_opaque Invoked as bool(const IVector3 &block)
+     */
+    template<typename IsChunkEmpty, typename IsOpaque>
+    void line_of_sight(const std::span<const Vector3> from, const std::span<const Vector3> to,
+                       const std::span<bool> visible, IsChunkEmpty &&is_chunk_empty, IsOpaque &&is_opaque) {
+        SOFTCUBE_ASSERT(from.size() == to.size() && from.size() == visible.size(),
+                        "Line of sight batches need one end point and one output per segment");
+
+        for (size_t i = 0; i < from.size(); ++i) {
+            visible[i] = has_line_of_sight(from[i], to[i], is_chunk_empty, is_opaque);
+        }
+    }
+}
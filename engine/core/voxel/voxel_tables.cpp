@@ -0,0 +1,100 @@
+#include "voxel_tables.hpp"
+
+// The tables are generated at compile time; these checks pin down the
+// properties the mesher relies on, so a bad edit fails the build.
+namespace softcube::voxel {
+    namespace {
+        constexpr bool bases_are_right_handed() {
+            for (const auto &[normal, u, v]: detail::face_bases) {
+                if (u.cross(v) != normal) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr bool opposite_faces_pair_up() {
+            for (size_t face = 0; face < face_count; face += 2) {
+                if (face_offsets[face] + face_offsets[face + 1] != IVector3::zero()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr bool corners_lie_on_their_face() {
+            for (size_t face = 0; face < face_count; ++face) {
+                const IVector3 normal = face_offsets[face];
+                // The face plane of the unit voxel is at 1 along a positive normal and 0 along a negative one.
+                const i32 plane = normal.dot(normal) == normal.dot(IVector3::one()) ? 1 : 0;
+                for (const auto &corner: face_corners[face]) {
+                    if (std::abs(corner.dot(normal)) != plane) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        constexpr bool corners_wind_counter_clockwise() {
+            for (size_t face = 0; face < face_count; ++face) {
+                const auto &corners = face_corners[face];
+                for (size_t i = 0; i < quad_indices.size(); i += 3) {
+                    const Vector3 a = corners[quad_indices[i]].to_vector3();
+                    const Vector3 b = corners[quad_indices[i + 1]].to_vector3();
+                    const Vector3 c = corners[quad_indices[i + 2]].to_vector3();
+                    if ((b - a).cross(c - a).dot(face_normals[face]) <= 0.0f) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        constexpr bool neighbor_offsets_are_unique() {
+            for (size_t i = 0; i < neighbor_offsets.size(); ++i) {
+                if (neighbor_offsets[i] == IVector3::zero()) {
+                    return false;
+                }
+                for (size_t j = i + 1; j < neighbor_offsets.size(); ++j) {
+                    if (neighbor_offsets[i] == neighbor_offsets[j]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        constexpr bool ao_neighbors_are_in_front() {
+            for (size_t face = 0; face < face_count; ++face) {
+                for (const auto &neighbors: ao_neighbors[face]) {
+                    for (const auto &neighbor: neighbors) {
+                        if (neighbor.dot(face_offsets[face]) != 1) {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    static_assert(bases_are_right_handed());
+    static_assert(opposite_faces_pair_up());
+    static_assert(corners_lie_on_their_face());
+    static_assert(corners_wind_counter_clockwise());
+    static_assert(neighbor_offsets_are_unique());
+    static_assert(ao_neighbors_are_in_front());
+
+    static_assert(face_offsets[face_index(Face::NegativeY)] == IVector3{0, -1, 0});
+    static_assert(face_normals[face_index(Face::PositiveZ)] == Vector3(0.0f, 0.0f, 1.0f));
+    static_assert(centered_face_corners[face_index(Face::PositiveZ)][0] == Vector3(-0.5f, -0.5f, 0.5f));
+    static_assert(cube_indices[6] == 4 && cube_indices[35] == 23);
+
+    static_assert(ambient_occlusion(false, false, false) == 3);
+    static_assert(ambient_occlusion(false, false, true) == 2);
+    static_assert(ambient_occlusion(true, false, true) == 1);
+    static_assert(ambient_occlusion(true, true, false) == 0);
+    static_assert(!should_flip_quad({3, 3, 3, 3}));
+    static_assert(should_flip_quad({0, 3, 3, 3}));
+}
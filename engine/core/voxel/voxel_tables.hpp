@@ -0,0 +1,221 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/math/ivector3.hpp"
+
+#include <array>
+
+namespace softcube::voxel {
+    /**
+     * @brief Face of a voxel, in the order every per-face table uses
+     */
+    enum class Face : u8 {
+        PositiveX,
+        NegativeX,
+        PositiveY,
+        NegativeY,
+        PositiveZ,
+        NegativeZ
+    };
+
+    constexpr size_t face_count = 6;
+
+    constexpr size_t face_index(const Face face) { return static_cast<size_t>(face); }
+
+    namespace detail {
+        /**
+         * @brief Outward normal and in-plane axes of a face
+         *
+         * u x v equals the normal, so corners visited (-u-v, +u-v, +u+v, -u+v)
+         * wind counter-clockwise seen from outside the voxel.
+         */
+        struct FaceBasis {
+            IVector3 normal;
+            IVector3 u;
+            IVector3 v;
+        };
+
+        constexpr std::array<FaceBasis, face_count> face_bases = {{
+            {{1, 0, 0}, {0, 0, -1}, {0, 1, 0}},
+            {{-1, 0, 0}, {0, 0, 1}, {0, 1, 0}},
+            {{0, 1, 0}, {1, 0, 0}, {0, 0, -1}},
+            {{0, -1, 0}, {1, 0, 0}, {0, 0, 1}},
+            {{0, 0, 1}, {1, 0, 0}, {0, 1, 0}},
+            {{0, 0, -1}, {-1, 0, 0}, {0, 1, 0}}
+        }};
+
+        // Signs of u and v at each corner of a face quad.
+        constexpr std::array<std::array<i32, 2>, 4> corner_signs = {{{-1, -1}, {1, -1}, {1, 1}, {-1, 1}}};
+
+        constexpr std::array<IVector3, face_count> make_face_offsets() {
+            std::array<IVector3, face_count> offsets{};
+            for (size_t face = 0; face < face_count; ++face) {
+                offsets[face] = face_bases[face].normal;
+            }
+            return offsets;
+        }
+
+        constexpr std::array<std::array<IVector3, 4>, face_count> make_face_corners() {
+            std::array<std::array<IVector3, 4>, face_count> corners{};
+            for (size_t face = 0; face < face_count; ++face) {
+                const auto &[normal, u, v] = face_bases[face];
+                for (size_t corner = 0; corner < 4; ++corner) {
+                    // Twice the corner relative to the voxel center is normal +- u +- v,
+                    // which has components of -1 or 1; map those to 0 or 1.
+                    const IVector3 doubled = normal + u * corner_signs[corner][0] + v * corner_signs[corner][1];
+                    corners[face][corner] = {(doubled.x + 1) / 2, (doubled.y + 1) / 2, (doubled.z + 1) / 2};
+                }
+            }
+            return corners;
+        }
+
+        constexpr std::array<IVector3, 26> make_neighbor_offsets() {
+            std::array<IVector3, 26> offsets{};
+            size_t count = 0;
+
+            // Faces first so the first six entries line up with Face, then edges, then corners.
+            for (const auto &basis: face_bases) {
+                offsets[count++] = basis.normal;
+            }
+            for (i32 axes = 2; axes <= 3; ++axes) {
+                for (i32 x = -1; x <= 1; ++x) {
+                    for (i32 y = -1; y <= 1; ++y) {
+                        for (i32 z = -1; z <= 1; ++z) {
+                            if ((x != 0) + (y != 0) + (z != 0) == axes) {
+                                offsets[count++] = {x, y, z};
+                            }
+                        }
+                    }
+                }
+            }
+            return offsets;
+        }
+
+        constexpr std::array<std::array<std::array<IVector3, 3>, 4>, face_count> make_ao_neighbors() {
+            std::array<std::array<std::array<IVector3, 3>, 4>, face_count> neighbors{};
+            for (size_t face = 0; face < face_count; ++face) {
+                const auto &[normal, u, v] = face_bases[face];
+                for (size_t corner = 0; corner < 4; ++corner) {
+                    const IVector3 side1 = u * corner_signs[corner][0];
+                    const IVector3 side2 = v * corner_signs[corner][1];
+                    neighbors[face][corner] = {normal + side1, normal + side2, normal + side1 + side2};
+                }
+            }
+            return neighbors;
+        }
+
+        constexpr std::array<u8, 8> make_ao_levels() {
+            std::array<u8, 8> levels{};
+            for (u8 mask = 0; mask < 8; ++mask) {
+                const bool side1 = mask & 1;
+                const bool side2 = mask & 2;
+                const bool corner = mask & 4;
+                // Two solid sides hide the corner completely, whatever the corner block is.
+                levels[mask] = side1 && side2 ? 0 : static_cast<u8>(3 - side1 - side2 - corner);
+            }
+            return levels;
+        }
+    }
+
+    /**
+     * @brief Offset to the voxel across each face
+     */
+    constexpr std::array<IVector3, face_count> face_offsets = detail::make_face_offsets();
+
+    /**
+     * @brief Outward unit normal of each face
+     */
+    constexpr std::array<Vector3, face_count> face_normals = [] {
+        std::array<Vector3, face_count> normals{};
+        for (size_t face = 0; face < face_count; ++face) {
+            normals[face] = face_offsets[face].to_vector3();
+        }
+        return normals;
+    }();
+
+    /**
+     * @brief Corners of each face of the unit voxel [0, 1]^3, counter-clockwise seen from outside
+     *
+     * Add a block position to get the corners of that block's face.
+     */
+    constexpr std::array<std::array<IVector3, 4>, face_count> face_corners = detail::make_face_corners();
+
+    /**
+     * @brief Corners of each face of a unit cube centered on the origin, counter-clockwise seen from outside
+     */
+    constexpr std::array<std::array<Vector3, 4>, face_count> centered_face_corners = [] {
+        std::array<std::array<Vector3, 4>, face_count> corners{};
+        for (size_t face = 0; face < face_count; ++face) {
+            for (size_t corner = 0; corner < 4; ++corner) {
+                corners[face][corner] = face_corners[face][corner].to_vector3() - Vector3(0.5f, 0.5f, 0.5f);
+            }
+        }
+        return corners;
+    }();
+
+    /**
+     * @brief Triangles of one face quad as indices into its four corners
+     */
+    constexpr std::array<u16, 6> quad_indices = {0, 1, 2, 0, 2, 3};
+
+    /**
+     * @brief Triangles of one face quad split along the other diagonal
+     */
+    constexpr std::array<u16, 6> flipped_quad_indices = {1, 2, 3, 1, 3, 0};
+
+    /**
+     * @brief Index buffer for six face quads stored one after another, four vertices each
+     */
+    constexpr std::array<u16, face_count * 6> cube_indices = [] {
+        std::array<u16, face_count * 6> indices{};
+        for (size_t face = 0; face < face_count; ++face) {
+            for (size_t i = 0; i < quad_indices.size(); ++i) {
+                indices[face * 6 + i] = static_cast<u16>(face * 4 + quad_indices[i]);
+            }
+        }
+        return indices;
+    }();
+
+    /**
+     * @brief Offsets to all 26 voxels around a voxel
+     *
+     * The six face neighbors come first, in Face order, followed by the 12
+     * edge neighbors and then the 8 corner neighbors.
+     */
+    constexpr std::array<IVector3, 26> neighbor_offsets = detail::make_neighbor_offsets();
+
+    /**
+     * @brief Voxels that darken each face corner for ambient occlusion
+     *
+     * For face f and corner c (same order as face_corners), the entries are
+     * the two side neighbors and the diagonal neighbor, all in the layer of
+     * voxels in front of the face.
+     */
+    constexpr std::array<std::array<std::array<IVector3, 3>, 4>, face_count> ao_neighbors =
+            detail::make_ao_neighbors();
+
+    /**
+     * @brief Ambient occlusion level, 0 (darkest) to 3 (unoccluded), by occupancy mask
+     *
+     * Bit 0 and 1 are the side neighbors and bit 2 the diagonal neighbor from ao_neighbors.
+     */
+    constexpr std::array<u8, 8> ao_levels = detail::make_ao_levels();
+
+    /**
+     * @brief Ambient occlusion level of a face corner from its three neighbors
+     */
+    constexpr u8 ambient_occlusion(const bool side1, const bool side2, const bool corner) {
+        return ao_levels[static_cast<u8>(side1) | static_cast<u8>(side2) << 1 | static_cast<u8>(corner) << 2];
+    }
+
+    /**
+     * @brief Check whether a quad should use flipped_quad_indices
+     *
+     * Splitting along the diagonal whose corners are brighter keeps the
+     * occlusion gradient from turning into a visible seam.
+     *
+     * @param ao Occlusion level of each corner, in face_corners order
+     */
+    constexpr bool should_flip_quad(const std::array<u8, 4> &ao) {
+        return ao[0] + ao[2] < ao[1] + ao[3];
+    }
+}
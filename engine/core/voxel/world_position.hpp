@@ -0,0 +1,79 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/math/vector3.hpp"
+#include "core/math/ivector3.hpp"
+#include "core/math/math_utils.hpp"
+#include "core/voxel/voxel_coordinates.hpp"
+
+namespace softcube::voxel {
+    /**
+     * @struct WorldPosition
+     * @brief A position anywhere in the world, as a chunk and a float offset from its minimum corner
+     *
+     * A float Vector3 resolves 1/128 of a block 65536 blocks from the origin
+     * and 1/8 at a million. Keeping the large part in integer chunks leaves
+     * the offset small, and differences between positions are taken in
+     * integers first, so two nearby positions far from the origin still
+     * subtract exactly.
+     */
+    struct WorldPosition {
+        IVector3 chunk;
+        Vector3 offset; // From the chunk's minimum corner, in blocks; [0, chunk_size] once normalized
+
+        WorldPosition() = default;
+
+        constexpr WorldPosition(const IVector3 &chunk, const Vector3 &offset) : chunk(chunk), offset(offset) {
+        }
+
+        /**
+         * @brief Position of a block's minimum corner
+         */
+        static constexpr WorldPosition from_block(const IVector3 &block) {
+            return WorldPosition(block_to_chunk(block), block_to_local(block).to_vector3());
+        }
+
+        /**
+         * @brief Position from absolute coordinates, e.g. a spawn point read from a save or the network
+         */
+        static WorldPosition from_world(const double x, const double y, const double z) {
+            const auto split = [](const double value, i32 &chunk_coordinate) {
+                const double chunk = std::floor(value / chunk_size);
+                chunk_coordinate = static_cast<i32>(chunk);
+                return static_cast<float>(value - chunk * chunk_size);
+            };
+
+            WorldPosition position;
+            position.offset.x = split(x, position.chunk.x);
+            position.offset.y = split(y, position.chunk.y);
+            position.offset.z = split(z, position.chunk.z);
+            return position;
+        }
+
+        /**
+         * @brief Same position with whole chunks moved from the offset into the chunk
+         */
+        constexpr WorldPosition normalized() const {
+            const IVector3 chunks(
+                math::floor_to_int(offset.x * (1.0f / chunk_size)),
+                math::floor_to_int(offset.y * (1.0f / chunk_size)),
+                math::floor_to_int(offset.z * (1.0f / chunk_size))
+            );
+            return WorldPosition(chunk + chunks, offset - (chunks * chunk_size).to_vector3());
+        }
+
+        /**
+         * @brief This position as seen from another, exact while the two are within 2^24 blocks of each other
+         */
+        constexpr Vector3 relative_to(const WorldPosition &origin) const {
+            return ((chunk - origin.chunk) * chunk_size).to_vector3() + (offset - origin.offset);
+        }
+
+        constexpr WorldPosition operator+(const Vector3 &delta) const {
+            return WorldPosition(chunk, offset + delta).normalized();
+        }
+
+        constexpr bool operator==(const WorldPosition &other) const {
+            return chunk == other.chunk && offset == other.offset;
+        }
+    };
+}
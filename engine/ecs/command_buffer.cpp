@@ -0,0 +1,64 @@
+#include "ecs/command_buffer.hpp"
+
+namespace softcube {
+    namespace {
+        // Shared by every buffer, so no two buffers or cycles ever hand out the same stamp.
+        std::atomic<u64> s_next_cycle{1};
+    }
+
+    CommandBuffer::CommandBuffer() : m_cycle(s_next_cycle.fetch_add(1, std::memory_order_relaxed)) {
+    }
+
+    void CommandBuffer::playback(Registry &registry) {
+        if (empty()) {
+            return;
+        }
+
+        m_created.resize(m_pending_count);
+        m_created_cycle = m_cycle;
+        if (m_pending_count > 0) {
+            auto &entities = registry.storage<entt::entity>();
+            entities.reserve(entities.size() + m_pending_count);
+            registry.create(m_created.begin(), m_created.end());
+        }
+
+        const std::span<const entt::entity> created{m_created};
+
+        for (const auto &[_, column]: m_columns) {
+            column->apply_writes(registry, created);
+        }
+
+        for (const auto &[_, column]: m_columns) {
+            column->apply_removes(registry, created);
+        }
+
+        for (const auto &target: m_destroy_targets) {
+            if (const auto entity = target.resolve(created); registry.valid(entity)) {
+                registry.destroy(entity);
+            }
+        }
+
+        SC_TRACE("Played back {} commands, created {} entities", m_command_count, m_pending_count);
+
+        clear();
+    }
+
+    void CommandBuffer::clear() {
+        for (const auto &[_, column]: m_columns) {
+            column->clear();
+        }
+
+        m_destroy_targets.clear();
+        m_cycle = s_next_cycle.fetch_add(1, std::memory_order_relaxed);
+        m_pending_count = 0;
+        m_command_count = 0;
+    }
+
+    entt::entity CommandBuffer::resolve(const PendingEntity entity) const {
+        if (!entity.is_valid() || entity.cycle != m_created_cycle || entity.index >= m_created.size()) {
+            return entt::null;
+        }
+
+        return m_created[entity.index];
+    }
+}
@@ -0,0 +1,394 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "ecs/registry.hpp"
+
+#include <span>
+
+namespace softcube {
+    /**
+     * @struct PendingEntity
+     * @brief Provisional handle for an entity whose creation was recorded in a CommandBuffer
+     *
+     * The handle is only meaningful to the buffer that issued it and is resolved
+     * to a real entity when that buffer is played back. It carries the buffer's
+     * recording cycle, so a handle from another buffer, or from before the last
+     * playback or clear, is rejected when a command is recorded with it.
+     */
+    struct PendingEntity {
+        static constexpr u32 invalid_index = std::numeric_limits<u32>::max();
+
+        u32 index = invalid_index;
+        u64 cycle = 0; // Recording cycle of the issuing buffer; unique across all buffers
+
+        [[nodiscard]] bool is_valid() const { return index != invalid_index; }
+    };
+
+    namespace detail {
+        /**
+         * @struct CommandTarget
+         * @brief Entity referenced by a recorded command, either existing or pending
+         */
+        struct CommandTarget {
+            entt::entity entity = entt::null;
+            u32 pending = PendingEntity::invalid_index;
+
+            CommandTarget(const entt::entity entity) : entity(entity) {
+            }
+
+            CommandTarget(const PendingEntity pending) : pending(pending.index) {
+            }
+
+            [[nodiscard]] entt::entity resolve(const std::span<const entt::entity> created) const {
+                if (pending == PendingEntity::invalid_index) {
+                    return entity;
+                }
+
+                SOFTCUBE_ASSERT(pending < created.size(), "Pending entity was not created by this playback");
+                return pending < created.size() ? created[pending] : entt::entity{entt::null};
+            }
+        };
+
+        /**
+         * @class CommandColumnBase
+         * @brief Type-erased storage for the commands recorded against one component type
+         */
+        class CommandColumnBase {
+        public:
+            virtual ~CommandColumnBase() = default;
+
+            /**
+             * @brief Apply recorded add and set commands
+             * @param registry Registry to apply to
+             * @param created Real entities, indexed by pending entity index
+             */
+            virtual void apply_writes(Registry &registry, std::span<const entt::entity> created) = 0;
+
+            /**
+             * @brief Apply recorded remove commands
+             * @param registry Registry to apply to
+             * @param created Real entities, indexed by pending entity index
+             */
+            virtual void apply_removes(Registry &registry, std::span<const entt::entity> created) = 0;
+
+            /**
+             * @brief Drop all recorded commands while keeping allocated capacity
+             */
+            virtual void clear() = 0;
+        };
+
+        template<typename T>
+        class CommandColumn final : public CommandColumnBase {
+        public:
+            template<typename... Args>
+            void add(const PendingEntity pending, Args &&... args) {
+                if (pending.index >= m_fresh_slots.size()) {
+                    m_fresh_slots.resize(static_cast<size_t>(pending.index) + 1, PendingEntity::invalid_index);
+                }
+
+                if (auto &slot = m_fresh_slots[pending.index]; slot == PendingEntity::invalid_index) {
+                    slot = static_cast<u32>(m_fresh_entities.size());
+                    m_fresh_entities.push_back(pending.index);
+                    m_fresh_values.emplace_back(std::forward<Args>(args)...);
+                } else {
+                    m_fresh_values[slot] = T(std::forward<Args>(args)...);
+                }
+            }
+
+            template<typename... Args>
+            void add(const entt::entity entity, Args &&... args) {
+                m_existing_entities.push_back(entity);
+                m_existing_values.emplace_back(std::forward<Args>(args)...);
+            }
+
+            void set(const entt::entity entity, T value) {
+                m_set_entities.push_back(entity);
+                m_set_values.push_back(std::move(value));
+            }
+
+            void remove(const CommandTarget target) {
+                m_remove_targets.push_back(target);
+            }
+
+            void apply_writes(Registry &registry, const std::span<const entt::entity> created) override {
+                if (!m_fresh_entities.empty()) {
+                    // Values of indices playback did not create are dropped, keeping
+                    // the rest lined up with m_scratch.
+                    m_scratch.clear();
+                    m_scratch.reserve(m_fresh_entities.size());
+                    for (size_t i = 0; i < m_fresh_entities.size(); ++i) {
+                        const auto index = m_fresh_entities[i];
+                        SOFTCUBE_ASSERT(index < created.size(), "Pending entity was not created by this playback");
+                        if (index >= created.size()) {
+                            continue;
+                        }
+                        if (m_scratch.size() != i) {
+                            m_fresh_values[m_scratch.size()] = std::move(m_fresh_values[i]);
+                        }
+                        m_scratch.push_back(created[index]);
+                    }
+
+                    // Fresh entities cannot already own the component, so the whole
+                    // batch goes through one range insert after a single reserve.
+                    auto &storage = registry.storage<T>();
+                    storage.reserve(storage.size() + m_scratch.size());
+
+                    if constexpr (std::is_empty_v<T>) {
+                        registry.insert<T>(m_scratch.begin(), m_scratch.end());
+                    } else {
+                        registry.insert<T>(m_scratch.begin(), m_scratch.end(),
+                                           std::make_move_iterator(m_fresh_values.begin()));
+                    }
+                }
+
+                for (size_t i = 0; i < m_existing_entities.size(); ++i) {
+                    if (const auto entity = m_existing_entities[i]; registry.valid(entity)) {
+                        registry.emplace_or_replace<T>(entity, std::move(m_existing_values[i]));
+                    }
+                }
+
+                if constexpr (!std::is_empty_v<T>) {
+                    for (size_t i = 0; i < m_set_entities.size(); ++i) {
+                        if (const auto entity = m_set_entities[i];
+                            registry.valid(entity) && registry.all_of<T>(entity)) {
+                            registry.replace<T>(entity, std::move(m_set_values[i]));
+                        }
+                    }
+                }
+            }
+
+            void apply_removes(Registry &registry, const std::span<const entt::entity> created) override {
+                if (m_remove_targets.empty()) {
+                    return;
+                }
+
+                m_scratch.clear();
+                for (const auto &target: m_remove_targets) {
+                    if (const auto entity = target.resolve(created); registry.valid(entity)) {
+                        m_scratch.push_back(entity);
+                    }
+                }
+
+                registry.remove<T>(m_scratch.begin(), m_scratch.end());
+            }
+
+            void clear() override {
+                m_fresh_slots.clear();
+                m_fresh_entities.clear();
+                m_fresh_values.clear();
+                m_existing_entities.clear();
+                m_existing_values.clear();
+                m_set_entities.clear();
+                m_set_values.clear();
+                m_remove_targets.clear();
+            }
+
+        private:
+            std::vector<u32> m_fresh_slots;
+            std::vector<u32> m_fresh_entities;
+            std::vector<T> m_fresh_values;
+
+            std::vector<entt::entity> m_existing_entities;
+            std::vector<T> m_existing_values;
+
+            std::vector<entt::entity> m_set_entities;
+            std::vector<T> m_set_values;
+
+            std::vector<CommandTarget> m_remove_targets;
+
+            std::vector<entt::entity> m_scratch;
+        };
+    }
+
+    /**
+     * @class CommandBuffer
+     * @brief Records structural changes to the registry for deferred playback
+     *
+     * The EnTT registry is not thread-safe, so code running off the main thread
+     * records entity creation, destruction and component changes here instead of
+     * touching the registry. Buffers are played back at the sync points in
+     * EcsManager::update.
+     *
+     * Playback is batched: all pending entities are created with one range create,
+     * and components added to them are inserted per type with one range insert.
+     * Commands are applied in phases (create, add/set, remove, destroy) rather than
+     * in recording order. A single buffer must only be recorded into by one thread
+     * at a time; use EcsManager::get_command_buffer to get one per thread.
+     */
+    class CommandBuffer {
+        SC_LOG_GROUP(ECS::COMMAND_BUFFER);
+
+    public:
+        CommandBuffer();
+
+        CommandBuffer(const CommandBuffer &) = delete;
+
+        CommandBuffer &operator=(const CommandBuffer &) = delete;
+
+        /**
+         * @brief Record the creation of an entity
+         * @return Provisional handle that can be used by later commands in this buffer
+         */
+        PendingEntity create() {
+            return PendingEntity{m_pending_count++, m_cycle};
+        }
+
+        /**
+         * @brief Record the destruction of an existing entity
+         * @param entity The entity to destroy
+         */
+        void destroy(const entt::entity entity) {
+            ++m_command_count;
+            m_destroy_targets.emplace_back(entity);
+        }
+
+        /**
+         * @brief Record the destruction of a pending entity
+         * @param entity The pending entity to destroy after it has been created
+         */
+        void destroy(const PendingEntity entity) {
+            if (!is_pending(entity)) {
+                return;
+            }
+
+            ++m_command_count;
+            m_destroy_targets.emplace_back(entity);
+        }
+
+        /**
+         * @brief Record adding a component, replacing it if the entity already has one
+         * @tparam T Component type
+         * @tparam Target Either entt::entity or PendingEntity
+         * @tparam Args Constructor argument types
+         * @param target Entity to add the component to
+         * @param args Arguments to forward to the component constructor
+         */
+        template<typename T, typename Target, typename... Args>
+        void add(const Target target, Args &&... args) {
+            if constexpr (std::is_same_v<Target, PendingEntity>) {
+                if (!is_pending(target)) {
+                    return;
+                }
+            }
+
+            column<T>().add(target, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Record replacing a component the entity already owns
+         *
+         * The command is skipped at playback if the entity does not own the
+         * component by then. On a pending entity this behaves like add.
+         *
+         * @tparam T Component type
+         * @param entity Entity whose component is replaced
+         * @param value New component value
+         */
+        template<typename T>
+        void set(const entt::entity entity, T value) {
+            column<T>().set(entity, std::move(value));
+        }
+
+        /**
+         * @brief Record setting a component on a pending entity
+         * @tparam T Component type
+         * @param entity Pending entity
+         * @param value Component value
+         */
+        template<typename T>
+        void set(const PendingEntity entity, T value) {
+            if (!is_pending(entity)) {
+                return;
+            }
+
+            column<T>().add(entity, std::move(value));
+        }
+
+        /**
+         * @brief Record removing a component
+         * @tparam T Component type
+         * @tparam Target Either entt::entity or PendingEntity
+         * @param target Entity to remove the component from
+         */
+        template<typename T, typename Target>
+        void remove(const Target target) {
+            if constexpr (std::is_same_v<Target, PendingEntity>) {
+                if (!is_pending(target)) {
+                    return;
+                }
+            }
+
+            column<T>().remove(detail::CommandTarget{target});
+        }
+
+        /**
+         * @brief Apply all recorded commands to the registry and clear the buffer
+         *
+         * Must be called from the thread that owns the registry.
+         *
+         * @param registry Registry to apply the commands to
+         */
+        void playback(Registry &registry);
+
+        /**
+         * @brief Drop all recorded commands without applying them
+         */
+        void clear();
+
+        /**
+         * @brief Resolve a pending entity from the last playback to its real handle
+         * @param entity Pending entity issued in the cycle the last playback applied
+         * @return The created entity, or entt::null if unknown
+         */
+        [[nodiscard]] entt::entity resolve(PendingEntity entity) const;
+
+        /**
+         * @brief Check if the buffer has no recorded commands
+         * @return True if there is nothing to play back
+         */
+        [[nodiscard]] bool empty() const { return m_command_count == 0 && m_pending_count == 0; }
+
+        /**
+         * @brief Get the number of entities recorded for creation
+         * @return Number of pending entities
+         */
+        [[nodiscard]] u32 get_pending_count() const { return m_pending_count; }
+
+    private:
+        /**
+         * @brief Check that a pending entity was issued by this buffer since its last playback or clear
+         */
+        [[nodiscard]] bool is_pending(const PendingEntity entity) const {
+            const bool pending = entity.cycle == m_cycle && entity.index < m_pending_count;
+            SOFTCUBE_ASSERT(pending, "Pending entity is from another buffer or from before the last playback");
+            if (!pending) {
+                SC_ERROR("Ignoring a command on a pending entity this buffer did not issue since its last playback");
+            }
+            return pending;
+        }
+
+        template<typename T>
+        detail::CommandColumn<T> &column() {
+            ++m_command_count;
+
+            const auto id = entt::type_hash<T>::value();
+            for (auto &[column_id, column]: m_columns) {
+                if (column_id == id) {
+                    return static_cast<detail::CommandColumn<T> &>(*column);
+                }
+            }
+
+            auto &[_, column] = m_columns.emplace_back(id, std::make_unique<detail::CommandColumn<T> >());
+            return static_cast<detail::CommandColumn<T> &>(*column);
+        }
+
+        u64 m_cycle; // Renewed on every playback and clear
+        u64 m_created_cycle = 0; // Cycle that m_created belongs to
+        u32 m_pending_count = 0;
+        size_t m_command_count = 0;
+
+        std::vector<std::pair<entt::id_type, std::unique_ptr<detail::CommandColumnBase> > > m_columns;
+        std::vector<detail::CommandTarget> m_destroy_targets;
+        std::vector<entt::entity> m_created;
+    };
+}
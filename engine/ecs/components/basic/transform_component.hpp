@@ -64,5 +64,18 @@ namespace softcube::component {
             up = up * rotation;
             return up;
         }
+
+        /**
+         * @brief Rebuild the world matrix from position, rotation and scale if it is dirty
+         * @return The world matrix
+         */
+        const Matrix4 &update_world_matrix() const {
+            if (matrix_dirty) {
+                world_matrix = Matrix4::translation(position) * Matrix4(rotation.to_rotation_matrix()) *
+                               Matrix4::scale(scale);
+                matrix_dirty = false;
+            }
+            return world_matrix;
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/voxel/world_position.hpp"
+#include "ecs/components/basic/transform_component.hpp"
+
+namespace softcube::component {
+    /**
+     * @struct WorldAnchor
+     * @brief Chunk an entity's Transform is relative to, for worlds larger than float precision allows
+     *
+     * With an anchor, Transform::position is the offset from the anchor
+     * chunk's minimum corner; entities without one are anchored at chunk
+     * zero. Rendering subtracts the camera's anchor in integers before
+     * converting to float, so an entity far from the world origin keeps full
+     * precision near the camera, and moving the camera into another chunk
+     * only rebases the camera. Children of an anchored entity must carry the
+     * same anchor; the hierarchy does not propagate it. The spatial index and
+     * physics still work on Transform::position, so they only relate entities
+     * that share an anchor.
+     */
+    struct WorldAnchor {
+        IVector3 chunk;
+
+        WorldAnchor() = default;
+
+        explicit WorldAnchor(const IVector3 &chunk) : chunk(chunk) {
+        }
+
+        [[nodiscard]] voxel::WorldPosition get_world_position(const Transform &transform) const {
+            return voxel::WorldPosition(chunk, transform.position);
+        }
+
+        /**
+         * @brief Place an entity, anchoring it at the chunk containing the position
+         */
+        void set_world_position(Transform &transform, const voxel::WorldPosition &position) {
+            const voxel::WorldPosition normalized = position.normalized();
+            chunk = normalized.chunk;
+            transform.position = normalized.offset;
+            transform.local_position = normalized.offset;
+            transform.matrix_dirty = true;
+        }
+
+        /**
+         * @brief Move whole chunks from the position into the anchor, keeping the position small
+         * @return Chunks the anchor moved by; positions relative to the old anchor must be shifted
+         *         by -moved * chunk_size blocks
+         */
+        IVector3 rebase(Transform &transform) {
+            const voxel::WorldPosition normalized = get_world_position(transform).normalized();
+            const IVector3 moved = normalized.chunk - chunk;
+            if (moved != IVector3::zero()) {
+                set_world_position(transform, normalized);
+            }
+            return moved;
+        }
+    };
+}
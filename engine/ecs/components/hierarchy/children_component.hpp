@@ -5,24 +5,16 @@
 namespace softcube::component {
     /**
      * @struct Children
-     * @brief Component that holds references to child entities
+     * @brief Head of the intrusive list of an entity's children
+     *
+     * The children are chained through the next and previous links of their
+     * Parent components, so a parent costs no allocation and attaching or
+     * detaching a child is O(1). The links are maintained by the HierarchySystem;
+     * use HierarchySystem::each_child to walk them.
      */
     struct Children {
-        std::vector<entt::entity> entities;
-
-        Children() = default;
-
-        explicit Children(const std::vector<entt::entity> &children) : entities(children) {
-        }
-
-        void add_child(const entt::entity child) {
-            entities.push_back(child);
-        }
-
-        void remove_child(const entt::entity child) {
-            if (const auto it = std::ranges::find(entities, child); it != entities.end()) {
-                entities.erase(it);
-            }
-        }
+        entt::entity first = entt::null;
+        entt::entity last = entt::null;
+        u32 count = 0;
     };
-}
\ No newline at end of file
+}
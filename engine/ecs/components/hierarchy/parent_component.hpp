@@ -6,13 +6,20 @@ namespace softcube::component {
     /**
      * @struct Parent
      * @brief Component that represents a parent-child relationship
+     *
+     * Also the child's node in its parent's Children list. Only entity is meant
+     * to be set by users; the links and depth are maintained by the HierarchySystem.
      */
     struct Parent {
         entt::entity entity = entt::null;
 
+        entt::entity next = entt::null; // Next sibling
+        entt::entity previous = entt::null; // Previous sibling
+        u32 depth = 1; // 1 for children of a root entity
+
         Parent() = default;
 
         explicit Parent(const entt::entity parent) : entity(parent) {
         }
     };
-}
\ No newline at end of file
+}
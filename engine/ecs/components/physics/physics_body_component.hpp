@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/common.hpp"
+
+namespace softcube::component {
+    /**
+     * @struct PhysicsBody
+     * @brief Simulated pose of an entity integrated at a fixed timestep
+     *
+     * Added automatically by the PhysicsIntegrationSystem to every entity with a
+     * Velocity and a Transform. The system owns the entity's local transform from
+     * then on: each frame it is set to the pose interpolated between the previous
+     * and current step. To teleport a body, write to this component or call
+     * PhysicsIntegrationSystem::teleport after writing the Transform. It is
+     * removed when the Velocity is.
+     */
+    struct PhysicsBody {
+        Vector3 position{0.0f, 0.0f, 0.0f};
+        Quaternion rotation{0.0f, 0.0f, 0.0f, 1.0f};
+
+        Vector3 previous_position{0.0f, 0.0f, 0.0f};
+        Quaternion previous_rotation{0.0f, 0.0f, 0.0f, 1.0f};
+
+        PhysicsBody() = default;
+
+        PhysicsBody(const Vector3 &position, const Quaternion &rotation)
+            : position(position), rotation(rotation), previous_position(position), previous_rotation(rotation) {
+        }
+    };
+}
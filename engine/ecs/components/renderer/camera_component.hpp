@@ -6,6 +6,10 @@ namespace softcube::component {
     /**
      * @struct Camera
      * @brief Camera component for rendering
+     *
+     * The matrices and frustum are caches. update_matrices() rebuilds them only
+     * when the pose, a projection parameter or the output size changed since the
+     * previous call, and bumps matrix_version so consumers can skip re-uploading.
      */
     struct Camera {
         float fov = 60.0f;
@@ -17,8 +21,25 @@ namespace softcube::component {
         bool is_orthographic = false;
         float ortho_size = 10.0f;
 
+        // Output. Several cameras render in the same frame (split-screen, minimap,
+        // render-to-texture) by each using its own bgfx view.
+        u16 view_id = 0;
+        u16 target_width = 0; // Size of the render target; 0 uses the window size
+        u16 target_height = 0;
+        Vector4 viewport{0.0f, 0.0f, 1.0f, 1.0f}; // Normalized x, y, width, height within the target
+
         Matrix4 view_matrix;
         Matrix4 projection_matrix;
+        Matrix4 view_projection_matrix;
+        Matrix4 inverse_view_projection_matrix;
+        Frustum frustum;
+        u32 matrix_version = 0;
+
+        // Inputs the caches were built from
+        Vector3 cached_position;
+        Quaternion cached_rotation;
+        std::array<float, 6> cached_projection{};
+        bool matrices_valid = false;
 
         Camera() = default;
 
@@ -27,7 +48,7 @@ namespace softcube::component {
          * @param position The position of the entity
          * @param rotation The rotation of the entity
          */
-        void calculate_view_matrix(const Vector3 &position, const Quaternion &rotation) const {
+        void calculate_view_matrix(const Vector3 &position, const Quaternion &rotation) {
             Vector3 forward{0.0f, 0.0f, 1.0f};
             forward = forward * rotation;
 
@@ -36,13 +57,13 @@ namespace softcube::component {
 
             const auto target = position + forward;
 
-            view_matrix.look_at(position, target, up);
+            view_matrix = Matrix4::look_at(position, target, up);
         }
 
         /**
          * @brief Calculate the projection matrix
-         * @param width Window width
-         * @param height Window height
+         * @param width Width of the area the camera renders to
+         * @param height Height of the area the camera renders to
          */
         void calculate_projection_matrix(const float width, const float height) {
             aspect_ratio = width / height;
@@ -53,5 +74,56 @@ namespace softcube::component {
                                                                      -ortho_size, ortho_size, near_clip, far_clip)
                                     : projection_matrix.perspective(fov, aspect_ratio, near_clip, far_clip);
         }
+
+        /**
+         * @brief Refresh the cached matrices and frustum if any of their inputs changed
+         * @param position Camera position
+         * @param rotation Camera rotation
+         * @param width Width of the render target in pixels
+         * @param height Height of the render target in pixels
+         * @return True if the caches were rebuilt
+         */
+        bool update_matrices(const Vector3 &position, const Quaternion &rotation, const float width,
+                             const float height) {
+            const float view_width = width * viewport.z;
+            const float view_height = height * viewport.w;
+            if (view_width <= 0.0f || view_height <= 0.0f) {
+                return false; // Minimized window or empty viewport; keep the last matrices
+            }
+
+            const std::array projection{
+                fov, near_clip, far_clip, ortho_size, is_orthographic ? 1.0f : 0.0f, view_width / view_height
+            };
+
+            const bool view_changed = !matrices_valid || position != cached_position || rotation != cached_rotation;
+            const bool projection_changed = !matrices_valid || projection != cached_projection;
+            if (!view_changed && !projection_changed) {
+                return false;
+            }
+
+            if (view_changed) {
+                calculate_view_matrix(position, rotation);
+                cached_position = position;
+                cached_rotation = rotation;
+            }
+
+            if (projection_changed) {
+                calculate_projection_matrix(view_width, view_height);
+                cached_projection = projection;
+            }
+
+            view_projection_matrix = projection_matrix * view_matrix;
+            inverse_view_projection_matrix = view_projection_matrix.inverse();
+            frustum = Frustum::from_matrix(view_projection_matrix);
+
+            matrices_valid = true;
+            ++matrix_version;
+            return true;
+        }
+
+        /**
+         * @brief Force the next update_matrices() call to rebuild every cache
+         */
+        void invalidate() { matrices_valid = false; }
     };
 }
@@ -26,15 +26,55 @@ namespace softcube::component {
 
         MeshRenderer() = default;
 
+        // Owns its GPU buffers: storages and groups relocate components by moving
+        // them, so a copy here would destroy the buffers out from under the mesh.
+        MeshRenderer(const MeshRenderer &) = delete;
+
+        MeshRenderer &operator=(const MeshRenderer &) = delete;
+
+        MeshRenderer(MeshRenderer &&other) noexcept {
+            *this = std::move(other);
+        }
+
+        MeshRenderer &operator=(MeshRenderer &&other) noexcept {
+            if (this != &other) {
+                release();
+
+                vertex_buffers = std::move(other.vertex_buffers);
+                index_buffer = std::exchange(other.index_buffer, BGFX_INVALID_HANDLE);
+                shader_program = other.shader_program;
+                color = other.color;
+                metallic = other.metallic;
+                roughness = other.roughness;
+                albedo_texture = other.albedo_texture;
+                normal_texture = other.normal_texture;
+                metallic_roughness_texture = other.metallic_roughness_texture;
+                cast_shadows = other.cast_shadows;
+                receive_shadows = other.receive_shadows;
+                visible = other.visible;
+
+                other.vertex_buffers.clear();
+            }
+
+            return *this;
+        }
+
         ~MeshRenderer() {
+            release();
+        }
+
+    private:
+        void release() {
             for (const auto &vb: vertex_buffers) {
                 if (isValid(vb)) {
                     destroy(vb);
                 }
             }
+            vertex_buffers.clear();
 
             if (isValid(index_buffer)) {
                 destroy(index_buffer);
+                index_buffer = BGFX_INVALID_HANDLE;
             }
         }
     };
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "core/common.hpp"
+
+namespace softcube::component {
+    /**
+     * @struct Bounds
+     * @brief Component that registers an entity with the spatial index
+     *
+     * The local box is given in the entity's model space. The world box and the
+     * proxy are maintained by the SpatialIndexSystem and should not be written to.
+     */
+    struct Bounds {
+        AABB local{Vector3(-0.5f), Vector3(0.5f)};
+        AABB world;
+        i32 proxy = -1;
+
+        Bounds() = default;
+
+        explicit Bounds(const AABB &local) : local(local) {
+        }
+    };
+}
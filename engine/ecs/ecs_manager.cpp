@@ -1,19 +1,30 @@
 #include "ecs/ecs_manager.hpp"
 
 #include "ecs/entity.hpp"
+#include "ecs/command_buffer.hpp"
+#include "ecs/serialization/registry_snapshot.hpp"
+#include "core/memory/allocation_tracker.hpp"
 #include "components/basic/name_component.hpp"
 #include "components/basic/tag_component.hpp"
 #include "systems/basic/transform_system.hpp"
 #include "systems/hierarchy/hierarchy_system.hpp"
 #include "systems/renderer/camera_system.hpp"
 #include "systems/renderer/mesh_renderer_system.hpp"
+#include "systems/spatial/spatial_index_system.hpp"
+#include "systems/physics/physics_integration_system.hpp"
 
 namespace softcube {
-    EcsManager::EcsManager() = default;
+    namespace {
+        // Ids rather than addresses, so a new manager at a freed address never sees an old buffer.
+        std::atomic<u64> s_next_id{1};
+    }
+
+    EcsManager::EcsManager() : m_id(s_next_id.fetch_add(1, std::memory_order_relaxed)) {
+    }
 
     EcsManager::~EcsManager() = default;
 
-    void EcsManager::init(entt::registry &registry, Renderer *renderer, InputManager *input_manager, Window *window) {
+    void EcsManager::init(Registry &registry, Renderer *renderer, InputManager *input_manager, Window *window) {
         m_registry = &registry;
         m_input_manager = input_manager;
         m_window = window;
@@ -23,30 +34,55 @@ namespace softcube {
         m_hierarchy_system = std::make_unique<system::HierarchySystem>();
         m_camera_system = std::make_unique<system::CameraSystem>(input_manager, window);
         m_mesh_renderer_system = std::make_unique<system::MeshRendererSystem>(renderer);
+        m_spatial_index_system = std::make_unique<system::SpatialIndexSystem>();
+        m_physics_integration_system = std::make_unique<system::PhysicsIntegrationSystem>();
+        m_snapshot = std::make_unique<RegistrySnapshot>();
 
         m_transform_system->init(registry);
         m_hierarchy_system->init(registry);
         m_camera_system->init(registry);
         m_mesh_renderer_system->init(registry);
+        m_spatial_index_system->init(registry);
+        m_physics_integration_system->init(registry);
 
+        m_systems.push_back(m_physics_integration_system.get());
         m_systems.push_back(m_hierarchy_system.get());
         m_systems.push_back(m_transform_system.get());
+        m_systems.push_back(m_spatial_index_system.get());
         m_systems.push_back(m_camera_system.get());
 
         m_rendering_systems.push_back(m_mesh_renderer_system.get());
+
+        for (const auto *system: m_systems) {
+            m_profiler.add_system(*system, false);
+            m_allocation_tags.push_back(AllocationTracker::register_tag(system->get_name()));
+        }
+
+        for (const auto *system: m_rendering_systems) {
+            m_profiler.add_system(*system, true);
+            m_allocation_tags.push_back(AllocationTracker::register_tag(system->get_name()));
+        }
     }
 
-    void EcsManager::update(const float dt) const {
-        for (auto *system: m_systems) {
-            if (system->is_enabled()) {
+    void EcsManager::update(const float dt) {
+        flush_command_buffers();
+
+        for (size_t i = 0; i < m_systems.size(); ++i) {
+            if (auto *system = m_systems[i]; system->is_enabled()) {
+                SystemProfiler::Scope scope(m_profiler, i);
+                AllocationScope allocation_scope(m_allocation_tags[i]);
                 system->update(dt);
             }
         }
+
+        flush_command_buffers();
     }
 
-    void EcsManager::render(const float dt) const {
-        for (auto *system: m_rendering_systems) {
-            if (system->is_enabled()) {
+    void EcsManager::render(const float dt) {
+        for (size_t i = 0; i < m_rendering_systems.size(); ++i) {
+            if (auto *system = m_rendering_systems[i]; system->is_enabled()) {
+                SystemProfiler::Scope scope(m_profiler, m_systems.size() + i);
+                AllocationScope allocation_scope(m_allocation_tags[m_systems.size() + i]);
                 system->update(dt);
             }
         }
@@ -105,6 +141,60 @@ namespace softcube {
         }
     }
 
+    CommandBuffer &EcsManager::get_command_buffer() {
+        struct CachedBuffer {
+            u64 owner = 0;
+            CommandBuffer *buffer = nullptr;
+        };
+
+        thread_local CachedBuffer cached;
+        if (cached.owner == m_id) {
+            return *cached.buffer;
+        }
+
+        const auto thread_id = std::this_thread::get_id();
+
+        std::scoped_lock lock(m_command_buffer_mutex);
+        auto it = std::ranges::find_if(m_command_buffers, [thread_id](const auto &entry) {
+            return entry.first == thread_id;
+        });
+
+        if (it == m_command_buffers.end()) {
+            m_command_buffers.emplace_back(thread_id, std::make_unique<CommandBuffer>());
+            it = std::prev(m_command_buffers.end());
+        }
+
+        cached = {m_id, it->second.get()};
+        return *cached.buffer;
+    }
+
+    void EcsManager::flush_command_buffers() {
+        std::scoped_lock lock(m_command_buffer_mutex);
+        for (const auto &[_, buffer]: m_command_buffers) {
+            buffer->playback(*m_registry);
+        }
+    }
+
+    bool EcsManager::save_snapshot(const std::filesystem::path &path) const {
+        return m_snapshot->save(*m_registry, path);
+    }
+
+    bool EcsManager::load_snapshot(const std::filesystem::path &path) {
+        {
+            std::scoped_lock lock(m_command_buffer_mutex);
+            for (const auto &[_, buffer]: m_command_buffers) {
+                buffer->clear();
+            }
+        }
+
+        if (m_mesh_renderer_system) {
+            m_mesh_renderer_system->set_active_camera(entt::null);
+            m_mesh_renderer_system->clear_cameras();
+        }
+
+        return m_snapshot->load(*m_registry, path);
+    }
+
     void EcsManager::set_active_camera(const Entity &camera_entity) const {
         if (m_mesh_renderer_system) {
             m_mesh_renderer_system->set_active_camera(camera_entity.get_handle());
@@ -1,8 +1,12 @@
 #pragma once
 #include "core/common.hpp"
+#include "ecs/registry.hpp"
+#include "ecs/system_profiler.hpp"
 
 namespace softcube {
     class Entity;
+    class CommandBuffer;
+    class RegistrySnapshot;
 
     namespace system {
         class CameraSystem;
@@ -10,6 +14,8 @@ namespace softcube {
         class HierarchySystem;
         class TransformSystem;
         class MeshRendererSystem;
+        class SpatialIndexSystem;
+        class PhysicsIntegrationSystem;
     }
 
     class Renderer;
@@ -36,20 +42,25 @@ namespace softcube {
        * @param input_manager Pointer to the input manager
        * @param window Pointer to the window
        */
-        void init(entt::registry &registry, Renderer *renderer, InputManager *input_manager = nullptr,
+        void init(Registry &registry, Renderer *renderer, InputManager *input_manager = nullptr,
                   Window *window = nullptr);
 
         /**
          * @brief Update all non-rendering systems
+         *
+         * Command buffers are played back before the first system runs and again
+         * after the last one, so commands recorded during the update are visible
+         * to rendering in the same frame.
+         *
          * @param dt Delta time in seconds
          */
-        void update(float dt) const;
+        void update(float dt);
 
         /**
          * @brief Update all rendering systems - should be called between renderer's begin_frame() and end_frame()
          * @param dt Delta time in seconds
          */
-        void render(float dt) const;
+        void render(float dt);
 
         /**
          * @brief Create a new entity
@@ -78,6 +89,49 @@ namespace softcube {
          */
         Entity find_entity_by_tag(const std::string &tag);
 
+        /**
+         * @brief Get the command buffer owned by the calling thread
+         *
+         * The buffer is created on first use and played back at the next sync
+         * point in update(). Safe to call from any thread.
+         *
+         * @return Reference to the calling thread's command buffer
+         */
+        CommandBuffer &get_command_buffer();
+
+        /**
+         * @brief Play back every thread's command buffer into the registry
+         *
+         * Must be called from the thread that owns the registry while no other
+         * thread is recording.
+         */
+        void flush_command_buffers();
+
+        /**
+         * @brief Save every entity and serializable component to a binary snapshot
+         * @param path Destination file
+         * @return True if the snapshot was written
+         */
+        bool save_snapshot(const std::filesystem::path &path) const;
+
+        /**
+         * @brief Replace the registry contents with a snapshot file
+         *
+         * Pending command buffers are discarded and all rendered cameras are reset.
+         * Components that own GPU resources are not part of snapshots and must be
+         * recreated by the caller.
+         *
+         * @param path Snapshot file, memory-mapped while loading
+         * @return True if the snapshot was loaded
+         */
+        bool load_snapshot(const std::filesystem::path &path);
+
+        /**
+         * @brief Get the snapshot description, to register additional component types
+         * @return Reference to the registry snapshot
+         */
+        RegistrySnapshot &get_snapshot() const { return *m_snapshot; }
+
         /**
          * @brief Set the active camera for rendering
          * @param camera_entity Entity with camera component
@@ -102,6 +156,26 @@ namespace softcube {
          */
         system::MeshRendererSystem &get_mesh_renderer_system() const { return *m_mesh_renderer_system; }
 
+        /**
+         * @brief Get the spatial index system
+         * @return Reference to the spatial index system
+         */
+        system::SpatialIndexSystem &get_spatial_index_system() const { return *m_spatial_index_system; }
+
+        /**
+         * @brief Get the physics integration system
+         * @return Reference to the physics integration system
+         */
+        system::PhysicsIntegrationSystem &get_physics_integration_system() const {
+            return *m_physics_integration_system;
+        }
+
+        /**
+         * @brief Get the profiler timing every system update
+         * @return Reference to the system profiler
+         */
+        SystemProfiler &get_profiler() { return m_profiler; }
+
         /**
          * @brief Set parent-child relationship between entities
          * @param child Child entity
@@ -116,7 +190,8 @@ namespace softcube {
         void remove_parent(Entity child) const;
 
     private:
-        entt::registry *m_registry = nullptr;
+        u64 m_id; // Unique per manager; keys the per-thread command buffer cache
+        Registry *m_registry = nullptr;
         InputManager *m_input_manager = nullptr;
         Window *m_window = nullptr;
         Renderer *m_renderer = nullptr;
@@ -125,8 +200,18 @@ namespace softcube {
         std::unique_ptr<system::HierarchySystem> m_hierarchy_system;
         std::unique_ptr<system::CameraSystem> m_camera_system;
         std::unique_ptr<system::MeshRendererSystem> m_mesh_renderer_system;
+        std::unique_ptr<system::SpatialIndexSystem> m_spatial_index_system;
+        std::unique_ptr<system::PhysicsIntegrationSystem> m_physics_integration_system;
 
         std::vector<system::System *> m_systems; // Non-rendering systems
         std::vector<system::System *> m_rendering_systems; // Rendering systems
+
+        std::unique_ptr<RegistrySnapshot> m_snapshot;
+
+        SystemProfiler m_profiler; // Entries follow m_systems, then m_rendering_systems
+        std::vector<u32> m_allocation_tags; // Same order as the profiler entries
+
+        std::mutex m_command_buffer_mutex;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<CommandBuffer> > > m_command_buffers;
     };
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/common.hpp"
+#include "ecs/registry.hpp"
 
 namespace softcube {
     /**
@@ -18,7 +19,7 @@ namespace softcube {
          * @param handle The EnTT entity handle
          * @param registry Pointer to the registry that owns the entity
          */
-        Entity(const entt::entity handle, entt::registry *registry)
+        Entity(const entt::entity handle, Registry *registry)
             : m_entity_handle(handle), m_registry(registry) {
         }
 
@@ -111,6 +112,6 @@ namespace softcube {
 
     private:
         entt::entity m_entity_handle = entt::null;
-        entt::registry *m_registry = nullptr;
+        Registry *m_registry = nullptr;
     };
 }
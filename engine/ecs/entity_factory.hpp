@@ -1,5 +1,7 @@
 #pragma once
 #include "core/common.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/prefab.hpp"
 
 namespace softcube {
     /**
@@ -11,7 +13,7 @@ namespace softcube {
      */
     class EntityFactory {
     public:
-        explicit EntityFactory(entt::registry *registry);
+        explicit EntityFactory(Registry *registry);
 
     /**
        * @brief Create a camera entity
@@ -30,7 +32,56 @@ namespace softcube {
          */
         Entity create_cube(const Vector3 &position, float size = 1.0f, const Vector4 &color = Vector4(1.0f, 1.0f, 1.0f, 1.0f)) const;
 
+        /**
+         * @brief Spawn many copies of a prefab in one batch
+         *
+         * Entities are created with a single range create, and each prefab component
+         * is inserted with a single range insert after reserving its storage, so every
+         * pool grows at most once per call.
+         *
+         * @param prefab Prefab to instantiate
+         * @param entities Output span; one entity is created per element
+         * @param init_fn Optional callable invoked as init_fn(Entity, index) after all components are in place
+         */
+        template<typename InitFn>
+        void instantiate(const Prefab &prefab, std::span<entt::entity> entities, InitFn &&init_fn) const {
+            instantiate(prefab, entities);
+
+            for (size_t i = 0; i < entities.size(); ++i) {
+                init_fn(Entity{entities[i], m_registry}, i);
+            }
+        }
+
+        /**
+         * @brief Spawn many copies of a prefab in one batch
+         * @param prefab Prefab to instantiate
+         * @param entities Output span; one entity is created per element
+         */
+        void instantiate(const Prefab &prefab, std::span<entt::entity> entities) const;
+
+        /**
+         * @brief Spawn many copies of a prefab in one batch
+         * @param prefab Prefab to instantiate
+         * @param count Number of entities to create
+         * @param init_fn Optional callable invoked as init_fn(Entity, index) after all components are in place
+         * @return The created entities
+         */
+        template<typename InitFn>
+        std::vector<entt::entity> instantiate(const Prefab &prefab, const size_t count, InitFn &&init_fn) const {
+            std::vector<entt::entity> entities(count);
+            instantiate(prefab, std::span{entities}, std::forward<InitFn>(init_fn));
+            return entities;
+        }
+
+        /**
+         * @brief Spawn many copies of a prefab in one batch
+         * @param prefab Prefab to instantiate
+         * @param count Number of entities to create
+         * @return The created entities
+         */
+        std::vector<entt::entity> instantiate(const Prefab &prefab, size_t count) const;
+
     private:
-        entt::registry *m_registry;
+        Registry *m_registry;
     };
 }
@@ -0,0 +1,156 @@
+#pragma once
+#include "core/common.hpp"
+#include "ecs/registry.hpp"
+
+#include <span>
+
+namespace softcube {
+    namespace detail {
+        /**
+         * @class PrefabComponentBase
+         * @brief Type-erased default value for one component of a prefab
+         */
+        class PrefabComponentBase {
+        public:
+            virtual ~PrefabComponentBase() = default;
+
+            /**
+             * @brief Insert the default value into a batch of freshly created entities
+             * @param registry Registry that owns the entities
+             * @param entities Entities that do not own the component yet
+             */
+            virtual void insert(Registry &registry, std::span<const entt::entity> entities) const = 0;
+
+            [[nodiscard]] virtual entt::id_type get_type_id() const = 0;
+        };
+
+        template<typename T>
+        class PrefabComponent final : public PrefabComponentBase {
+        public:
+            template<typename... Args>
+            explicit PrefabComponent(Args &&... args) : m_value(std::forward<Args>(args)...) {
+            }
+
+            void insert(Registry &registry, const std::span<const entt::entity> entities) const override {
+                auto &storage = registry.storage<T>();
+                storage.reserve(storage.size() + entities.size());
+
+                if constexpr (std::is_empty_v<T>) {
+                    registry.insert<T>(entities.begin(), entities.end());
+                } else {
+                    registry.insert<T>(entities.begin(), entities.end(), m_value);
+                }
+            }
+
+            [[nodiscard]] entt::id_type get_type_id() const override {
+                return entt::type_hash<T>::value();
+            }
+
+            [[nodiscard]] const T &get_value() const { return m_value; }
+            T &get_value() { return m_value; }
+
+        private:
+            T m_value;
+        };
+    }
+
+    /**
+     * @class Prefab
+     * @brief Template describing a set of components and their default values
+     *
+     * Prefabs are instantiated in bulk through EntityFactory::instantiate. Every
+     * instance receives a copy of each default value, so component types that own
+     * GPU or other unique resources (such as MeshRenderer) must not be added here.
+     */
+    class Prefab {
+    public:
+        Prefab() = default;
+
+        Prefab(Prefab &&) = default;
+
+        Prefab &operator=(Prefab &&) = default;
+
+        /**
+         * @brief Add a component to the prefab, replacing any previous default
+         * @tparam T Component type
+         * @tparam Args Constructor argument types
+         * @param args Arguments to forward to the component constructor
+         * @return Reference to this prefab for chaining
+         */
+        template<typename T, typename... Args>
+        Prefab &with(Args &&... args) {
+            auto component = std::make_unique<detail::PrefabComponent<T> >(std::forward<Args>(args)...);
+
+            if (const auto it = find(entt::type_hash<T>::value()); it != m_components.end()) {
+                *it = std::move(component);
+            } else {
+                m_components.push_back(std::move(component));
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Remove a component from the prefab
+         * @tparam T Component type
+         */
+        template<typename T>
+        void without() {
+            if (const auto it = find(entt::type_hash<T>::value()); it != m_components.end()) {
+                m_components.erase(it);
+            }
+        }
+
+        /**
+         * @brief Check if the prefab contains a component
+         * @tparam T Component type
+         * @return True if the prefab has a default value for the component
+         */
+        template<typename T>
+        [[nodiscard]] bool has() const {
+            return std::ranges::any_of(m_components, [](const auto &component) {
+                return component->get_type_id() == entt::type_hash<T>::value();
+            });
+        }
+
+        /**
+         * @brief Get the default value of a component
+         * @tparam T Component type
+         * @return Reference to the default value; the prefab must contain the component
+         */
+        template<typename T>
+        T &get() {
+            const auto it = find(entt::type_hash<T>::value());
+            SOFTCUBE_ASSERT(it != m_components.end(), "Prefab does not contain the component");
+            return static_cast<detail::PrefabComponent<T> &>(**it).get_value();
+        }
+
+        /**
+         * @brief Insert every default component into a batch of fresh entities
+         * @param registry Registry that owns the entities
+         * @param entities Entities to initialize
+         */
+        void insert(Registry &registry, const std::span<const entt::entity> entities) const {
+            for (const auto &component: m_components) {
+                component->insert(registry, entities);
+            }
+        }
+
+        /**
+         * @brief Get the number of components in the prefab
+         * @return Component count
+         */
+        [[nodiscard]] size_t get_component_count() const { return m_components.size(); }
+
+    private:
+        using ComponentList = std::vector<std::unique_ptr<detail::PrefabComponentBase> >;
+
+        ComponentList::iterator find(const entt::id_type id) {
+            return std::ranges::find_if(m_components, [id](const auto &component) {
+                return component->get_type_id() == id;
+            });
+        }
+
+        ComponentList m_components;
+    };
+}
@@ -0,0 +1,57 @@
+#include "ecs/registry.hpp"
+
+namespace softcube {
+    ComponentResource::ComponentResource(const entt::type_info type)
+        : m_type(type), m_upstream(std::pmr::new_delete_resource()) {
+    }
+
+    bool ComponentResource::set_upstream(std::pmr::memory_resource *upstream) {
+        if (get_bytes() > 0) {
+            SC_WARN("Cannot change the memory of {} while its storage holds {} bytes", m_type.name(), get_bytes());
+            return false;
+        }
+
+        m_upstream = upstream ? upstream : std::pmr::new_delete_resource();
+        return true;
+    }
+
+    void *ComponentResource::do_allocate(const size_t bytes, const size_t alignment) {
+        void *pointer = m_upstream->allocate(bytes, alignment);
+
+        const size_t total = m_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t peak = m_peak_bytes.load(std::memory_order_relaxed);
+        while (total > peak && !m_peak_bytes.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {
+        }
+
+        return pointer;
+    }
+
+    void ComponentResource::do_deallocate(void *pointer, const size_t bytes, const size_t alignment) {
+        m_upstream->deallocate(pointer, bytes, alignment);
+        m_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    ComponentResource &ComponentMemory::get_resource(const entt::type_info &type) {
+        std::scoped_lock lock(m_mutex);
+
+        for (const auto &resource: m_resources) {
+            if (resource->get_type() == type) {
+                return *resource;
+            }
+        }
+
+        return *m_resources.emplace_back(std::make_unique<ComponentResource>(type));
+    }
+
+    const ComponentResource *ComponentMemory::find_resource(const entt::type_info &type) const {
+        std::scoped_lock lock(m_mutex);
+
+        for (const auto &resource: m_resources) {
+            if (resource->get_type() == type) {
+                return resource.get();
+            }
+        }
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,210 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+
+#include <memory_resource>
+
+namespace softcube {
+    /**
+     * @class ComponentResource
+     * @brief Memory resource that every storage allocation made as one type goes through
+     *
+     * Forwards to an upstream resource, new/delete unless changed, and counts
+     * the bytes it hands out so storage memory can be reported per component.
+     * Owned by a ComponentMemory.
+     */
+    class ComponentResource final : public std::pmr::memory_resource {
+        SC_LOG_GROUP(ECS::COMPONENT_MEMORY);
+
+    public:
+        explicit ComponentResource(entt::type_info type);
+
+        /**
+         * @brief Send future allocations to another resource
+         * @param upstream Resource to allocate from; must outlive every allocation made through it
+         * @return False, leaving the upstream unchanged, if memory from the current upstream is still in use
+         */
+        bool set_upstream(std::pmr::memory_resource *upstream);
+
+        [[nodiscard]] std::pmr::memory_resource *get_upstream() const { return m_upstream; }
+
+        [[nodiscard]] const entt::type_info &get_type() const { return m_type; }
+
+        [[nodiscard]] size_t get_bytes() const { return m_bytes.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] size_t get_peak_bytes() const { return m_peak_bytes.load(std::memory_order_relaxed); }
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+
+        [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+
+        entt::type_info m_type;
+        std::pmr::memory_resource *m_upstream;
+        std::atomic<size_t> m_bytes{0};
+        std::atomic<size_t> m_peak_bytes{0};
+    };
+
+    /**
+     * @class ComponentMemory
+     * @brief Chooses the memory resource behind each component storage of the registries that use it
+     *
+     * Every type allocated through a ComponentAllocator bound to this object
+     * gets its own ComponentResource, created on first use. A component's pages
+     * are allocated as that component type, so they land in its resource; the
+     * sparse and packed arrays of every storage are allocated as entities and
+     * share the entity type's resource. Point a component at a different
+     * upstream, such as a LargePageResource or a std::pmr pool, before its
+     * storage is first used.
+     *
+     * Must outlive every registry bound to it.
+     */
+    class ComponentMemory {
+    public:
+        /**
+         * @struct StorageStats
+         * @brief Memory of one registry storage
+         */
+        struct StorageStats {
+            std::string_view name;
+            size_t size = 0; // Entities in the storage
+            size_t capacity = 0; // Entities the packed array can hold without growing
+            size_t bytes = 0; // Allocated as the storage's type; component pages, or every entity array
+            size_t peak_bytes = 0;
+            bool custom_upstream = false;
+        };
+
+        ComponentMemory() = default;
+
+        ComponentMemory(const ComponentMemory &) = delete;
+
+        ComponentMemory &operator=(const ComponentMemory &) = delete;
+
+        /**
+         * @brief Get the resource all memory allocated as a type goes through, creating it on first use
+         */
+        ComponentResource &get_resource(const entt::type_info &type);
+
+        /**
+         * @brief Allocate a component's storage from another resource
+         * @tparam Component Component type
+         * @param upstream Resource to allocate from; must outlive the storage
+         * @return False if the component's storage already holds memory
+         */
+        template<typename Component>
+        bool set_upstream(std::pmr::memory_resource *upstream) {
+            return get_resource(entt::type_id<Component>()).set_upstream(upstream);
+        }
+
+        /**
+         * @brief Collect the size, capacity and memory of every storage in a registry
+         *
+         * Memory is only known for registries whose allocator is bound to a
+         * ComponentMemory; for others it is reported as zero.
+         */
+        template<typename Registry>
+        [[nodiscard]] static std::vector<StorageStats> get_storage_stats(const Registry &registry) {
+            const ComponentMemory *memory = registry.get_allocator().get_memory();
+
+            std::vector<StorageStats> stats;
+            for (const auto [id, storage]: registry.storage()) {
+                auto &entry = stats.emplace_back();
+                entry.name = storage.info().name();
+                entry.size = storage.size();
+                entry.capacity = storage.capacity();
+
+                if (const auto *resource = memory ? memory->find_resource(storage.info()) : nullptr) {
+                    entry.bytes = resource->get_bytes();
+                    entry.peak_bytes = resource->get_peak_bytes();
+                    entry.custom_upstream = resource->get_upstream() != std::pmr::new_delete_resource();
+                }
+            }
+            return stats;
+        }
+
+    private:
+        [[nodiscard]] const ComponentResource *find_resource(const entt::type_info &type) const;
+
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<ComponentResource> > m_resources;
+    };
+
+    /**
+     * @class ComponentAllocator
+     * @brief Stateful allocator routing each allocation to the ComponentResource of its value type
+     *
+     * The allocator is bound to a ComponentMemory, which every rebind keeps,
+     * so two allocators compare equal exactly when they share one and a
+     * rebound copy always equals its source. The resource for T is looked up
+     * once, when the allocator is constructed or rebound, so allocate and
+     * deallocate take no lock. A default-constructed allocator is bound to
+     * nothing and allocates from new/delete without being counted.
+     */
+    template<typename T>
+    class ComponentAllocator {
+    public:
+        using value_type = T;
+        using is_always_equal = std::false_type;
+
+        ComponentAllocator() noexcept = default;
+
+        /**
+         * @note Creates the resource for T on first use, so it may throw std::bad_alloc
+         */
+        explicit ComponentAllocator(ComponentMemory &memory)
+            : m_memory(&memory), m_resource(&memory.get_resource(entt::type_id<T>())) {
+        }
+
+        /**
+         * @note Creates the resource for T on first use, so it may throw std::bad_alloc
+         */
+        template<typename U>
+        ComponentAllocator(const ComponentAllocator<U> &other) // NOLINT(*-explicit-constructor)
+            : m_memory(other.m_memory),
+              m_resource(m_memory ? &m_memory->get_resource(entt::type_id<T>()) : std::pmr::new_delete_resource()) {
+        }
+
+        [[nodiscard]] T *allocate(const size_t count) {
+            if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(m_resource->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *pointer, const size_t count) noexcept {
+            m_resource->deallocate(pointer, count * sizeof(T), alignof(T));
+        }
+
+        [[nodiscard]] std::pmr::memory_resource *get_resource() const { return m_resource; }
+
+        [[nodiscard]] ComponentMemory *get_memory() const { return m_memory; }
+
+        template<typename U>
+        bool operator==(const ComponentAllocator<U> &other) const noexcept {
+            return m_memory == other.m_memory;
+        }
+
+    private:
+        template<typename>
+        friend class ComponentAllocator;
+
+        ComponentMemory *m_memory = nullptr;
+        std::pmr::memory_resource *m_resource = std::pmr::new_delete_resource(); // Resource for T in m_memory
+    };
+
+    /**
+     * @brief Registry used throughout the engine
+     *
+     * Construct it from a ComponentAllocator bound to a ComponentMemory to
+     * count and place its storage memory; a default-constructed one uses the heap.
+     */
+    using Registry = entt::basic_registry<entt::entity, ComponentAllocator<entt::entity> >;
+
+    using Snapshot = entt::basic_snapshot<Registry>;
+
+    using SnapshotLoader = entt::basic_snapshot_loader<Registry>;
+}
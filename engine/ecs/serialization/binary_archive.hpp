@@ -0,0 +1,183 @@
+#pragma once
+#include "core/common.hpp"
+
+#include <span>
+
+namespace softcube {
+    template<typename T>
+    struct ComponentSerializer;
+
+    /**
+     * @class BinaryOutputArchive
+     * @brief Growable byte buffer usable as an entt::snapshot output archive
+     *
+     * Plain values are written as raw bytes in host byte order. Component types
+     * are written through their ComponentSerializer specialization.
+     */
+    class BinaryOutputArchive {
+    public:
+        void operator()(const std::underlying_type_t<entt::entity> value) { write(value); }
+
+        void operator()(const entt::entity entity) { write(entity); }
+
+        template<typename T>
+        void operator()(const T &value) {
+            ComponentSerializer<T>::save(*this, value);
+        }
+
+        template<typename T>
+        void write(const T &value) {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written as bytes");
+            write_bytes(&value, sizeof(T));
+        }
+
+        void write_bytes(const void *data, const size_t size) {
+            const size_t offset = m_buffer.size();
+            m_buffer.resize(offset + size);
+            std::memcpy(m_buffer.data() + offset, data, size);
+        }
+
+        void write_string(const std::string_view value) {
+            write(static_cast<u32>(value.size()));
+            write_bytes(value.data(), value.size());
+        }
+
+        /**
+         * @brief Pad the buffer with zeroes up to a multiple of alignment
+         * @param alignment Power of two alignment relative to the start of the buffer
+         */
+        void align(const size_t alignment) {
+            m_buffer.resize((m_buffer.size() + alignment - 1) & ~(alignment - 1));
+        }
+
+        /**
+         * @brief Append an uninitialized, aligned block to be filled in later
+         * @param size Block size in bytes
+         * @param alignment Power of two alignment of the block
+         * @return Offset of the block; pointers into the buffer are invalidated by further writes
+         */
+        size_t reserve_block(const size_t size, const size_t alignment) {
+            align(alignment);
+            const size_t offset = m_buffer.size();
+            m_buffer.resize(offset + size);
+            return offset;
+        }
+
+        template<typename T>
+        void patch(const size_t offset, const T &value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+        }
+
+        [[nodiscard]] std::byte *data() { return m_buffer.data(); }
+        [[nodiscard]] size_t size() const { return m_buffer.size(); }
+
+        void reserve(const size_t capacity) { m_buffer.reserve(capacity); }
+
+        std::vector<std::byte> release() { return std::move(m_buffer); }
+
+    private:
+        std::vector<std::byte> m_buffer;
+    };
+
+    /**
+     * @class BinaryInputArchive
+     * @brief Cursor over a byte range usable as a SnapshotLoader input archive
+     *
+     * The archive never owns its data, so it can read straight from a mapped
+     * file. Reading past the end zero-fills the destination and marks the
+     * archive as failed instead of throwing.
+     */
+    class BinaryInputArchive {
+    public:
+        explicit BinaryInputArchive(const std::span<const std::byte> data) : m_data(data) {
+        }
+
+        void operator()(std::underlying_type_t<entt::entity> &value) { read(value); }
+
+        void operator()(entt::entity &entity) { read(entity); }
+
+        template<typename T>
+        void operator()(T &value) {
+            ComponentSerializer<T>::load(*this, value, m_version);
+        }
+
+        template<typename T>
+        void read(T &value) {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read as bytes");
+            read_bytes(&value, sizeof(T));
+        }
+
+        void read_bytes(void *data, const size_t size) {
+            if (size > remaining()) {
+                std::memset(data, 0, size);
+                m_failed = true;
+                m_cursor = m_data.size();
+                return;
+            }
+
+            std::memcpy(data, m_data.data() + m_cursor, size);
+            m_cursor += size;
+        }
+
+        void read_string(std::string &value) {
+            u32 size = 0;
+            read(size);
+
+            if (size > remaining()) {
+                value.clear();
+                m_failed = true;
+                m_cursor = m_data.size();
+                return;
+            }
+
+            value.assign(reinterpret_cast<const char *>(m_data.data() + m_cursor), size);
+            m_cursor += size;
+        }
+
+        void align(const size_t alignment) {
+            m_cursor = std::min((m_cursor + alignment - 1) & ~(alignment - 1), m_data.size());
+        }
+
+        /**
+         * @brief Borrow an aligned block of values without copying it
+         * @param count Number of values
+         * @param alignment Power of two alignment the block was written with
+         * @return Pointer into the underlying data, or nullptr if the block is truncated
+         */
+        template<typename T>
+        const T *read_block(const size_t count, const size_t alignment = alignof(T)) {
+            align(alignment);
+
+            if (count * sizeof(T) > remaining()) {
+                m_failed = true;
+                m_cursor = m_data.size();
+                return nullptr;
+            }
+
+            const auto *block = reinterpret_cast<const T *>(m_data.data() + m_cursor);
+            m_cursor += count * sizeof(T);
+            return block;
+        }
+
+        void skip(const size_t size) { m_cursor = std::min(m_cursor + size, m_data.size()); }
+
+        void seek(const size_t offset) { m_cursor = std::min(offset, m_data.size()); }
+
+        /**
+         * @brief Set the serializer version passed to ComponentSerializer::load
+         * @param version Version stored in the section being read
+         */
+        void set_version(const u32 version) { m_version = version; }
+
+        [[nodiscard]] size_t tell() const { return m_cursor; }
+        [[nodiscard]] size_t remaining() const { return m_data.size() - m_cursor; }
+        [[nodiscard]] bool has_failed() const { return m_failed; }
+
+    private:
+        std::span<const std::byte> m_data;
+        size_t m_cursor = 0;
+        u32 m_version = 0;
+        bool m_failed = false;
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "core/common.hpp"
+#include "ecs/serialization/binary_archive.hpp"
+#include "ecs/components/basic/name_component.hpp"
+#include "ecs/components/basic/tag_component.hpp"
+#include "ecs/components/basic/transform_component.hpp"
+#include "ecs/components/basic/world_anchor_component.hpp"
+#include "ecs/components/hierarchy/parent_component.hpp"
+#include "ecs/components/physics/physics_body_component.hpp"
+#include "ecs/components/physics/velocity_component.hpp"
+#include "ecs/components/renderer/camera_component.hpp"
+#include "ecs/components/renderer/camera_controller_component.hpp"
+#include "ecs/components/spatial/bounds_component.hpp"
+
+namespace softcube {
+    /**
+     * @struct RawComponentSerializer
+     * @brief Base for components stored as one memcpy-able block per snapshot
+     *
+     * Raw sections are bulk-inserted straight from the loaded bytes. They are
+     * only readable by a build with the same version and the same sizeof(T);
+     * bump the version whenever the layout of T changes.
+     */
+    template<typename T, u32 Version>
+    struct RawComponentSerializer {
+        static_assert(std::is_trivially_copyable_v<T>, "Raw components must be trivially copyable");
+
+        static constexpr bool raw = true;
+        static constexpr u32 version = Version;
+    };
+
+    /**
+     * @struct ComponentSerializer
+     * @brief Versioned snapshot serializer for a component type
+     *
+     * Specializations provide a stable name, a version and either derive from
+     * RawComponentSerializer or set raw = false and implement
+     * save(BinaryOutputArchive &, const T &) and load(BinaryInputArchive &, T &, u32 version).
+     * load receives the version the data was written with, so old snapshots can
+     * be upgraded field by field.
+     */
+    template<typename T>
+    struct ComponentSerializer;
+
+    template<>
+    struct ComponentSerializer<component::Transform> : RawComponentSerializer<component::Transform, 1> {
+        static constexpr const char *name = "Transform";
+    };
+
+    template<>
+    struct ComponentSerializer<component::WorldAnchor> : RawComponentSerializer<component::WorldAnchor, 1> {
+        static constexpr const char *name = "WorldAnchor";
+    };
+
+    template<>
+    struct ComponentSerializer<component::Parent> : RawComponentSerializer<component::Parent, 2> {
+        static constexpr const char *name = "Parent";
+    };
+
+    template<>
+    struct ComponentSerializer<component::Velocity> : RawComponentSerializer<component::Velocity, 1> {
+        static constexpr const char *name = "Velocity";
+    };
+
+    template<>
+    struct ComponentSerializer<component::PhysicsBody> : RawComponentSerializer<component::PhysicsBody, 1> {
+        static constexpr const char *name = "PhysicsBody";
+    };
+
+    template<>
+    struct ComponentSerializer<component::Bounds> : RawComponentSerializer<component::Bounds, 1> {
+        static constexpr const char *name = "Bounds";
+    };
+
+    template<>
+    struct ComponentSerializer<component::Camera> : RawComponentSerializer<component::Camera, 2> {
+        static constexpr const char *name = "Camera";
+    };
+
+    template<>
+    struct ComponentSerializer<component::CameraController>
+            : RawComponentSerializer<component::CameraController, 1> {
+        static constexpr const char *name = "CameraController";
+    };
+
+    template<>
+    struct ComponentSerializer<component::Name> {
+        static constexpr const char *name = "Name";
+        static constexpr bool raw = false;
+        static constexpr u32 version = 1;
+
+        static void save(BinaryOutputArchive &archive, const component::Name &value) {
+            archive.write_string(value.name);
+        }
+
+        static void load(BinaryInputArchive &archive, component::Name &value, u32) {
+            archive.read_string(value.name);
+        }
+    };
+
+    template<>
+    struct ComponentSerializer<component::Tag> {
+        static constexpr const char *name = "Tag";
+        static constexpr bool raw = false;
+        static constexpr u32 version = 1;
+
+        static void save(BinaryOutputArchive &archive, const component::Tag &value) {
+            archive.write_string(value.tag);
+        }
+
+        static void load(BinaryInputArchive &archive, component::Tag &value, u32) {
+            archive.read_string(value.tag);
+        }
+    };
+}
@@ -0,0 +1,220 @@
+#include "ecs/serialization/delta_history.hpp"
+
+namespace softcube {
+    DeltaHistory::DeltaHistory(const size_t capacity) : m_ring(std::max<size_t>(capacity, 1)) {
+    }
+
+    void DeltaHistory::reset_base(Registry &registry) {
+        for (const auto &component: m_components) {
+            component->reset(registry);
+        }
+
+        m_shadow_entities.clear();
+        for (const auto [entity]: registry.storage<entt::entity>().each()) {
+            m_shadow_entities.push(entity);
+        }
+
+        for (auto &tick: m_ring) {
+            tick.data.clear();
+        }
+
+        m_head = 0;
+        m_count = 0;
+        m_history_bytes = 0;
+    }
+
+    u64 DeltaHistory::capture(Registry &registry) {
+        const auto start = std::chrono::steady_clock::now();
+
+        BinaryOutputArchive archive;
+        write_delta(registry, archive, m_next_tick);
+
+        auto &slot = m_ring[m_head];
+        if (m_count == m_ring.size()) {
+            m_history_bytes -= slot.data.size();
+        } else {
+            ++m_count;
+        }
+
+        slot.number = m_next_tick;
+        slot.data = archive.release();
+        m_history_bytes += slot.data.size();
+        m_head = (m_head + 1) % m_ring.size();
+
+        m_last_capture_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return m_next_tick++;
+    }
+
+    bool DeltaHistory::rollback(Registry &registry, const size_t ticks) {
+        if (ticks > m_count) {
+            SC_WARN("Cannot roll back {} ticks, only {} recorded", ticks, m_count);
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        // Bring the registry back to the last captured state first.
+        BinaryOutputArchive uncaptured;
+        write_delta(registry, uncaptured, 0);
+        apply_delta(registry, {uncaptured.data(), uncaptured.size()}, detail::DeltaDirection::Backward);
+
+        for (size_t i = 0; i < ticks; ++i) {
+            m_head = (m_head + m_ring.size() - 1) % m_ring.size();
+
+            auto &slot = m_ring[m_head];
+            apply_delta(registry, slot.data, detail::DeltaDirection::Backward);
+
+            m_history_bytes -= slot.data.size();
+            slot.data.clear();
+            --m_count;
+            --m_next_tick;
+        }
+
+        m_last_restore_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        SC_DEBUG("Rolled back {} ticks in {:.3f} ms", ticks, m_last_restore_ms);
+        return true;
+    }
+
+    std::span<const std::byte> DeltaHistory::get_delta(const u64 tick) const {
+        const u64 newest = m_next_tick - 1;
+        if (tick > newest || newest - tick >= m_count) {
+            return {};
+        }
+
+        const size_t back = static_cast<size_t>(newest - tick) + 1;
+        return m_ring[(m_head + m_ring.size() - back) % m_ring.size()].data;
+    }
+
+    bool DeltaHistory::apply(Registry &registry, const std::span<const std::byte> delta) {
+        return apply_delta(registry, delta, detail::DeltaDirection::Forward);
+    }
+
+    DeltaHistory::Stats DeltaHistory::get_stats() const {
+        Stats stats;
+        stats.tick_count = m_count;
+        stats.history_bytes = m_history_bytes;
+        stats.shadow_bytes = m_shadow_entities.size() * sizeof(entt::entity);
+        for (const auto &component: m_components) {
+            stats.shadow_bytes += component->get_shadow_bytes();
+        }
+
+        if (m_count > 0) {
+            stats.last_tick_bytes = m_ring[(m_head + m_ring.size() - 1) % m_ring.size()].data.size();
+        }
+
+        stats.last_tick_records = m_last_tick_records;
+        stats.last_capture_ms = m_last_capture_ms;
+        stats.last_restore_ms = m_last_restore_ms;
+        return stats;
+    }
+
+    void DeltaHistory::write_delta(Registry &registry, BinaryOutputArchive &archive, const u64 tick) {
+        m_created.clear();
+        m_destroyed.clear();
+
+        for (const auto [entity]: registry.storage<entt::entity>().each()) {
+            if (!m_shadow_entities.contains(entity)) {
+                m_created.push_back(entity);
+            }
+        }
+
+        for (const auto entity: m_shadow_entities) {
+            if (!registry.valid(entity)) {
+                m_destroyed.push_back(entity);
+            }
+        }
+
+        // Erase first: a destroyed entity's slot may already be reused by a created one.
+        m_shadow_entities.erase(m_destroyed.begin(), m_destroyed.end());
+        m_shadow_entities.push(m_created.begin(), m_created.end());
+
+        archive.write(tick);
+        archive.write(static_cast<u32>(m_created.size()));
+        archive.write_bytes(m_created.data(), m_created.size() * sizeof(entt::entity));
+        archive.write(static_cast<u32>(m_destroyed.size()));
+        archive.write_bytes(m_destroyed.data(), m_destroyed.size() * sizeof(entt::entity));
+
+        size_t records = m_created.size() + m_destroyed.size();
+        for (const auto &component: m_components) {
+            const size_t size_offset = archive.size();
+            archive.write(u64{0});
+
+            records += component->capture(registry, archive);
+            archive.patch(size_offset, static_cast<u64>(archive.size() - size_offset - sizeof(u64)));
+        }
+
+        if (tick != 0) {
+            m_last_tick_records = records;
+        }
+    }
+
+    bool DeltaHistory::apply_delta(Registry &registry, const std::span<const std::byte> delta,
+                                   const detail::DeltaDirection direction) {
+        BinaryInputArchive archive(delta);
+
+        u64 tick = 0;
+        u32 created_count = 0;
+        u32 destroyed_count = 0;
+
+        archive.read(tick);
+        archive.read(created_count);
+        const auto *created = archive.read_block<entt::entity>(created_count, 1);
+        archive.read(destroyed_count);
+        const auto *destroyed = archive.read_block<entt::entity>(destroyed_count, 1);
+
+        std::vector<std::span<const std::byte> > sections;
+        sections.reserve(m_components.size());
+        for (size_t i = 0; i < m_components.size() && !archive.has_failed(); ++i) {
+            u64 size = 0;
+            archive.read(size);
+            if (size > archive.remaining()) {
+                break;
+            }
+
+            sections.push_back(delta.subspan(archive.tell(), size));
+            archive.skip(size);
+        }
+
+        if (archive.has_failed() || sections.size() != m_components.size()) {
+            SC_ERROR("Malformed delta for tick {}", tick);
+            return false;
+        }
+
+        // The blocks are unaligned inside the delta, so copy the handles out.
+        std::vector<entt::entity> to_destroy(destroyed_count);
+        std::vector<entt::entity> to_create(created_count);
+        std::memcpy(to_destroy.data(), destroyed, destroyed_count * sizeof(entt::entity));
+        std::memcpy(to_create.data(), created, created_count * sizeof(entt::entity));
+
+        if (direction == detail::DeltaDirection::Backward) {
+            std::swap(to_destroy, to_create);
+        }
+
+        for (size_t i = 0; i < m_components.size(); ++i) {
+            m_components[i]->apply(registry, sections[i], direction, false);
+        }
+
+        for (const auto entity: to_destroy) {
+            if (registry.valid(entity)) {
+                registry.destroy(entity);
+            }
+            if (m_shadow_entities.contains(entity)) {
+                m_shadow_entities.erase(entity);
+            }
+        }
+
+        for (const auto entity: to_create) {
+            [[maybe_unused]] const auto restored = registry.create(entity);
+            SOFTCUBE_ASSERT(restored == entity, "Entity slot is not available for restore");
+            if (!m_shadow_entities.contains(entity)) {
+                m_shadow_entities.push(entity);
+            }
+        }
+
+        for (size_t i = 0; i < m_components.size(); ++i) {
+            m_components[i]->apply(registry, sections[i], direction, true);
+        }
+
+        return true;
+    }
+}
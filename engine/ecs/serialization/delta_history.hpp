@@ -0,0 +1,378 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "ecs/registry.hpp"
+#include "ecs/serialization/binary_archive.hpp"
+
+#include <span>
+
+namespace softcube {
+    namespace detail {
+        /**
+         * @brief Kind of change recorded for one component of one entity
+         */
+        enum class DeltaKind : u8 {
+            Changed = 0, // Present before and after; stores old ^ new
+            Added = 1, // Absent before; stores the new value
+            Removed = 2 // Absent after; stores the old value
+        };
+
+        /**
+         * @brief Direction a delta is applied in
+         */
+        enum class DeltaDirection : u8 {
+            Forward,
+            Backward
+        };
+
+        /**
+         * @brief Encode a ^ b as alternating zero runs and literal bytes
+         *
+         * Unchanged bytes XOR to zero, so a component where only a few fields moved
+         * encodes to a handful of bytes. Passing nullptr for b encodes a itself.
+         */
+        inline void encode_xor(BinaryOutputArchive &archive, const std::byte *a, const std::byte *b,
+                               const size_t size) {
+            auto byte_at = [a, b](const size_t i) { return b ? a[i] ^ b[i] : a[i]; };
+
+            size_t i = 0;
+            while (i < size) {
+                u8 zero_run = 0;
+                while (i < size && zero_run < 255 && byte_at(i) == std::byte{0}) {
+                    ++zero_run;
+                    ++i;
+                }
+
+                const size_t literal_start = i;
+                u8 literal_length = 0;
+                while (i < size && literal_length < 255 && byte_at(i) != std::byte{0}) {
+                    ++literal_length;
+                    ++i;
+                }
+
+                archive.write(zero_run);
+                archive.write(literal_length);
+                for (size_t j = literal_start; j < literal_start + literal_length; ++j) {
+                    archive.write(byte_at(j));
+                }
+            }
+        }
+
+        /**
+         * @brief XOR an encoded difference into a value
+         * @param encoded Bytes produced by encode_xor
+         * @param target Value to update in place
+         * @param size Size of the value in bytes
+         */
+        inline void apply_xor(const std::span<const std::byte> encoded, std::byte *target, const size_t size) {
+            size_t in = 0;
+            size_t out = 0;
+
+            while (in + 2 <= encoded.size() && out < size) {
+                out += static_cast<u8>(encoded[in]);
+                const auto literal_length = static_cast<u8>(encoded[in + 1]);
+                in += 2;
+
+                for (u8 j = 0; j < literal_length && out < size && in < encoded.size(); ++j) {
+                    target[out++] ^= encoded[in++];
+                }
+            }
+        }
+
+        /**
+         * @class TrackedComponentBase
+         * @brief Type-erased change tracker for one component type
+         */
+        class TrackedComponentBase {
+        public:
+            virtual ~TrackedComponentBase() = default;
+
+            /**
+             * @brief Copy the current state of the component into the shadow
+             * @param registry Registry to read from
+             */
+            virtual void reset(Registry &registry) = 0;
+
+            /**
+             * @brief Write every difference between the registry and the shadow, then sync the shadow
+             * @param registry Registry to read from
+             * @param archive Delta being written
+             * @return Number of records written
+             */
+            virtual size_t capture(Registry &registry, BinaryOutputArchive &archive) = 0;
+
+            /**
+             * @brief Apply the records of one section
+             *
+             * Records that make a component disappear and in-place changes are
+             * applied in the first pass, before entities are destroyed. Records
+             * that make a component appear are applied in the second pass, after
+             * entities are created.
+             *
+             * @param registry Registry to update, together with the shadow
+             * @param section Records written by capture
+             * @param direction Forward to redo the delta, backward to undo it
+             * @param second_pass Which of the two passes to apply
+             */
+            virtual void apply(Registry &registry, std::span<const std::byte> section,
+                               DeltaDirection direction, bool second_pass) = 0;
+
+            [[nodiscard]] virtual size_t get_shadow_bytes() const = 0;
+        };
+
+        template<typename T>
+        class TrackedComponent final : public TrackedComponentBase {
+            static_assert(std::is_trivially_copyable_v<T> && !std::is_empty_v<T>,
+                          "Tracked components must be trivially copyable and hold data");
+
+        public:
+            void reset(Registry &registry) override {
+                m_shadow.clear();
+
+                const auto &live = registry.storage<T>();
+                m_shadow.reserve(live.size());
+                for (const auto &[entity, value]: live.each()) {
+                    m_shadow.emplace(entity, value);
+                }
+            }
+
+            size_t capture(Registry &registry, BinaryOutputArchive &archive) override {
+                const auto &live = registry.storage<T>();
+                size_t records = 0;
+
+                for (const auto &[entity, value]: live.each()) {
+                    const auto *current = reinterpret_cast<const std::byte *>(&value);
+
+                    if (m_shadow.contains(entity)) {
+                        auto &previous = m_shadow.get(entity);
+                        if (std::memcmp(&previous, &value, sizeof(T)) == 0) {
+                            continue;
+                        }
+
+                        write_record(archive, entity, DeltaKind::Changed,
+                                     reinterpret_cast<const std::byte *>(&previous), current);
+                        previous = value;
+                    } else {
+                        write_record(archive, entity, DeltaKind::Added, current, nullptr);
+                        m_shadow.emplace(entity, value);
+                    }
+                    ++records;
+                }
+
+                m_removed.clear();
+                for (const auto &[entity, previous]: m_shadow.each()) {
+                    if (!live.contains(entity)) {
+                        write_record(archive, entity, DeltaKind::Removed,
+                                     reinterpret_cast<const std::byte *>(&previous), nullptr);
+                        m_removed.push_back(entity);
+                        ++records;
+                    }
+                }
+                m_shadow.erase(m_removed.begin(), m_removed.end());
+
+                return records;
+            }
+
+            void apply(Registry &registry, const std::span<const std::byte> section,
+                       const DeltaDirection direction, const bool second_pass) override {
+                const DeltaKind appears = direction == DeltaDirection::Forward ? DeltaKind::Added : DeltaKind::Removed;
+                const DeltaKind disappears = direction == DeltaDirection::Forward
+                                                 ? DeltaKind::Removed
+                                                 : DeltaKind::Added;
+
+                BinaryInputArchive archive(section);
+                while (archive.remaining() > 0 && !archive.has_failed()) {
+                    entt::entity entity = entt::null;
+                    DeltaKind kind{};
+                    u16 length = 0;
+                    archive.read(entity);
+                    archive.read(kind);
+                    archive.read(length);
+
+                    const size_t offset = archive.tell();
+                    const auto encoded = section.subspan(offset, std::min<size_t>(length, archive.remaining()));
+                    archive.skip(length);
+
+                    if (!second_pass && kind == DeltaKind::Changed) {
+                        if (auto *value = registry.try_get<T>(entity)) {
+                            apply_xor(encoded, reinterpret_cast<std::byte *>(value), sizeof(T));
+                            sync_shadow(entity, *value);
+                        }
+                    } else if (!second_pass && kind == disappears) {
+                        if (registry.valid(entity)) {
+                            registry.remove<T>(entity);
+                        }
+                        if (m_shadow.contains(entity)) {
+                            m_shadow.erase(entity);
+                        }
+                    } else if (second_pass && kind == appears && registry.valid(entity)) {
+                        T value;
+                        std::memset(reinterpret_cast<void *>(&value), 0, sizeof(T));
+                        apply_xor(encoded, reinterpret_cast<std::byte *>(&value), sizeof(T));
+                        registry.emplace_or_replace<T>(entity, value);
+                        sync_shadow(entity, value);
+                    }
+                }
+            }
+
+            [[nodiscard]] size_t get_shadow_bytes() const override {
+                return m_shadow.size() * (sizeof(T) + sizeof(entt::entity));
+            }
+
+        private:
+            static void write_record(BinaryOutputArchive &archive, const entt::entity entity, const DeltaKind kind,
+                                     const std::byte *a, const std::byte *b) {
+                archive.write(entity);
+                archive.write(kind);
+
+                const size_t length_offset = archive.size();
+                archive.write(u16{0});
+
+                encode_xor(archive, a, b, sizeof(T));
+                archive.patch(length_offset, static_cast<u16>(archive.size() - length_offset - sizeof(u16)));
+            }
+
+            void sync_shadow(const entt::entity entity, const T &value) {
+                if (m_shadow.contains(entity)) {
+                    m_shadow.get(entity) = value;
+                } else {
+                    m_shadow.emplace(entity, value);
+                }
+            }
+
+            entt::storage<T> m_shadow;
+            std::vector<entt::entity> m_removed;
+        };
+    }
+
+    /**
+     * @class DeltaHistory
+     * @brief Ring buffer of per-tick registry deltas for rollback, replication and undo
+     *
+     * Tracked components are compared against a shadow copy of the last captured
+     * state, so systems need no instrumentation. Each tick stores only entities
+     * created or destroyed and the components that differ, encoded as the XOR of
+     * the old and new bytes with zero runs collapsed. XOR deltas are symmetric:
+     * the same bytes redo a tick on a replica or undo it locally.
+     *
+     * Only tracked components are restored. Untracked components of an entity
+     * destroyed and later rolled back are lost, so track everything that must
+     * survive a rollback. Components kept in sync by signals (such as Children)
+     * should not be tracked alongside their source.
+     */
+    class DeltaHistory {
+        SC_LOG_GROUP(ECS::DELTA_HISTORY);
+
+    public:
+        /**
+         * @struct Stats
+         * @brief Memory and latency figures of the history
+         */
+        struct Stats {
+            size_t tick_count = 0;
+            size_t history_bytes = 0; // Sum of all stored deltas
+            size_t shadow_bytes = 0; // Copy of the last captured state
+            size_t last_tick_bytes = 0;
+            size_t last_tick_records = 0;
+            float last_capture_ms = 0.0f;
+            float last_restore_ms = 0.0f;
+
+            [[nodiscard]] float get_average_tick_bytes() const {
+                return tick_count > 0 ? static_cast<float>(history_bytes) / static_cast<float>(tick_count) : 0.0f;
+            }
+        };
+
+        /**
+         * @brief Construct an empty history
+         * @param capacity Number of ticks kept; older ticks are discarded
+         */
+        explicit DeltaHistory(size_t capacity = 128);
+
+        /**
+         * @brief Track a component type
+         *
+         * Must be called before reset_base().
+         *
+         * @tparam T Trivially copyable component type
+         */
+        template<typename T>
+        void track() {
+            m_components.push_back(std::make_unique<detail::TrackedComponent<T> >());
+        }
+
+        /**
+         * @brief Make the current registry state the base and drop all history
+         * @param registry Registry to track
+         */
+        void reset_base(Registry &registry);
+
+        /**
+         * @brief Record everything that changed since the previous capture as a new tick
+         * @param registry Registry to read from
+         * @return Number of the recorded tick
+         */
+        u64 capture(Registry &registry);
+
+        /**
+         * @brief Restore the registry to the state it had a number of ticks ago
+         *
+         * Changes made since the last capture are discarded first, then the last
+         * ticks are undone and removed from the history.
+         *
+         * @param registry Registry to restore
+         * @param ticks Number of captured ticks to undo
+         * @return False if the history holds fewer ticks than requested; nothing is undone then
+         */
+        bool rollback(Registry &registry, size_t ticks);
+
+        /**
+         * @brief Get the encoded delta of a tick, for sending to a replica
+         * @param tick Tick number returned by capture
+         * @return Delta bytes, or an empty span if the tick is no longer in the history
+         */
+        [[nodiscard]] std::span<const std::byte> get_delta(u64 tick) const;
+
+        /**
+         * @brief Apply a delta produced by another history with the same tracked types
+         *
+         * The registry must be in the state the delta was captured against.
+         *
+         * @param registry Registry to update
+         * @param delta Bytes returned by get_delta
+         * @return True if the delta was well formed
+         */
+        bool apply(Registry &registry, std::span<const std::byte> delta);
+
+        [[nodiscard]] u64 get_current_tick() const { return m_next_tick - 1; }
+        [[nodiscard]] size_t get_tick_count() const { return m_count; }
+        [[nodiscard]] size_t get_capacity() const { return m_ring.size(); }
+
+        [[nodiscard]] Stats get_stats() const;
+
+    private:
+        struct Tick {
+            u64 number = 0;
+            std::vector<std::byte> data;
+        };
+
+        void write_delta(Registry &registry, BinaryOutputArchive &archive, u64 tick);
+
+        bool apply_delta(Registry &registry, std::span<const std::byte> delta, detail::DeltaDirection direction);
+
+        std::vector<std::unique_ptr<detail::TrackedComponentBase> > m_components;
+
+        entt::sparse_set m_shadow_entities;
+        std::vector<entt::entity> m_created;
+        std::vector<entt::entity> m_destroyed;
+
+        std::vector<Tick> m_ring;
+        size_t m_head = 0; // Slot the next tick is written to
+        size_t m_count = 0;
+        u64 m_next_tick = 1;
+
+        size_t m_history_bytes = 0;
+        size_t m_last_tick_records = 0;
+        float m_last_capture_ms = 0.0f;
+        float m_last_restore_ms = 0.0f;
+    };
+}
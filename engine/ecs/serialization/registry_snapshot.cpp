@@ -0,0 +1,153 @@
+#include "ecs/serialization/registry_snapshot.hpp"
+#include "core/mapped_file.hpp"
+
+namespace softcube {
+    RegistrySnapshot::RegistrySnapshot() {
+        register_component<component::Transform>();
+        register_component<component::WorldAnchor>();
+        register_component<component::Name>();
+        register_component<component::Tag>();
+        register_component<component::Velocity>();
+        register_component<component::PhysicsBody>();
+        register_component<component::Bounds>();
+        register_component<component::Camera>();
+        register_component<component::CameraController>();
+
+        // Last, so the hierarchy signals see every other component of the parent
+        register_component<component::Parent>();
+    }
+
+    std::vector<std::byte> RegistrySnapshot::save(const Registry &registry) const {
+        BinaryOutputArchive archive;
+
+        const auto *entities = registry.storage<entt::entity>();
+        archive.reserve(entities ? entities->size() * (sizeof(entt::entity) + sizeof(component::Transform)) : 0);
+
+        archive.write(FileHeader{magic, format_version, 0, 0});
+        Snapshot{registry}.get<entt::entity>(archive);
+
+        u32 section_count = 0;
+        for (const auto &entry: m_components) {
+            if (!entry.has_data(registry)) {
+                continue;
+            }
+
+            archive.align(section_alignment);
+            const size_t header_offset = archive.size();
+            archive.write(SectionHeader{});
+
+            const size_t body_offset = archive.size();
+            entry.save(registry, archive);
+            archive.align(section_alignment);
+
+            archive.patch(header_offset, SectionHeader{
+                              entry.id, entry.version, entry.element_size, entry.raw ? 1u : 0u,
+                              static_cast<u64>(archive.size() - body_offset)
+                          });
+            ++section_count;
+        }
+
+        archive.patch(0, FileHeader{magic, format_version, section_count, 0});
+        return archive.release();
+    }
+
+    bool RegistrySnapshot::save(const Registry &registry, const std::filesystem::path &path) const {
+        const auto data = save(registry);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            SC_ERROR("Failed to open {} for writing", path.string());
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            SC_ERROR("Failed to write snapshot to {}", path.string());
+            return false;
+        }
+
+        SC_INFO("Saved snapshot to {} ({} bytes)", path.string(), data.size());
+        return true;
+    }
+
+    bool RegistrySnapshot::load(Registry &registry, const std::span<const std::byte> data) const {
+        BinaryInputArchive archive(data);
+
+        FileHeader header{};
+        archive.read(header);
+        if (archive.has_failed() || header.magic != magic) {
+            SC_ERROR("Not a snapshot");
+            return false;
+        }
+
+        if (header.format_version != format_version) {
+            SC_ERROR("Unsupported snapshot format version {} (expected {})", header.format_version, format_version);
+            return false;
+        }
+
+        // The loader restores the entity pool as a whole and needs a clean registry.
+        registry.clear();
+        registry.storage<entt::entity>().clear();
+
+        SnapshotLoader loader{registry};
+        loader.get<entt::entity>(archive);
+
+        for (u32 i = 0; i < header.section_count && !archive.has_failed(); ++i) {
+            archive.align(section_alignment);
+
+            SectionHeader section{};
+            archive.read(section);
+
+            const size_t body_offset = archive.tell();
+            if (section.byte_size > archive.remaining()) {
+                SC_ERROR("Snapshot section {} is truncated", i);
+                return false;
+            }
+
+            const auto *entry = find_component(section.id);
+            if (!entry) {
+                SC_WARN("Skipping unknown component section {:#x}", section.id);
+            } else if (entry->raw != (section.raw != 0) || section.version > entry->version ||
+                       (entry->raw && (section.version != entry->version ||
+                                       section.element_size != entry->element_size))) {
+                SC_WARN("Skipping {} section: written with version {}, layout incompatible with version {}",
+                        entry->name, section.version, entry->version);
+            } else {
+                archive.set_version(section.version);
+                entry->load(registry, loader, archive);
+            }
+
+            archive.seek(body_offset + section.byte_size);
+        }
+
+        if (archive.has_failed()) {
+            SC_ERROR("Snapshot is truncated or corrupt");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool RegistrySnapshot::load(Registry &registry, const std::filesystem::path &path) const {
+        MappedFile file;
+        if (!file.open(path)) {
+            return false;
+        }
+
+        if (!load(registry, file.get_data())) {
+            SC_ERROR("Failed to load snapshot from {}", path.string());
+            return false;
+        }
+
+        SC_INFO("Loaded snapshot from {} ({} bytes)", path.string(), file.get_size());
+        return true;
+    }
+
+    const RegistrySnapshot::ComponentEntry *RegistrySnapshot::find_component(const u32 id) const {
+        const auto it = std::ranges::find_if(m_components, [id](const ComponentEntry &entry) {
+            return entry.id == id;
+        });
+
+        return it != m_components.end() ? &*it : nullptr;
+    }
+}
@@ -0,0 +1,203 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "ecs/registry.hpp"
+#include "ecs/serialization/binary_archive.hpp"
+#include "ecs/serialization/component_serializer.hpp"
+
+#include <span>
+
+namespace softcube {
+    /**
+     * @class RegistrySnapshot
+     * @brief Binary save and restore of a whole registry
+     *
+     * The entity pool is written with entt::snapshot so identifiers, versions and
+     * the free list survive a round trip. Every registered component follows in
+     * its own section. Raw components are one entity block plus one component
+     * block, restored by a single bulk insert that reads straight out of a mapped
+     * file. Other components go through entt::snapshot and their versioned
+     * ComponentSerializer.
+     *
+     * Children is not serialized; the HierarchySystem rebuilds it and the sibling
+     * links from Parent.
+     * MeshRenderer owns GPU resources and must be recreated after loading.
+     */
+    class RegistrySnapshot {
+        SC_LOG_GROUP(ECS::SNAPSHOT);
+
+    public:
+        static constexpr u32 magic = 0x50414E53; // "SNAP"
+        static constexpr u32 format_version = 1;
+        static constexpr size_t section_alignment = 16;
+
+        /**
+         * @brief Construct a snapshot description with every engine component registered
+         */
+        RegistrySnapshot();
+
+        /**
+         * @brief Add a component type to the snapshot
+         *
+         * Sections are written and loaded in registration order.
+         *
+         * @tparam T Component type with a ComponentSerializer specialization
+         */
+        template<typename T>
+        void register_component();
+
+        /**
+         * @brief Serialize a registry into memory
+         * @param registry Registry to save
+         * @return Snapshot bytes
+         */
+        [[nodiscard]] std::vector<std::byte> save(const Registry &registry) const;
+
+        /**
+         * @brief Serialize a registry to a file
+         * @param registry Registry to save
+         * @param path Destination file
+         * @return True if the file was written
+         */
+        bool save(const Registry &registry, const std::filesystem::path &path) const;
+
+        /**
+         * @brief Replace the contents of a registry with a snapshot
+         * @param registry Registry to restore into; existing entities are destroyed
+         * @param data Snapshot bytes
+         * @return True if the snapshot was valid and fully loaded
+         */
+        bool load(Registry &registry, std::span<const std::byte> data) const;
+
+        /**
+         * @brief Memory-map a snapshot file and restore it
+         * @param registry Registry to restore into; existing entities are destroyed
+         * @param path Snapshot file
+         * @return True if the snapshot was valid and fully loaded
+         */
+        bool load(Registry &registry, const std::filesystem::path &path) const;
+
+    private:
+        struct FileHeader {
+            u32 magic;
+            u32 format_version;
+            u32 section_count;
+            u32 reserved;
+        };
+
+        struct SectionHeader {
+            u32 id;
+            u32 version;
+            u32 element_size; // sizeof(T) for raw sections, 0 otherwise
+            u32 raw;
+            u64 byte_size; // Size of the section body, excluding this header
+        };
+
+        struct ComponentEntry {
+            u32 id;
+            const char *name;
+            u32 version;
+            bool raw;
+            u32 element_size;
+
+            bool (*has_data)(const Registry &);
+
+            void (*save)(const Registry &, BinaryOutputArchive &);
+
+            void (*load)(Registry &, SnapshotLoader &, BinaryInputArchive &);
+        };
+
+        template<typename T>
+        static void save_raw(const Registry &registry, BinaryOutputArchive &archive);
+
+        template<typename T>
+        static void load_raw(Registry &registry, SnapshotLoader &loader, BinaryInputArchive &archive);
+
+        [[nodiscard]] const ComponentEntry *find_component(u32 id) const;
+
+        std::vector<ComponentEntry> m_components;
+    };
+
+    template<typename T>
+    void RegistrySnapshot::register_component() {
+        using Serializer = ComponentSerializer<T>;
+
+        ComponentEntry entry{};
+        entry.id = entt::hashed_string::value(Serializer::name);
+        entry.name = Serializer::name;
+        entry.version = Serializer::version;
+        entry.raw = Serializer::raw;
+        entry.element_size = Serializer::raw ? static_cast<u32>(sizeof(T)) : 0u;
+
+        entry.has_data = [](const Registry &registry) {
+            const auto *storage = registry.storage<T>();
+            return storage && !storage->empty();
+        };
+
+        if constexpr (Serializer::raw) {
+            entry.save = &save_raw<T>;
+            entry.load = &load_raw<T>;
+        } else {
+            entry.save = [](const Registry &registry, BinaryOutputArchive &archive) {
+                Snapshot{registry}.get<T>(archive);
+            };
+            entry.load = [](Registry &, SnapshotLoader &loader, BinaryInputArchive &archive) {
+                loader.get<T>(archive);
+            };
+        }
+
+        SOFTCUBE_ASSERT(find_component(entry.id) == nullptr, "Component registered twice or name collision");
+        m_components.push_back(entry);
+    }
+
+    template<typename T>
+    void RegistrySnapshot::save_raw(const Registry &registry, BinaryOutputArchive &archive) {
+        const auto &storage = *registry.storage<T>();
+        const auto count = static_cast<std::underlying_type_t<entt::entity>>(storage.size());
+        archive(count);
+
+        const size_t entity_offset = archive.reserve_block(count * sizeof(entt::entity), alignof(entt::entity));
+        const size_t component_offset = std::is_empty_v<T>
+                                            ? archive.size()
+                                            : archive.reserve_block(count * sizeof(T), section_alignment);
+
+        auto *entities = reinterpret_cast<entt::entity *>(archive.data() + entity_offset);
+        size_t index = 0;
+
+        if constexpr (std::is_empty_v<T>) {
+            for (const auto [entity]: storage.each()) {
+                entities[index++] = entity;
+            }
+        } else {
+            auto *components = archive.data() + component_offset;
+            for (const auto &[entity, component]: storage.each()) {
+                entities[index] = entity;
+                std::memcpy(components + index * sizeof(T), &component, sizeof(T));
+                ++index;
+            }
+        }
+    }
+
+    template<typename T>
+    void RegistrySnapshot::load_raw(Registry &registry, SnapshotLoader &,
+                                    BinaryInputArchive &archive) {
+        std::underlying_type_t<entt::entity> count = 0;
+        archive(count);
+
+        const auto *entities = archive.read_block<entt::entity>(count);
+        if (!entities || count == 0) {
+            return;
+        }
+
+        auto &storage = registry.storage<T>();
+        storage.reserve(storage.size() + count);
+
+        if constexpr (std::is_empty_v<T>) {
+            registry.insert<T>(entities, entities + count);
+        } else {
+            if (const auto *components = archive.read_block<T>(count, section_alignment)) {
+                registry.insert<T>(entities, entities + count, components);
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include "ecs/system_profiler.hpp"
+#include "ecs/systems/system_base.hpp"
+
+namespace softcube {
+    SystemProfiler::Scope::Scope(SystemProfiler &profiler, const size_t index)
+        : m_profiler(profiler.is_enabled() ? &profiler : nullptr), m_index(index) {
+        if (m_profiler) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    SystemProfiler::Scope::~Scope() {
+        if (m_profiler) {
+            const auto elapsed = std::chrono::steady_clock::now() - m_start;
+            m_profiler->record(m_index, std::chrono::duration<float, std::milli>(elapsed).count());
+        }
+    }
+
+    size_t SystemProfiler::add_system(const system::System &system, const bool rendering) {
+        auto &entry = m_entries.emplace_back();
+        entry.system = &system;
+        entry.rendering = rendering;
+        return m_entries.size() - 1;
+    }
+
+    void SystemProfiler::record(const size_t index, const float milliseconds) {
+        auto &entry = m_entries[index];
+        entry.samples[entry.head] = milliseconds;
+        entry.head = (entry.head + 1) % history_size;
+        entry.sample_count = std::min(entry.sample_count + 1, history_size);
+        entry.processed_count = entry.system->get_processed_count();
+    }
+
+    SystemProfiler::Stats SystemProfiler::get_stats(const size_t index) const {
+        const auto &entry = m_entries[index];
+
+        Stats stats;
+        stats.sample_count = entry.sample_count;
+        if (entry.sample_count == 0) {
+            return stats;
+        }
+
+        std::array<float, history_size> sorted = entry.samples;
+        const auto begin = sorted.begin();
+        const auto end = begin + static_cast<std::ptrdiff_t>(entry.sample_count);
+
+        stats.last_ms = entry.samples[(entry.head + history_size - 1) % history_size];
+        stats.average_ms = std::accumulate(begin, end, 0.0f) / static_cast<float>(entry.sample_count);
+        stats.max_ms = *std::max_element(begin, end);
+
+        // Nearest-rank percentile
+        const size_t rank = (entry.sample_count * 95 + 99) / 100 - 1;
+        std::nth_element(begin, begin + static_cast<std::ptrdiff_t>(rank), end);
+        stats.p95_ms = sorted[rank];
+
+        return stats;
+    }
+
+    size_t SystemProfiler::get_history(const size_t index, std::array<float, history_size> &out) const {
+        const auto &entry = m_entries[index];
+        const size_t first = (entry.head + history_size - entry.sample_count) % history_size;
+
+        for (size_t i = 0; i < entry.sample_count; ++i) {
+            out[i] = entry.samples[(first + i) % history_size];
+        }
+
+        return entry.sample_count;
+    }
+
+    bool SystemProfiler::dump_csv(const std::filesystem::path &path) const {
+        std::ofstream file(path);
+        if (!file) {
+            SC_ERROR("Failed to open {} for writing", path.string());
+            return false;
+        }
+
+        file << "system,phase,samples,last_ms,avg_ms,p95_ms,max_ms,entities\n";
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            const auto &entry = m_entries[i];
+            const auto stats = get_stats(i);
+
+            file << entry.system->get_name() << ','
+                    << (entry.rendering ? "render" : "update") << ','
+                    << stats.sample_count << ','
+                    << stats.last_ms << ','
+                    << stats.average_ms << ','
+                    << stats.p95_ms << ','
+                    << stats.max_ms << ','
+                    << entry.processed_count << '\n';
+        }
+
+        SC_INFO("Wrote system profile for {} systems to {}", m_entries.size(), path.string());
+        return true;
+    }
+
+    void SystemProfiler::reset() {
+        for (auto &entry: m_entries) {
+            entry.head = 0;
+            entry.sample_count = 0;
+            entry.processed_count = 0;
+        }
+    }
+}
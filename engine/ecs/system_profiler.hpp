@@ -0,0 +1,120 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/logging.hpp"
+
+namespace softcube {
+    namespace system {
+        class System;
+    }
+
+    /**
+     * @class SystemProfiler
+     * @brief Rolling per-system timing history for the systems run by EcsManager
+     *
+     * Each registered system keeps the last history_size update durations and the
+     * entity count of its last update. Statistics are computed on demand so that
+     * recording a sample stays a couple of stores.
+     */
+    class SystemProfiler {
+        SC_LOG_GROUP(ECS::SYSTEM_PROFILER);
+
+    public:
+        static constexpr size_t history_size = 240;
+
+        /**
+         * @struct Stats
+         * @brief Summary of a system's timing history, in milliseconds
+         */
+        struct Stats {
+            float last_ms = 0.0f;
+            float average_ms = 0.0f;
+            float p95_ms = 0.0f;
+            float max_ms = 0.0f;
+            size_t sample_count = 0;
+        };
+
+        /**
+         * @struct Entry
+         * @brief Timing history of one system
+         */
+        struct Entry {
+            const system::System *system = nullptr;
+            bool rendering = false;
+            std::array<float, history_size> samples{};
+            size_t head = 0; // Index the next sample is written to
+            size_t sample_count = 0;
+            size_t processed_count = 0;
+        };
+
+        /**
+         * @class Scope
+         * @brief Times one system update and records it when destroyed
+         */
+        class Scope {
+        public:
+            Scope(SystemProfiler &profiler, size_t index);
+
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            SystemProfiler *m_profiler;
+            size_t m_index;
+            std::chrono::steady_clock::time_point m_start;
+        };
+
+        /**
+         * @brief Register a system
+         * @param system System to track; must outlive the profiler
+         * @param rendering Whether the system runs in the render phase
+         * @return Index used to record samples for the system
+         */
+        size_t add_system(const system::System &system, bool rendering);
+
+        /**
+         * @brief Record one update of a system
+         * @param index Index returned by add_system
+         * @param milliseconds Duration of the update
+         */
+        void record(size_t index, float milliseconds);
+
+        /**
+         * @brief Compute the statistics of a system's history
+         * @param index Index returned by add_system
+         * @return Last, average, 95th percentile and maximum duration
+         */
+        [[nodiscard]] Stats get_stats(size_t index) const;
+
+        /**
+         * @brief Copy a system's history into chronological order
+         * @param index Index returned by add_system
+         * @param out Destination, oldest sample first
+         * @return Number of samples written
+         */
+        size_t get_history(size_t index, std::array<float, history_size> &out) const;
+
+        [[nodiscard]] const std::vector<Entry> &get_entries() const { return m_entries; }
+
+        /**
+         * @brief Write the statistics of every system to a CSV file
+         * @param path Destination file
+         * @return True if the file was written
+         */
+        [[nodiscard]] bool dump_csv(const std::filesystem::path &path) const;
+
+        /**
+         * @brief Discard the recorded history of every system
+         */
+        void reset();
+
+        void set_enabled(const bool enabled) { m_enabled = enabled; }
+        [[nodiscard]] bool is_enabled() const { return m_enabled; }
+
+    private:
+        std::vector<Entry> m_entries;
+        bool m_enabled = true;
+    };
+}
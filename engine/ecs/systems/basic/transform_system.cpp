@@ -4,12 +4,14 @@
 
 namespace softcube::system {
     void TransformSystem::update(float dt) {
-        for (const auto view = m_registry->view<component::Transform>(); const auto entity: view) {
-            auto &transform = view.get<component::Transform>(entity);
+        m_processed_count = 0;
 
-            if (m_registry->all_of<component::Parent>(entity)) {
-                continue;
-            }
+        // Entities with a Parent component belong to the HierarchySystem; excluding
+        // them here avoids a Parent lookup per entity.
+        for (const auto view = m_registry->view<component::Transform>(entt::exclude<component::Parent>);
+             const auto entity: view) {
+            auto &transform = view.get<component::Transform>(entity);
+            ++m_processed_count;
 
             if (transform.parent != entt::null && m_registry->valid(transform.parent)) {
                 if (m_registry->all_of<component::Transform>(transform.parent)) {
@@ -52,10 +54,41 @@ namespace softcube::system {
                     transform.matrix_dirty = true;
                 }
             }
+        }
 
+        update_world_matrices();
+    }
+
+    void TransformSystem::update_world_matrices() {
+        // Linear pass over the packed Transform pool; covers parented entities too.
+        m_dirty.clear();
+        for (auto &transform: m_registry->storage<component::Transform>()) {
             if (transform.matrix_dirty) {
-                transform.matrix_dirty = false;
+                m_dirty.push_back(&transform);
             }
         }
+
+        if (m_dirty.empty()) {
+            return;
+        }
+
+        const size_t count = m_dirty.size();
+        m_positions.resize(count);
+        m_rotations.resize(count);
+        m_scales.resize(count);
+        m_matrices.resize(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            m_positions.set(i, m_dirty[i]->position);
+            m_rotations.set(i, m_dirty[i]->rotation);
+            m_scales.set(i, m_dirty[i]->scale);
+        }
+
+        math::compose_trs(m_positions, m_rotations, m_scales, m_matrices);
+
+        for (size_t i = 0; i < count; ++i) {
+            m_dirty[i]->world_matrix = m_matrices[i];
+            m_dirty[i]->matrix_dirty = false;
+        }
     }
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include "core/math/stream.hpp"
+#include "ecs/components/basic/transform_component.hpp"
 #include "ecs/systems/system_base.hpp"
 
 namespace softcube::system {
@@ -10,11 +12,27 @@ namespace softcube::system {
      * and ensures that child entities inherit their parent's transform.
      * Note: This system handles transforms with direct parent references.
      * For transforms with Parent components, use the HierarchySystem.
+     *
+     * Dirty world matrices of every transform are then rebuilt in one batch:
+     * position, rotation and scale are gathered into structure-of-arrays
+     * scratch buffers and composed with math::compose_trs.
      */
     class TransformSystem final : public System {
     public:
         TransformSystem() = default;
 
         void update(float dt) override;
+
+        [[nodiscard]] const char *get_name() const override { return "Transform"; }
+
+    private:
+        // Scratch reused every update so rebuilding matrices does not allocate once warmed up.
+        std::vector<component::Transform *> m_dirty;
+        Vector3Array m_positions;
+        QuaternionArray m_rotations;
+        Vector3Array m_scales;
+        std::vector<Matrix4> m_matrices;
+
+        void update_world_matrices();
     };
 }
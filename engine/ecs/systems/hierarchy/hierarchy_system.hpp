@@ -15,9 +15,14 @@ namespace softcube::system {
     /**
      * @class HierarchySystem
      * @brief System for managing entity hierarchies
-     * 
+     *
      * This system handles parent-child relationships between entities
      * and ensures proper propagation of transforms through the hierarchy.
+     *
+     * Children are kept in an intrusive list: Children on the parent holds the
+     * first and last child, and each child's Parent holds its sibling links and
+     * depth. Attaching and detaching are O(1) plus a walk of the moved subtree
+     * to fix depths, and no hierarchy operation allocates.
      */
     class HierarchySystem final : public System {
         SC_LOG_GROUP(ECS::HierarchySystem);
@@ -25,20 +30,50 @@ namespace softcube::system {
     public:
         HierarchySystem() = default;
 
-        void init(entt::registry &registry) override {
+        void init(Registry &registry) override {
             System::init(registry);
 
             m_registry->on_construct<component::Parent>().connect<&HierarchySystem::on_parent_construct>(this);
             m_registry->on_destroy<component::Parent>().connect<&HierarchySystem::on_parent_destroy>(this);
+            m_registry->on_destroy<component::Children>().connect<&HierarchySystem::on_children_destroy>(this);
+
+            // Entities entering or leaving the group through Transform reorder it as well.
+            m_registry->on_construct<component::Transform>().connect<&HierarchySystem::on_order_changed>(this);
+            m_registry->on_destroy<component::Transform>().connect<&HierarchySystem::on_order_changed>(this);
+
+            m_parented = m_registry->group<component::Parent>(entt::get<component::Transform>);
         }
 
+        [[nodiscard]] const char *get_name() const override { return "Hierarchy"; }
+
         void update(float dt) override {
-            for (const auto view = m_registry->view<component::Transform, component::Parent>(); const auto entity:
-                 view) {
-                auto &transform = view.get<component::Transform>(entity);
+            m_processed_count = 0;
 
-                if (const auto &parent = view.get<component::Parent>(entity);
-                    parent.entity != entt::null && m_registry->valid(parent.entity)) {
+            for (const auto transform_view = m_registry->view<component::Transform>(entt::exclude<component::Parent>);
+                 const auto entity: transform_view) {
+                if (auto &transform = transform_view.get<component::Transform>(entity);
+                    transform.parent == entt::null) {
+                    ++m_processed_count;
+                    transform.position = transform.local_position;
+                    transform.rotation = transform.local_rotation;
+                    transform.scale = transform.local_scale;
+                    transform.matrix_dirty = true;
+                }
+            }
+
+            // Shallow entities first, so a single linear pass over the group sees
+            // every parent's world transform already updated this frame.
+            if (m_order_dirty) {
+                m_parented.sort<component::Parent>([](const component::Parent &lhs, const component::Parent &rhs) {
+                    return lhs.depth < rhs.depth;
+                });
+                m_order_dirty = false;
+            }
+
+            for (auto [entity, parent, transform]: m_parented.each()) {
+                ++m_processed_count;
+
+                if (parent.entity != entt::null && m_registry->valid(parent.entity)) {
                     if (m_registry->all_of<component::Transform>(parent.entity)) {
                         auto &parent_transform = m_registry->get<component::Transform>(parent.entity);
 
@@ -69,17 +104,6 @@ namespace softcube::system {
                     transform.matrix_dirty = true;
                 }
             }
-
-            for (const auto transform_view = m_registry->view<component::Transform>(entt::exclude<component::Parent>);
-                 const auto entity: transform_view) {
-                if (auto &transform = transform_view.get<component::Transform>(entity);
-                    transform.parent == entt::null) {
-                    transform.position = transform.local_position;
-                    transform.rotation = transform.local_rotation;
-                    transform.scale = transform.local_scale;
-                    transform.matrix_dirty = true;
-                }
-            }
         }
 
         /**
@@ -95,20 +119,16 @@ namespace softcube::system {
                 return;
             }
 
-            if (m_registry->all_of<component::Parent>(child)) {
-                remove_from_parent(child);
-            }
-
-            m_registry->emplace_or_replace<component::Parent>(child, parent);
+            // Removing and emplacing runs the signals that unlink and relink the child.
+            m_registry->remove<component::Parent>(child);
+            m_registry->emplace<component::Parent>(child, parent);
 
             if (m_registry->all_of<component::Transform>(child)) {
                 auto &transform = m_registry->get<component::Transform>(child);
-                transform.parent = parent;
 
                 if (m_registry->all_of<component::Transform>(parent)) {
                     const auto &parent_transform = m_registry->get<component::Transform>(parent);
 
-                    const Vector3 relative_pos = transform.position - parent_transform.position;
                     const Quaternion inv_rotation = parent_transform.rotation.inverse();
 
                     transform.local_scale.x = transform.scale.x / parent_transform.scale.x;
@@ -118,13 +138,6 @@ namespace softcube::system {
                     transform.local_rotation = inv_rotation * transform.rotation;
                 }
             }
-
-            if (!m_registry->all_of<component::Children>(parent)) {
-                m_registry->emplace<component::Children>(parent);
-            }
-
-            auto &children = m_registry->get<component::Children>(parent);
-            children.add_child(child);
         }
 
         /**
@@ -133,7 +146,6 @@ namespace softcube::system {
          */
         void remove_parent(const entt::entity child) const {
             if (m_registry->all_of<component::Parent>(child)) {
-                remove_from_parent(child);
                 m_registry->remove<component::Parent>(child);
 
                 if (m_registry->all_of<component::Transform>(child)) {
@@ -141,75 +153,191 @@ namespace softcube::system {
                     transform.local_position = transform.position;
                     transform.local_rotation = transform.rotation;
                     transform.local_scale = transform.scale;
-                    transform.parent = entt::null;
                 }
             }
         }
 
         /**
-                 * @brief Check if entity is an ancestor of potential_child
-                 * @param entity Entity to check
-                 * @param potential_child Entity that might be a descendant
-                 * @return True if entity is an ancestor of potential_child
-                 */
-        bool is_ancestor(const entt::entity entity, const entt::entity potential_child) {
-            if (entity == potential_child) return true;
-            if (potential_child == entt::null) return false;
+         * @brief Check if entity is an ancestor of potential_child
+         * @param entity Entity to check
+         * @param potential_child Entity that might be a descendant
+         * @return True if entity is an ancestor of potential_child
+         */
+        bool is_ancestor(const entt::entity entity, entt::entity potential_child) const {
+            while (potential_child != entt::null) {
+                if (potential_child == entity) return true;
 
-            if (m_registry->all_of<component::Parent>(potential_child)) {
-                const auto &parent = m_registry->get<component::Parent>(potential_child);
-                return is_ancestor(entity, parent.entity);
+                const auto *parent = m_registry->try_get<component::Parent>(potential_child);
+                potential_child = parent ? parent->entity : entt::null;
             }
 
             return false;
         }
 
-    private:
         /**
-         * @brief Remove child from its current parent's children list
-         * @param child Child entity to remove
+         * @brief Visit the direct children of an entity in attach order
+         * @param parent Entity whose children are visited
+         * @param func Invoked as void(entt::entity child); must not change the hierarchy
          */
-        void remove_from_parent(const entt::entity child) const {
-            if (!m_registry->all_of<component::Parent>(child)) return;
+        template<typename Func>
+        void each_child(const entt::entity parent, Func &&func) const {
+            const auto *children = m_registry->try_get<component::Children>(parent);
+            if (!children) return;
 
-            const auto &parent_comp = m_registry->get<component::Parent>(child);
+            for (auto child = children->first; child != entt::null; child = m_registry->get<component::Parent>(child).next) {
+                func(child);
+            }
+        }
+
+        /**
+         * @brief Visit every descendant of an entity depth-first, parents before their children
+         *
+         * Follows the links directly, so the walk needs no stack or recursion.
+         *
+         * @param root Entity whose descendants are visited; not visited itself
+         * @param func Invoked as void(entt::entity descendant); must not change the hierarchy
+         */
+        template<typename Func>
+        void each_descendant(const entt::entity root, Func &&func) const {
+            const auto *children = m_registry->try_get<component::Children>(root);
+            if (!children) return;
 
-            if (const auto parent = parent_comp.entity; parent != entt::null && m_registry->valid(parent)) {
-                if (m_registry->all_of<component::Children>(parent)) {
-                    auto &children = m_registry->get<component::Children>(parent);
-                    children.remove_child(child);
+            entt::entity current = children->first;
 
-                    if (children.entities.empty()) {
-                        m_registry->remove<component::Children>(parent);
+            while (current != entt::null) {
+                func(current);
+
+                if (const auto *current_children = m_registry->try_get<component::Children>(current)) {
+                    current = current_children->first;
+                    continue;
+                }
+
+                // Climb until an ancestor below the root has a next sibling.
+                entt::entity next = entt::null;
+                while (current != root) {
+                    const auto &link = m_registry->get<component::Parent>(current);
+                    if (link.next != entt::null) {
+                        next = link.next;
+                        break;
                     }
+                    current = link.entity;
                 }
+                current = next;
             }
         }
 
-        void on_parent_construct(entt::registry &registry, const entt::entity entity) {
-            const auto &parent = registry.get<component::Parent>(entity);
+    private:
+        /**
+         * @brief Recompute the depth of every descendant of an entity
+         * @param root Entity whose subtree moved
+         * @param root_depth New depth of the root itself
+         */
+        void update_depths(const entt::entity root, const u32 root_depth) const {
+            each_descendant(root, [this, root, root_depth](const entt::entity descendant) {
+                auto &link = m_registry->get<component::Parent>(descendant);
+                link.depth = (link.entity == root ? root_depth : m_registry->get<component::Parent>(link.entity).depth)
+                             + 1;
+            });
+        }
+
+        void on_parent_construct(Registry &registry, const entt::entity entity) {
+            auto &link = registry.get<component::Parent>(entity);
+            link.next = entt::null;
+            link.previous = entt::null;
+            link.depth = 1;
+            m_order_dirty = true;
 
-            if (const auto parent_entity = parent.entity;
-                parent_entity != entt::null && registry.valid(parent_entity)) {
-                if (!registry.all_of<component::Children>(parent_entity)) {
-                    registry.emplace<component::Children>(parent_entity);
-                }
+            const auto parent_entity = link.entity;
+            if (parent_entity == entt::null || !registry.valid(parent_entity)) {
+                return;
+            }
+
+            auto &children = registry.get_or_emplace<component::Children>(parent_entity);
+            link.previous = children.last;
+            if (children.last != entt::null) {
+                registry.get<component::Parent>(children.last).next = entity;
+            } else {
+                children.first = entity;
+            }
+            children.last = entity;
+            ++children.count;
+
+            if (const auto *grand_parent = registry.try_get<component::Parent>(parent_entity)) {
+                link.depth = grand_parent->depth + 1;
+            }
+            update_depths(entity, link.depth);
+
+            if (registry.all_of<component::Transform>(entity)) {
+                registry.get<component::Transform>(entity).parent = parent_entity;
+            }
+        }
+
+        void on_parent_destroy(Registry &registry, const entt::entity entity) {
+            const auto &link = registry.get<component::Parent>(entity);
+            m_order_dirty = true;
 
+            if (const auto parent_entity = link.entity;
+                parent_entity != entt::null && registry.valid(parent_entity) &&
+                registry.all_of<component::Children>(parent_entity)) {
                 auto &children = registry.get<component::Children>(parent_entity);
-                children.add_child(entity);
 
-                if (registry.all_of<component::Transform>(entity)) {
-                    registry.get<component::Transform>(entity).parent = parent_entity;
+                if (link.previous != entt::null) {
+                    registry.get<component::Parent>(link.previous).next = link.next;
+                } else {
+                    children.first = link.next;
+                }
+
+                if (link.next != entt::null) {
+                    registry.get<component::Parent>(link.next).previous = link.previous;
+                } else {
+                    children.last = link.previous;
+                }
+
+                if (--children.count == 0) {
+                    registry.remove<component::Children>(parent_entity);
                 }
             }
-        }
 
-        void on_parent_destroy(entt::registry &registry, const entt::entity entity) const {
-            remove_from_parent(entity);
+            update_depths(entity, 0);
 
             if (registry.all_of<component::Transform>(entity)) {
                 registry.get<component::Transform>(entity).parent = entt::null;
             }
         }
+
+        void on_children_destroy(Registry &registry, const entt::entity entity) const {
+            // The parent is going away; orphan the remaining children in place.
+            for (auto child = registry.get<component::Children>(entity).first; child != entt::null;) {
+                auto *link = registry.try_get<component::Parent>(child);
+                if (!link) {
+                    break; // Parent pool already torn down by registry.clear()
+                }
+
+                const auto next = link->next;
+                link->entity = entt::null;
+                link->next = entt::null;
+                link->previous = entt::null;
+
+                if (registry.all_of<component::Transform>(child)) {
+                    registry.get<component::Transform>(child).parent = entt::null;
+                }
+
+                child = next;
+            }
+        }
+
+        void on_order_changed(Registry &registry, const entt::entity entity) {
+            if (registry.all_of<component::Parent>(entity)) {
+                m_order_dirty = true;
+            }
+        }
+
+        // Owns Parent so children sit packed in front of their Transform pool
+        // slice; Transform itself stays shareable with the render group.
+        using ParentedGroup = decltype(std::declval<Registry &>().group<component::Parent>(
+            entt::get<component::Transform>));
+
+        ParentedGroup m_parented;
+        bool m_order_dirty = true;
     };
 }
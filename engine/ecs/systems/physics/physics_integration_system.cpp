@@ -0,0 +1,164 @@
+#include "physics_integration_system.hpp"
+#include "integration_kernels.hpp"
+#include "ecs/components/basic/transform_component.hpp"
+#include "ecs/components/physics/physics_body_component.hpp"
+#include "ecs/components/physics/velocity_component.hpp"
+
+namespace softcube::system {
+    void PhysicsIntegrationSystem::Lanes::resize(const size_t count) {
+        for (auto *lane: {
+                 &px, &py, &pz, &qx, &qy, &qz, &qw, &vx, &vy, &vz, &wx, &wy, &wz,
+                 &prev_px, &prev_py, &prev_pz, &prev_qx, &prev_qy, &prev_qz, &prev_qw
+             }) {
+            lane->resize(count);
+        }
+    }
+
+    PhysicsIntegrationSystem::PhysicsIntegrationSystem(const float fixed_timestep, const u32 max_substeps)
+        : m_fixed_timestep(fixed_timestep), m_max_substeps(max_substeps) {
+    }
+
+    void PhysicsIntegrationSystem::init(Registry &registry) {
+        System::init(registry);
+
+        m_registry->on_destroy<component::Velocity>().connect<&PhysicsIntegrationSystem::on_velocity_destroy>(this);
+    }
+
+    void PhysicsIntegrationSystem::update(const float dt) {
+        attach_bodies();
+
+        // Drop time we cannot catch up on instead of spiralling into ever longer frames.
+        const float max_accumulated = m_fixed_timestep * static_cast<float>(m_max_substeps);
+        m_accumulator = std::min(m_accumulator + dt, max_accumulated);
+
+        u32 steps = 0;
+        while (m_accumulator >= m_fixed_timestep) {
+            m_accumulator -= m_fixed_timestep;
+            ++steps;
+        }
+
+        m_last_step_count = steps;
+        m_alpha = m_accumulator / m_fixed_timestep;
+
+        if (steps > 0) {
+            gather();
+            step(steps);
+            scatter();
+        }
+
+        interpolate();
+    }
+
+    void PhysicsIntegrationSystem::attach_bodies() {
+        for (const auto view = m_registry->view<component::Velocity, component::Transform>(
+                 entt::exclude<component::PhysicsBody>); const auto entity: view) {
+            m_pending.push_back(entity);
+        }
+
+        for (const auto entity: m_pending) {
+            const auto &transform = m_registry->get<component::Transform>(entity);
+            m_registry->emplace<component::PhysicsBody>(entity, transform.local_position, transform.local_rotation);
+        }
+
+        m_pending.clear();
+    }
+
+    void PhysicsIntegrationSystem::on_velocity_destroy(Registry &registry, const entt::entity entity) {
+        // Without a Velocity the body never steps again; left in place, interpolate() would pin the transform.
+        registry.remove<component::PhysicsBody>(entity);
+    }
+
+    void PhysicsIntegrationSystem::teleport(const entt::entity entity) const {
+        auto *body = m_registry->try_get<component::PhysicsBody>(entity);
+        const auto *transform = m_registry->try_get<component::Transform>(entity);
+        if (!body || !transform) {
+            return;
+        }
+
+        *body = component::PhysicsBody(transform->local_position, transform->local_rotation);
+    }
+
+    void PhysicsIntegrationSystem::gather() {
+        const auto view = m_registry->view<component::PhysicsBody, const component::Velocity>();
+        m_lanes.resize(view.size_hint());
+
+        size_t i = 0;
+        for (const auto entity: view) {
+            const auto &body = view.get<component::PhysicsBody>(entity);
+            const auto &velocity = view.get<const component::Velocity>(entity);
+
+            m_lanes.px[i] = body.position.x;
+            m_lanes.py[i] = body.position.y;
+            m_lanes.pz[i] = body.position.z;
+            m_lanes.qx[i] = body.rotation.x;
+            m_lanes.qy[i] = body.rotation.y;
+            m_lanes.qz[i] = body.rotation.z;
+            m_lanes.qw[i] = body.rotation.w;
+            m_lanes.vx[i] = velocity.linear.x;
+            m_lanes.vy[i] = velocity.linear.y;
+            m_lanes.vz[i] = velocity.linear.z;
+            m_lanes.wx[i] = velocity.angular.x;
+            m_lanes.wy[i] = velocity.angular.y;
+            m_lanes.wz[i] = velocity.angular.z;
+            ++i;
+        }
+
+        // size_hint() is an upper bound for multi-component views
+        m_lanes.resize(i);
+    }
+
+    void PhysicsIntegrationSystem::step(const u32 steps) {
+        auto &l = m_lanes;
+        const size_t count = l.px.size();
+
+        for (u32 s = 0; s < steps; ++s) {
+            if (s + 1 == steps) {
+                std::ranges::copy(l.px, l.prev_px.begin());
+                std::ranges::copy(l.py, l.prev_py.begin());
+                std::ranges::copy(l.pz, l.prev_pz.begin());
+                std::ranges::copy(l.qx, l.prev_qx.begin());
+                std::ranges::copy(l.qy, l.prev_qy.begin());
+                std::ranges::copy(l.qz, l.prev_qz.begin());
+                std::ranges::copy(l.qw, l.prev_qw.begin());
+            }
+
+            physics::integrate_positions(l.px.data(), l.py.data(), l.pz.data(),
+                                         l.vx.data(), l.vy.data(), l.vz.data(), count, m_fixed_timestep);
+            physics::integrate_rotations(l.qx.data(), l.qy.data(), l.qz.data(), l.qw.data(),
+                                         l.wx.data(), l.wy.data(), l.wz.data(), count, m_fixed_timestep);
+        }
+
+        SC_TRACE("Integrated {} bodies over {} steps", count, steps);
+    }
+
+    void PhysicsIntegrationSystem::scatter() {
+        const auto view = m_registry->view<component::PhysicsBody, const component::Velocity>();
+        const auto &l = m_lanes;
+
+        size_t i = 0;
+        for (const auto entity: view) {
+            auto &body = view.get<component::PhysicsBody>(entity);
+
+            body.position = Vector3(l.px[i], l.py[i], l.pz[i]);
+            body.rotation = Quaternion(l.qx[i], l.qy[i], l.qz[i], l.qw[i]);
+            body.previous_position = Vector3(l.prev_px[i], l.prev_py[i], l.prev_pz[i]);
+            body.previous_rotation = Quaternion(l.prev_qx[i], l.prev_qy[i], l.prev_qz[i], l.prev_qw[i]);
+            ++i;
+        }
+    }
+
+    void PhysicsIntegrationSystem::interpolate() {
+        m_processed_count = 0;
+
+        for (const auto view = m_registry->view<const component::PhysicsBody, component::Transform>();
+             const auto entity: view) {
+            const auto &body = view.get<const component::PhysicsBody>(entity);
+            auto &transform = view.get<component::Transform>(entity);
+
+            transform.local_position = math::lerp(body.previous_position, body.position, m_alpha);
+            transform.local_rotation = math::fast::slerp(body.previous_rotation, body.rotation, m_alpha);
+            transform.matrix_dirty = true;
+            ++m_processed_count;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "ecs/systems/system_base.hpp"
+
+namespace softcube::system {
+    /**
+     * @class PhysicsIntegrationSystem
+     * @brief System that advances entities with a Velocity at a fixed timestep
+     *
+     * Frame time is accumulated and consumed in fixed steps, capped at
+     * max_substeps per frame. Before stepping, the simulated poses and velocities
+     * are gathered into packed SoA arrays so every sub-step runs as a SIMD kernel
+     * over contiguous floats; results are scattered back once per frame. The
+     * local transform is then set to the pose interpolated between the last two
+     * steps by the leftover accumulator fraction.
+     *
+     * The PhysicsBody is removed together with the Velocity, which hands the
+     * transform back to whoever writes it next.
+     */
+    class PhysicsIntegrationSystem final : public System {
+        SC_LOG_GROUP(ECS::PHYSICS_INTEGRATION_SYSTEM);
+
+    public:
+        /**
+         * @brief Construct the system
+         * @param fixed_timestep Simulation step in seconds
+         * @param max_substeps Maximum number of steps taken in one update
+         */
+        explicit PhysicsIntegrationSystem(float fixed_timestep = 1.0f / 60.0f, u32 max_substeps = 8);
+
+        void init(Registry &registry) override;
+
+        /**
+         * @brief Step the simulation and interpolate render transforms
+         * @param dt Delta time in seconds
+         */
+        void update(float dt) override;
+
+        [[nodiscard]] const char *get_name() const override { return "Physics Integration"; }
+
+        void set_fixed_timestep(const float fixed_timestep) { m_fixed_timestep = fixed_timestep; }
+        [[nodiscard]] float get_fixed_timestep() const { return m_fixed_timestep; }
+
+        void set_max_substeps(const u32 max_substeps) { m_max_substeps = max_substeps; }
+        [[nodiscard]] u32 get_max_substeps() const { return m_max_substeps; }
+
+        /**
+         * @brief Get the interpolation factor used for the last update
+         * @return Fraction of a step between the previous and current pose, in [0, 1)
+         */
+        [[nodiscard]] float get_interpolation_alpha() const { return m_alpha; }
+
+        /**
+         * @brief Get the number of steps taken by the last update
+         * @return Step count
+         */
+        [[nodiscard]] u32 get_last_step_count() const { return m_last_step_count; }
+
+        /**
+         * @brief Move a simulated entity to its current local transform
+         *
+         * Overwrites the body's current and previous pose, so the next update
+         * neither interpolates from the old place nor overwrites the new one.
+         * Call after writing the Transform of an entity with a PhysicsBody.
+         *
+         * @param entity Entity whose body is re-synced; ignored if it has no PhysicsBody
+         */
+        void teleport(entt::entity entity) const;
+
+    private:
+        /**
+         * @struct Lanes
+         * @brief Packed SoA copies of the simulated state
+         */
+        struct Lanes {
+            std::vector<float> px, py, pz;
+            std::vector<float> qx, qy, qz, qw;
+            std::vector<float> vx, vy, vz;
+            std::vector<float> wx, wy, wz;
+
+            // Pose at the start of the last step, for interpolation
+            std::vector<float> prev_px, prev_py, prev_pz;
+            std::vector<float> prev_qx, prev_qy, prev_qz, prev_qw;
+
+            void resize(size_t count);
+        };
+
+        void attach_bodies();
+
+        void on_velocity_destroy(Registry &registry, entt::entity entity);
+
+        void gather();
+
+        void step(u32 steps);
+
+        void scatter();
+
+        void interpolate();
+
+        float m_fixed_timestep;
+        u32 m_max_substeps;
+        float m_accumulator = 0.0f;
+        float m_alpha = 0.0f;
+        u32 m_last_step_count = 0;
+
+        Lanes m_lanes;
+        std::vector<entt::entity> m_pending;
+    };
+}
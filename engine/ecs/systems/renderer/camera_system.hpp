@@ -6,6 +6,7 @@
 #include "ecs/components/renderer/camera_component.hpp"
 #include "ecs/components/renderer/camera_controller_component.hpp"
 #include "ecs/components/basic/transform_component.hpp"
+#include "ecs/components/basic/world_anchor_component.hpp"
 #include "ecs/systems/system_base.hpp"
 #include "input/input_manager.hpp"
 
@@ -19,7 +20,7 @@ namespace softcube::system {
             m_window = window;
         }
 
-        void init(entt::registry &registry) override {
+        void init(Registry &registry) override {
             System::init(registry);
             m_registry->on_construct<component::Camera>().connect<&CameraSystem::on_camera_construct>(this);
             m_registry->on_destroy<component::Camera>().connect<&CameraSystem::on_camera_destroy>(this);
@@ -53,14 +54,38 @@ namespace softcube::system {
                 existing_camera.is_main = false;
             }
 
+            const auto entity = create_camera(position, target);
+            m_registry->get<component::Camera>(entity).is_main = true;
+
+            if (use_controller) {
+                add_controller(entity);
+            }
+
+            SC_INFO("Created main camera entity");
+            return entity;
+        }
+
+        /**
+         * @brief Creates a camera rendering into its own view
+         *
+         * Used for split-screen, minimaps and render-to-texture. The camera only
+         * draws once it is added to the mesh renderer with add_camera().
+         *
+         * @param position Initial camera position
+         * @param target Point the camera should look at
+         * @param view_id bgfx view the camera renders into
+         * @param viewport Normalized x, y, width, height within the render target
+         * @return Entity ID of the created camera
+         */
+        entt::entity create_camera(const Vector3 &position, const Vector3 &target, const u16 view_id = 0,
+                                   const Vector4 &viewport = Vector4(0.0f, 0.0f, 1.0f, 1.0f)) {
             const auto entity = m_registry->create();
 
-            const auto &transform = m_registry->emplace<component::Transform>(entity, position);
+            auto &transform = m_registry->emplace<component::Transform>(entity, position);
 
             Vector3 direction = target - position;
             direction.normalize();
 
-            Vector3 forward(0.0f, 0.0f, 1.0f);
             const Vector3 up(0.0f, 1.0f, 0.0f);
 
             if (direction.is_zero()) {
@@ -81,34 +106,32 @@ namespace softcube::system {
             }
 
             auto &camera = m_registry->emplace<component::Camera>(entity);
-            camera.is_main = true;
-
-            camera.calculate_view_matrix(transform.position, transform.rotation);
-            camera.calculate_projection_matrix(static_cast<float>(m_window->get_width()),
-                                               static_cast<float>(m_window->get_height()));
-
-            if (use_controller) {
-                add_controller(entity);
-            }
+            camera.view_id = view_id;
+            camera.viewport = viewport;
 
-            SC_INFO("Created main camera entity");
+            refresh_matrices(camera, transform);
             return entity;
         }
 
+        [[nodiscard]] const char *get_name() const override { return "Camera"; }
+
         void update(float dt) override {
+            m_processed_count = 0;
+
             const auto controller_view = m_registry->view<component::Camera, component::Transform,
                 component::CameraController>();
             for (const auto entity: controller_view) {
                 auto &camera = controller_view.get<component::Camera>(entity);
                 auto &transform = controller_view.get<component::Transform>(entity);
+                ++m_processed_count;
 
-                if (auto &controller = controller_view.get<component::CameraController>(entity); controller.is_active) {
+                auto &controller = controller_view.get<component::CameraController>(entity);
+                if (controller.is_active) {
                     update_camera_controller(dt, entity, camera, transform, controller);
                 }
 
-                camera.calculate_view_matrix(transform.position, transform.rotation);
-                camera.calculate_projection_matrix(static_cast<float>(m_window->get_width()),
-                                                   static_cast<float>(m_window->get_height()));
+                rebase(entity, transform, &controller);
+                refresh_matrices(camera, transform);
             }
 
             const auto camera_view = m_registry->view<component::Camera, component::Transform>(
@@ -116,20 +139,20 @@ namespace softcube::system {
             for (const auto entity: camera_view) {
                 auto &camera = camera_view.get<component::Camera>(entity);
                 auto &transform = camera_view.get<component::Transform>(entity);
+                ++m_processed_count;
 
-                camera.calculate_view_matrix(transform.position, transform.rotation);
-                camera.calculate_projection_matrix(static_cast<float>(m_window->get_width()),
-                                                   static_cast<float>(m_window->get_height()));
+                rebase(entity, transform, nullptr);
+                refresh_matrices(camera, transform);
             }
         }
 
-        void on_camera_construct(entt::registry &registry, const entt::entity entity) {
+        void on_camera_construct(Registry &registry, const entt::entity entity) {
             if (const auto &camera = registry.get<component::Camera>(entity); camera.is_main) {
                 SC_INFO("Camera is set as main camera");
             }
         }
 
-        void on_camera_destroy(entt::registry &registry, const entt::entity entity) {
+        void on_camera_destroy(Registry &registry, const entt::entity entity) {
             if (const auto &camera = registry.get<component::Camera>(entity); camera.is_main) {
                 SC_INFO("Camera is destroyed");
             }
@@ -206,6 +229,45 @@ namespace softcube::system {
         InputManager *m_input_manager;
         Window *m_window;
 
+        /**
+         * @brief Keep an anchored camera's position within its anchor chunk
+         *
+         * The view matrix is built from the position relative to the anchor, so
+         * it stays precise however far the camera travels. Only the camera moves;
+         * other entities are placed relative to it when they are drawn.
+         *
+         * @param entity The camera entity
+         * @param transform The transform component
+         * @param controller The camera controller, whose orbit target moves with the anchor; may be null
+         */
+        void rebase(const entt::entity entity, component::Transform &transform,
+                    component::CameraController *controller) const {
+            auto *anchor = m_registry->try_get<component::WorldAnchor>(entity);
+            if (!anchor) {
+                return;
+            }
+
+            if (const IVector3 moved = anchor->rebase(transform); moved != IVector3::zero() && controller) {
+                controller->orbit_target -= (moved * voxel::chunk_size).to_vector3();
+            }
+        }
+
+        /**
+         * @brief Rebuild a camera's cached matrices if its transform, projection or output size changed
+         * @param camera The camera component
+         * @param transform The transform component
+         */
+        void refresh_matrices(component::Camera &camera, const component::Transform &transform) const {
+            const float width = camera.target_width > 0
+                                    ? static_cast<float>(camera.target_width)
+                                    : static_cast<float>(m_window->get_width());
+            const float height = camera.target_height > 0
+                                     ? static_cast<float>(camera.target_height)
+                                     : static_cast<float>(m_window->get_height());
+
+            camera.update_matrices(transform.position, transform.rotation, width, height);
+        }
+
         /**
          * @brief Updates camera position and rotation based on input
          * @param dt Delta time in seconds
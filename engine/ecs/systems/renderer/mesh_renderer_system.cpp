@@ -1,14 +1,22 @@
 #include "mesh_renderer_system.hpp"
 
 #include "ecs/components/basic/name_component.hpp"
+#include "ecs/components/basic/world_anchor_component.hpp"
 #include "ecs/components/renderer/camera_component.hpp"
+#include "core/memory/allocation_tracker.hpp"
 
 namespace softcube::system {
     MeshRendererSystem::MeshRendererSystem(Renderer *renderer)
         : m_renderer(renderer) {
     }
 
-    void MeshRendererSystem::init(entt::registry &registry) {
+    MeshRendererSystem::~MeshRendererSystem() {
+        if (isValid(m_color_uniform)) {
+            destroy(m_color_uniform);
+        }
+    }
+
+    void MeshRendererSystem::init(Registry &registry) {
         System::init(registry);
 
         m_registry->on_construct<component::MeshRenderer>()
@@ -17,46 +25,37 @@ namespace softcube::system {
         m_registry->on_destroy<component::MeshRenderer>()
                 .connect<&MeshRendererSystem::on_mesh_renderer_destroy>(this);
 
+        // Created after the listeners above so Bounds is already attached when
+        // the group checks a new mesh for membership.
+        m_render_group = m_registry->group<component::MeshRenderer, component::Transform, component::Bounds>();
+
+        m_color_uniform = createUniform("u_color", bgfx::UniformType::Vec4);
+
         SC_INFO("MeshRendererSystem initialized");
     }
 
     void MeshRendererSystem::update(float dt) {
-        if (m_active_camera == entt::null) {
-            return;
-        }
+        m_processed_count = 0;
 
-        if (!m_registry->valid(m_active_camera) ||
-            !m_registry->all_of<component::Camera, component::Transform>(m_active_camera)) {
+        if (m_active_camera.camera != entt::null && !render_camera(m_active_camera)) {
             SC_WARN("Active camera entity is invalid or missing required components");
-            m_active_camera = entt::null;
-            return;
+            m_active_camera = {};
         }
 
-        const auto &camera = m_registry->get<component::Camera>(m_active_camera);
-        const auto &camera_transform = m_registry->get<component::Transform>(m_active_camera);
-
-        camera.calculate_view_matrix(camera_transform.position, camera_transform.rotation);
-
-        bgfx::setViewTransform(
-            0,
-            camera.view_matrix.values,
-            camera.projection_matrix.values
-        );
-
-        for (auto view = m_registry->view<component::MeshRenderer, component::Transform>(); const auto entity: view) {
-            const auto &mesh_renderer = view.get<component::MeshRenderer>(entity);
-            const auto &transform = view.get<component::Transform>(entity);
-
-            if (!mesh_renderer.visible) {
-                continue;
+        for (auto &view: m_cameras) {
+            if (!render_camera(view)) {
+                SC_WARN("Camera entity {} is invalid or missing required components",
+                        static_cast<uint32_t>(view.camera));
+                view.camera = entt::null;
             }
-
-            submit_mesh(entity, transform, mesh_renderer);
         }
+
+        std::erase_if(m_cameras, [](const CameraView &view) { return view.camera == entt::null; });
     }
 
     void MeshRendererSystem::set_active_camera(entt::entity camera_entity) {
-        m_active_camera = camera_entity;
+        m_active_camera = {};
+        m_active_camera.camera = camera_entity;
 
         if (camera_entity != entt::null) {
             SC_INFO("Set active camera: {}",
@@ -67,53 +66,127 @@ namespace softcube::system {
         }
     }
 
-    void MeshRendererSystem::on_mesh_renderer_construct(entt::registry &registry, entt::entity entity) {
+    void MeshRendererSystem::add_camera(const entt::entity camera_entity, const bgfx::FrameBufferHandle frame_buffer) {
+        if (!m_registry->all_of<component::Camera, component::Transform>(camera_entity)) {
+            SC_ERROR("Cannot render entity {} - it needs Camera and Transform components",
+                     static_cast<uint32_t>(camera_entity));
+            return;
+        }
+
+        remove_camera(camera_entity);
+
+        const auto &camera = m_registry->get<component::Camera>(camera_entity);
+        bgfx::setViewFrameBuffer(camera.view_id, frame_buffer);
+        bgfx::setViewClear(camera.view_id, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, 0x303030ff, 1.0f, 0);
+
+        CameraView view;
+        view.camera = camera_entity;
+        view.frame_buffer = frame_buffer;
+        m_cameras.push_back(view);
+
+        SC_INFO("Added camera {} on view {}", static_cast<uint32_t>(camera_entity), camera.view_id);
+    }
+
+    void MeshRendererSystem::remove_camera(const entt::entity camera_entity) {
+        std::erase_if(m_cameras, [camera_entity](const CameraView &view) { return view.camera == camera_entity; });
+    }
+
+    void MeshRendererSystem::clear_cameras() {
+        m_cameras.clear();
+    }
+
+    bool MeshRendererSystem::render_camera(CameraView &view) {
+        if (!m_registry->valid(view.camera) ||
+            !m_registry->all_of<component::Camera, component::Transform>(view.camera)) {
+            return false;
+        }
+
+        const auto &camera = m_registry->get<component::Camera>(view.camera);
+
+        // bgfx keeps view transforms between frames, so upload only when the
+        // camera system actually rebuilt the matrices.
+        if (camera.matrix_version != view.uploaded_version) {
+            bgfx::setViewTransform(camera.view_id, camera.view_matrix.values, camera.projection_matrix.values);
+            view.uploaded_version = camera.matrix_version;
+        }
+
+        const float target_width = camera.target_width > 0
+                                       ? static_cast<float>(camera.target_width)
+                                       : m_renderer->get_width();
+        const float target_height = camera.target_height > 0
+                                        ? static_cast<float>(camera.target_height)
+                                        : m_renderer->get_height();
+
+        bgfx::setViewRect(camera.view_id,
+                          static_cast<uint16_t>(camera.viewport.x * target_width),
+                          static_cast<uint16_t>(camera.viewport.y * target_height),
+                          static_cast<uint16_t>(camera.viewport.z * target_width),
+                          static_cast<uint16_t>(camera.viewport.w * target_height));
+        bgfx::touch(camera.view_id);
+
+        // The view matrix is relative to the camera's anchor chunk, so each mesh is
+        // shifted by the chunks between its anchor and the camera's. The difference
+        // is taken in integers, which keeps meshes near the camera precise however
+        // far both are from the world origin.
+        const auto &anchors = m_registry->storage<component::WorldAnchor>();
+        const IVector3 camera_chunk = anchors.contains(view.camera)
+                                          ? anchors.get(view.camera).chunk
+                                          : IVector3::zero();
+
+        SC_NO_ALLOCATION_SCOPE("MeshRendererSystem draw loop");
+        for (const auto [entity, mesh_renderer, transform, bounds]: m_render_group.each()) {
+            if (!mesh_renderer.visible) {
+                continue;
+            }
+
+            const IVector3 chunk = anchors.contains(entity) ? anchors.get(entity).chunk : IVector3::zero();
+            submit_mesh(camera.view_id, transform, mesh_renderer,
+                        ((chunk - camera_chunk) * voxel::chunk_size).to_vector3());
+            ++m_processed_count;
+        }
+
+        return true;
+    }
+
+    void MeshRendererSystem::on_mesh_renderer_construct(Registry &registry, entt::entity entity) {
+        if (!registry.all_of<component::Bounds>(entity)) {
+            registry.emplace<component::Bounds>(entity);
+        }
+
         SC_DEBUG("MeshRenderer component added to entity {}", static_cast<uint32_t>(entity));
     }
 
-    void MeshRendererSystem::on_mesh_renderer_destroy(entt::registry &registry, entt::entity entity) {
+    void MeshRendererSystem::on_mesh_renderer_destroy(Registry &registry, entt::entity entity) {
         SC_DEBUG("MeshRenderer component removed from entity {}", static_cast<uint32_t>(entity));
     }
 
-    void MeshRendererSystem::submit_mesh(entt::entity entity,
+    void MeshRendererSystem::submit_mesh(const u16 view_id,
                                          const component::Transform &transform,
-                                         const component::MeshRenderer &mesh_renderer) {
+                                         const component::MeshRenderer &mesh_renderer,
+                                         const Vector3 &camera_offset) {
         if (mesh_renderer.vertex_buffers.empty() || !isValid(mesh_renderer.index_buffer)) {
             return;
         }
 
-        float model[16];
-
-        if (transform.matrix_dirty) {
-            Matrix4 model_matrix = transform.world_matrix;
-            std::memcpy(model, model_matrix.values, sizeof(float) * 16);
-        } else {
-            Matrix4 model_matrix;
-
-            Matrix4 translation_matrix = Matrix4::translation(transform.position);
-            Matrix4 rotation_matrix(transform.rotation.to_rotation_matrix());
-            Matrix4 scale_matrix = Matrix4::scale(transform.scale);
-            model_matrix = translation_matrix * rotation_matrix * scale_matrix;
-            std::memcpy(model, model_matrix.values, sizeof(float) * 16);
-        }
-
-        bgfx::setTransform(model);
+        Matrix4 model = transform.update_world_matrix();
+        model.m03 += camera_offset.x;
+        model.m13 += camera_offset.y;
+        model.m23 += camera_offset.z;
+        bgfx::setTransform(model.values);
 
         for (const auto &vb: mesh_renderer.vertex_buffers) {
             setVertexBuffer(0, vb);
         }
         setIndexBuffer(mesh_renderer.index_buffer);
 
-
-        bgfx::UniformHandle u_color = createUniform("u_color", bgfx::UniformType::Vec4);
-        if (isValid(u_color)) {
+        if (isValid(m_color_uniform)) {
             float color[4] = {
                 mesh_renderer.color.x,
                 mesh_renderer.color.y,
                 mesh_renderer.color.z,
                 mesh_renderer.color.w
             };
-            setUniform(u_color, color);
+            setUniform(m_color_uniform, color);
         }
 
         uint64_t state = 0
@@ -126,12 +199,7 @@ namespace softcube::system {
 
         bgfx::setState(state);
         if (isValid(mesh_renderer.shader_program)) {
-            submit(0, mesh_renderer.shader_program);
-        }
-
-        // Clean up
-        if (isValid(u_color)) {
-            destroy(u_color);
+            submit(view_id, mesh_renderer.shader_program);
         }
     }
 }
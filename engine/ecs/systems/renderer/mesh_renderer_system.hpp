@@ -4,6 +4,7 @@
 #include "core/logging.hpp"
 #include "ecs/components/renderer/mesh_renderer_component.hpp"
 #include "ecs/components/basic/transform_component.hpp"
+#include "ecs/components/spatial/bounds_component.hpp"
 #include "ecs/systems/system_base.hpp"
 #include "graphics/renderer/renderer.hpp"
 
@@ -15,6 +16,15 @@ namespace softcube::system {
      * This system handles rendering of entities with MeshRenderer components.
      * It processes all entities with MeshRenderer and Transform components and
      * submits them to the renderer for drawing.
+     *
+     * Renderables are iterated through a group that owns MeshRenderer, Transform
+     * and Bounds, so the draw loop walks three tightly packed arrays; the only
+     * per-entity lookup is the optional WorldAnchor. Every mesh is given Bounds
+     * on construction so that it joins the group and the spatial index.
+     *
+     * Model matrices are made relative to the camera's anchor chunk (see
+     * WorldAnchor), so meshes near the camera stay precise tens of thousands
+     * of blocks from the world origin.
      */
     class MeshRendererSystem final : public System {
         SC_LOG_GROUP(ECS::MESH_RENDERER_SYSTEM);
@@ -22,11 +32,16 @@ namespace softcube::system {
     public:
         explicit MeshRendererSystem(Renderer *renderer);
 
+        /**
+         * @brief Destroy the color uniform; must run before the renderer shuts bgfx down
+         */
+        ~MeshRendererSystem() override;
+
         /**
          * @brief Initialize the system
          * @param registry Reference to the EnTT registry
          */
-        void init(entt::registry &registry) override;
+        void init(Registry &registry) override;
 
         /**
          * @brief Update the system
@@ -34,22 +49,80 @@ namespace softcube::system {
          */
         void update(float dt) override;
 
+        [[nodiscard]] const char *get_name() const override { return "Mesh Renderer"; }
+
         /**
          * @brief Set the active camera for rendering
          * @param camera_entity Entity ID of the camera to use
          */
         void set_active_camera(entt::entity camera_entity);
 
+        /**
+         * @brief Render an additional camera every frame
+         *
+         * The camera draws into its own Camera::view_id and viewport, which allows
+         * split-screen and minimaps. Passing a frame buffer renders to a texture
+         * instead of the back buffer; set Camera::target_width and target_height
+         * to its size so the projection uses the right aspect ratio.
+         *
+         * @param camera_entity Entity with Camera and Transform components
+         * @param frame_buffer Render target, or BGFX_INVALID_HANDLE for the back buffer
+         */
+        void add_camera(entt::entity camera_entity,
+                        bgfx::FrameBufferHandle frame_buffer = BGFX_INVALID_HANDLE);
+
+        /**
+         * @brief Stop rendering an additional camera
+         * @param camera_entity Entity passed to add_camera
+         */
+        void remove_camera(entt::entity camera_entity);
+
+        /**
+         * @brief Stop rendering every additional camera; the active camera is kept
+         */
+        void clear_cameras();
+
     private:
+        /**
+         * @struct CameraView
+         * @brief A camera rendered each frame and the state last handed to bgfx for it
+         */
+        struct CameraView {
+            entt::entity camera = entt::null;
+            bgfx::FrameBufferHandle frame_buffer = BGFX_INVALID_HANDLE;
+            u32 uploaded_version = std::numeric_limits<u32>::max(); // Camera::matrix_version last uploaded
+        };
+
+        using RenderGroup = decltype(std::declval<Registry &>().group<
+            component::MeshRenderer, component::Transform, component::Bounds>());
+
         Renderer *m_renderer = nullptr;
-        entt::entity m_active_camera = entt::null;
+        CameraView m_active_camera;
+        std::vector<CameraView> m_cameras; // Additional cameras, rendered after the active one
+        RenderGroup m_render_group;
+        bgfx::UniformHandle m_color_uniform = BGFX_INVALID_HANDLE; // u_color, created once in init
 
-        void on_mesh_renderer_construct(entt::registry &registry, entt::entity entity);
+        void on_mesh_renderer_construct(Registry &registry, entt::entity entity);
 
-        void on_mesh_renderer_destroy(entt::registry &registry, entt::entity entity);
+        void on_mesh_renderer_destroy(Registry &registry, entt::entity entity);
 
-        void submit_mesh(entt::entity entity,
+        /**
+         * @brief Set up a camera's view and submit every visible mesh to it
+         * @param view Camera to render
+         * @return False if the camera entity is no longer usable
+         */
+        bool render_camera(CameraView &view);
+
+        /**
+         * @brief Draw one mesh
+         * @param view_id bgfx view to submit to
+         * @param transform The mesh's transform, relative to its anchor
+         * @param mesh_renderer The mesh
+         * @param camera_offset Position of the mesh's anchor relative to the camera's, in blocks
+         */
+        void submit_mesh(u16 view_id,
                          const component::Transform &transform,
-                         const component::MeshRenderer &mesh_renderer);
+                         const component::MeshRenderer &mesh_renderer,
+                         const Vector3 &camera_offset);
     };
 }
@@ -0,0 +1,147 @@
+#include "spatial_index_system.hpp"
+
+namespace softcube::system {
+    void SpatialIndexSystem::init(Registry &registry) {
+        System::init(registry);
+
+        m_registry->on_construct<component::Bounds>().connect<&SpatialIndexSystem::on_bounds_construct>(this);
+        m_registry->on_destroy<component::Bounds>().connect<&SpatialIndexSystem::on_bounds_destroy>(this);
+    }
+
+    void SpatialIndexSystem::update(float dt) {
+        size_t moved = 0;
+        m_processed_count = 0;
+
+        // Gather every box and its world matrix, then transform them in one batch.
+        const auto view = m_registry->view<component::Bounds, const component::Transform>();
+        m_matrices.clear();
+        m_local_min.resize(view.size_hint());
+        m_local_max.resize(view.size_hint());
+
+        size_t index = 0;
+        for (const auto [entity, bounds, transform]: view.each()) {
+            m_matrices.push_back(transform.update_world_matrix());
+            m_local_min.set(index, bounds.local.min);
+            m_local_max.set(index, bounds.local.max);
+            ++index;
+        }
+
+        m_local_min.resize(index);
+        m_local_max.resize(index);
+        m_world_min.resize(index);
+        m_world_max.resize(index);
+
+        math::transform_aabbs(m_matrices, m_local_min, m_local_max, m_world_min, m_world_max);
+
+        index = 0;
+        for (const auto entity: view) {
+            auto &bounds = view.get<component::Bounds>(entity);
+            const AABB world(m_world_min.get(index), m_world_max.get(index));
+            ++index;
+            ++m_processed_count;
+
+            if (world.min == bounds.world.min && world.max == bounds.world.max) {
+                continue;
+            }
+
+            const Vector3 displacement = world.center() - bounds.world.center();
+            bounds.world = world;
+
+            if (m_tree.move_proxy(bounds.proxy, world, displacement)) {
+                ++moved;
+            }
+        }
+
+        if (moved > 0) {
+            SC_TRACE("Reinserted {} proxies, tree height {}", moved, m_tree.get_height());
+        }
+    }
+
+    void SpatialIndexSystem::query(const AABB &aabb, std::vector<entt::entity> &out) const {
+        const auto &bounds = m_registry->storage<component::Bounds>();
+
+        m_tree.query(aabb, [&](const u32 user_data) {
+            const auto entity = from_user_data(user_data);
+            if (bounds.get(entity).world.intersects(aabb)) {
+                out.push_back(entity);
+            }
+            return true;
+        });
+    }
+
+    void SpatialIndexSystem::query(const Frustum &frustum, std::vector<entt::entity> &out) const {
+        const auto &bounds = m_registry->storage<component::Bounds>();
+
+        m_tree.query(frustum, [&](const u32 user_data) {
+            const auto entity = from_user_data(user_data);
+            if (frustum.intersects(bounds.get(entity).world)) {
+                out.push_back(entity);
+            }
+            return true;
+        });
+    }
+
+    void SpatialIndexSystem::query_sphere(const Vector3 &center, const float radius,
+                                          std::vector<entt::entity> &out) const {
+        const auto &bounds = m_registry->storage<component::Bounds>();
+        const float radius_squared = radius * radius;
+
+        m_tree.query_sphere(center, radius, [&](const u32 user_data) {
+            const auto entity = from_user_data(user_data);
+            const auto &world = bounds.get(entity).world;
+            if (clamp(center, world.min, world.max).distance_squared(center) <= radius_squared) {
+                out.push_back(entity);
+            }
+            return true;
+        });
+    }
+
+    std::optional<RayHit> SpatialIndexSystem::raycast(const Vector3 &origin, const Vector3 &direction,
+                                                      const float max_distance) const {
+        const auto &bounds = m_registry->storage<component::Bounds>();
+        std::optional<RayHit> result;
+
+        m_tree.raycast(origin, direction, max_distance, [&](const u32 user_data, const float current_max) {
+            const auto entity = from_user_data(user_data);
+
+            float t_min = 0.0f;
+            float t_max = 0.0f;
+            if (!bounds.get(entity).world.intersect_ray(origin, direction, t_min, t_max) || t_max < 0.0f) {
+                return current_max;
+            }
+
+            const float distance = std::max(t_min, 0.0f);
+            if (distance > current_max) {
+                return current_max;
+            }
+
+            result = RayHit{entity, distance};
+            return distance;
+        });
+
+        return result;
+    }
+
+    void SpatialIndexSystem::on_bounds_construct(Registry &registry, const entt::entity entity) {
+        auto &bounds = registry.get<component::Bounds>(entity);
+
+        bounds.world = compute_world_bounds(bounds.local, registry.try_get<component::Transform>(entity));
+        bounds.proxy = m_tree.create_proxy(bounds.world, to_user_data(entity));
+    }
+
+    void SpatialIndexSystem::on_bounds_destroy(Registry &registry, const entt::entity entity) {
+        if (auto &bounds = registry.get<component::Bounds>(entity); bounds.proxy != DynamicAabbTree::null_node) {
+            m_tree.destroy_proxy(bounds.proxy);
+            bounds.proxy = DynamicAabbTree::null_node;
+        }
+    }
+
+    AABB SpatialIndexSystem::compute_world_bounds(const AABB &local, const component::Transform *transform) {
+        if (!transform) {
+            return local;
+        }
+
+        // Same arithmetic as the batched update, so a new proxy is not moved on its first update.
+        return local.transform(transform->update_world_matrix());
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "core/common.hpp"
+#include "core/logging.hpp"
+#include "core/math/stream.hpp"
+#include "core/spatial/dynamic_aabb_tree.hpp"
+#include "ecs/components/basic/transform_component.hpp"
+#include "ecs/components/spatial/bounds_component.hpp"
+#include "ecs/systems/system_base.hpp"
+
+namespace softcube::system {
+    /**
+     * @struct RayHit
+     * @brief Closest entity hit by a ray cast through the spatial index
+     */
+    struct RayHit {
+        entt::entity entity = entt::null;
+        float distance = 0.0f;
+    };
+
+    /**
+     * @class SpatialIndexSystem
+     * @brief System that keeps every entity with Bounds in a dynamic AABB tree
+     *
+     * Proxies are created and destroyed through registry signals and refreshed
+     * incrementally each update from the entity's Transform, so the index is
+     * never rebuilt. World bounds are computed for all entities at once with
+     * math::transform_aabbs. Queries return entities whose world bounds pass the test.
+     */
+    class SpatialIndexSystem final : public System {
+        SC_LOG_GROUP(ECS::SPATIAL_INDEX_SYSTEM);
+
+    public:
+        SpatialIndexSystem() = default;
+
+        /**
+         * @brief Initialize the system
+         * @param registry Reference to the EnTT registry
+         */
+        void init(Registry &registry) override;
+
+        /**
+         * @brief Refresh the world bounds of every entity and update moved proxies
+         * @param dt Delta time in seconds
+         */
+        void update(float dt) override;
+
+        [[nodiscard]] const char *get_name() const override { return "Spatial Index"; }
+
+        /**
+         * @brief Collect entities whose world bounds overlap a box
+         * @param aabb Query box
+         * @param out Vector the results are appended to
+         */
+        void query(const AABB &aabb, std::vector<entt::entity> &out) const;
+
+        /**
+         * @brief Collect entities whose world bounds are not fully outside a frustum
+         * @param frustum Query frustum
+         * @param out Vector the results are appended to
+         */
+        void query(const Frustum &frustum, std::vector<entt::entity> &out) const;
+
+        /**
+         * @brief Collect entities whose world bounds overlap a sphere
+         * @param center Sphere center
+         * @param radius Sphere radius
+         * @param out Vector the results are appended to
+         */
+        void query_sphere(const Vector3 &center, float radius, std::vector<entt::entity> &out) const;
+
+        /**
+         * @brief Find the closest entity hit by a ray
+         * @param origin Ray origin
+         * @param direction Normalized ray direction
+         * @param max_distance Maximum distance along the ray
+         * @return The closest hit, if any
+         */
+        [[nodiscard]] std::optional<RayHit> raycast(const Vector3 &origin, const Vector3 &direction,
+                                                    float max_distance) const;
+
+        [[nodiscard]] const DynamicAabbTree &get_tree() const { return m_tree; }
+
+    private:
+        DynamicAabbTree m_tree;
+
+        // Scratch for the batched bounds update, reused every frame.
+        std::vector<Matrix4> m_matrices;
+        Vector3Array m_local_min;
+        Vector3Array m_local_max;
+        Vector3Array m_world_min;
+        Vector3Array m_world_max;
+
+        void on_bounds_construct(Registry &registry, entt::entity entity);
+
+        void on_bounds_destroy(Registry &registry, entt::entity entity);
+
+        [[nodiscard]] static AABB compute_world_bounds(const AABB &local, const component::Transform *transform);
+
+        [[nodiscard]] static u32 to_user_data(const entt::entity entity) {
+            return static_cast<u32>(entt::to_integral(entity));
+        }
+
+        [[nodiscard]] static entt::entity from_user_data(const u32 user_data) {
+            return static_cast<entt::entity>(user_data);
+        }
+    };
+}
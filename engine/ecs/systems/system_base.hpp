@@ -1,5 +1,6 @@
 #pragma once
 #include "core/common.hpp"
+#include "ecs/registry.hpp"
 
 namespace softcube::system {
     /**
@@ -18,7 +19,7 @@ namespace softcube::system {
          * @brief Initialize the system
          * @param registry Reference to the EnTT registry
          */
-        virtual void init(entt::registry& registry) {
+        virtual void init(Registry& registry) {
             m_registry = &registry;
         }
         
@@ -27,12 +28,24 @@ namespace softcube::system {
          * @param dt Delta time in seconds
          */
         virtual void update(float dt) = 0;
+
+        /**
+         * @brief Get the display name of the system
+         * @return Name used by the profiler and the editor
+         */
+        [[nodiscard]] virtual const char* get_name() const = 0;
+
+        /**
+         * @brief Get the number of entities processed by the last update
+         * @return Entity count
+         */
+        [[nodiscard]] size_t get_processed_count() const { return m_processed_count; }
         
         /**
          * @brief Get the registry
          * @return Pointer to the EnTT registry
          */
-        entt::registry* get_registry() const { return m_registry; }
+        Registry* get_registry() const { return m_registry; }
         
         /**
          * @brief Set whether the system is enabled
@@ -47,7 +60,8 @@ namespace softcube::system {
         bool is_enabled() const { return m_enabled; }
         
     protected:
-        entt::registry* m_registry = nullptr;
+        Registry* m_registry = nullptr;
         bool m_enabled = true;
+        size_t m_processed_count = 0;
     };
 }
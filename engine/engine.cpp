@@ -4,11 +4,16 @@
 #include "graphics/renderer/renderer.hpp"
 #include "scene/scene_manager.hpp"
 #include "ecs/ecs_manager.hpp"
+#include "core/threading/job_system.hpp"
+#include "core/memory/frame_allocator.hpp"
+#include "core/memory/allocation_tracker.hpp"
+#include "core/memory/large_page_resource.hpp"
+#include "ecs/components/basic/transform_component.hpp"
 
 using namespace softcube;
 
 Engine::Engine()
-    : is_running(false) {
+    : registry(ComponentAllocator<entt::entity>(component_memory)), is_running(false) {
     g_engine = this;
 }
 
@@ -19,6 +24,23 @@ Engine::~Engine() {
 
 bool Engine::init(int argc, char **argv) {
     SC_INFO("Initializing engine...");
+
+    JobSystem::Config job_config;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string_view(argv[i]) == "--workers") {
+            job_config.worker_count = static_cast<u32>(std::strtoul(argv[i + 1], nullptr, 10));
+        } else if (std::string_view(argv[i]) == "--alloc-report") {
+            allocation_report_path = argv[i + 1];
+        }
+    }
+    job_system = std::make_unique<JobSystem>(job_config);
+    frame_allocator = std::make_unique<FrameAllocator>();
+
+    // Transform is read by nearly every system; keeping its pages contiguous
+    // cuts TLB misses on large worlds. Must happen before the storage exists.
+    component_pages = std::make_unique<LargePageResource>();
+    component_memory.set_upstream<component::Transform>(component_pages.get());
+
     window = std::make_unique<Window>();
     input_manager = std::make_unique<InputManager>();
     renderer = std::make_unique<Renderer>();
@@ -59,6 +81,9 @@ bool Engine::run() const {
         return false;
     }
 
+    frame_allocator->begin_frame();
+    AllocationTracker::begin_frame();
+
     window->update();
     input_manager->update();
 
@@ -70,17 +95,26 @@ bool Engine::run() const {
     const float delta_time = std::chrono::duration<float>(current_time - last_time).count();
     last_time = current_time;
 
+    job_system->run_main_thread_jobs();
+
     ecs_manager->update(delta_time);
-    scene_manager->update(delta_time);
 
-    renderer->begin_frame();
-    renderer->begin_imgui();
-    
-    ecs_manager->render(delta_time);
-    scene_manager->render(renderer.get());
-    
-    renderer->end_imgui();
-    renderer->end_frame();
+    {
+        SC_ALLOCATION_SCOPE("Scene");
+        scene_manager->update(delta_time);
+    }
+
+    {
+        SC_ALLOCATION_SCOPE("Renderer");
+        renderer->begin_frame();
+        renderer->begin_imgui();
+
+        ecs_manager->render(delta_time);
+        scene_manager->render(renderer.get());
+
+        renderer->end_imgui();
+        renderer->end_frame();
+    }
 
     return true;
 }
@@ -89,10 +123,25 @@ void Engine::shutdown() {
     if (is_running) {
         SC_INFO("Shutting down engine...");
 
+        if (!allocation_report_path.empty()) {
+            if (!AllocationTracker::is_enabled()) {
+                SC_WARN("--alloc-report ignored; built without SOFTCUBE_TRACK_ALLOCATIONS");
+            } else {
+                AllocationTracker::begin_frame();
+                (void) AllocationTracker::dump_csv(allocation_report_path);
+            }
+        }
+
+        // Systems own GPU handles, so they go while bgfx is still up. Clearing the
+        // registry first runs the destroy listeners while the systems still exist.
+        registry.clear();
+        ecs_manager.reset();
         scene_manager.reset();
         renderer.reset();
         input_manager.reset();
         window.reset();
+        frame_allocator.reset();
+        job_system.reset();
 
         is_running = false;
     }
@@ -1,6 +1,7 @@
 #pragma once
 #include "core/common.hpp"
 #include "core/logging.hpp"
+#include "ecs/registry.hpp"
 #include "graphics/renderer/renderer.hpp"
 
 namespace softcube {
@@ -9,6 +10,9 @@ namespace softcube {
     class Window;
     class InputManager;
     class EcsManager;
+    class JobSystem;
+    class FrameAllocator;
+    class LargePageResource;
 
     /**
      * @class Engine
@@ -27,6 +31,11 @@ namespace softcube {
 
         /**
          * @brief Initializes the engine and all subsystems
+         *
+         * Recognized arguments: --workers N sets the number of background job
+         * workers (default: one per spare hardware thread). --alloc-report PATH
+         * writes the per-tag allocation statistics to a CSV file on shutdown.
+         *
          * @param argc Command line argument count
          * @param argv Command line arguments
          * @return True if initialization succeeded, false otherwise
@@ -48,7 +57,7 @@ namespace softcube {
          * @brief Gets the registry used for the ECS
          * @return Reference to the EnTT registry
          */
-        entt::registry &get_registry() { return registry; }
+        Registry &get_registry() { return registry; }
 
         /**
          * @brief Gets the scene manager
@@ -78,6 +87,18 @@ namespace softcube {
          */
         EcsManager *get_ecs_manager() const { return ecs_manager.get(); }
 
+        /**
+         * @brief Gets the job system
+         * @return Pointer to the job system
+         */
+        JobSystem *get_job_system() const { return job_system.get(); }
+
+        /**
+         * @brief Gets the per-frame scratch allocator, reset at the start of every frame
+         * @return Pointer to the frame allocator
+         */
+        FrameAllocator *get_frame_allocator() const { return frame_allocator.get(); }
+
         /**
          * @brief Toggle the editor mode on/off
          * @param enabled Whether the editor should be enabled
@@ -97,13 +118,19 @@ namespace softcube {
         }
 
     private:
+        std::unique_ptr<JobSystem> job_system;
+        std::unique_ptr<FrameAllocator> frame_allocator;
         std::unique_ptr<Window> window;
         std::unique_ptr<InputManager> input_manager;
         std::unique_ptr<Renderer> renderer;
         std::unique_ptr<SceneManager> scene_manager;
         std::unique_ptr<EcsManager> ecs_manager;
 
-        entt::registry registry;
+        // Declared before the registry so both outlive its storages
+        std::unique_ptr<LargePageResource> component_pages;
+        ComponentMemory component_memory;
+        Registry registry;
+        std::filesystem::path allocation_report_path;
         bool is_running;
     };
 }
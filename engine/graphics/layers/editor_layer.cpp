@@ -8,7 +8,9 @@
 #include "ecs/components/hierarchy/children_component.hpp"
 #include "ecs/components/hierarchy/parent_component.hpp"
 #include "ecs/systems/hierarchy/hierarchy_system.hpp"
+#include "ecs/systems/physics/physics_integration_system.hpp"
 #include "graphics/renderer/renderer.hpp"
+#include "core/memory/allocation_tracker.hpp"
 
 namespace softcube {
     EditorLayer::EditorLayer() = default;
@@ -45,6 +47,8 @@ namespace softcube {
             if (ImGui::BeginMenu("View")) {
                 ImGui::MenuItem("Hierarchy", nullptr, &m_hierarchy_window_open);
                 ImGui::MenuItem("Inspector", nullptr, &m_inspector_window_open);
+                ImGui::MenuItem("Profiler", nullptr, &m_profiler_window_open);
+                ImGui::MenuItem("Allocations", nullptr, &m_allocations_window_open);
                 ImGui::EndMenu();
             }
 
@@ -104,6 +108,14 @@ namespace softcube {
             render_inspector_panel();
         }
 
+        if (m_profiler_window_open) {
+            render_profiler_panel();
+        }
+
+        if (m_allocations_window_open) {
+            render_allocations_panel();
+        }
+
         ImGui::End();
     }
 
@@ -156,8 +168,7 @@ namespace softcube {
                     flags |= ImGuiTreeNodeFlags_Selected;
                 }
 
-                bool has_children = entity.has_component<component::Children>() &&
-                                    !entity.get_component<component::Children>().entities.empty();
+                const bool has_children = entity.has_component<component::Children>();
 
                 if (!has_children) {
                     flags |= ImGuiTreeNodeFlags_Leaf;
@@ -189,9 +200,12 @@ namespace softcube {
 
                 if (opened) {
                     if (has_children) {
-                        const auto &children = entity.get_component<component::Children>();
-                        for (auto child_handle: children.entities) {
+                        // Read the next link first; the child may be deleted while it is drawn.
+                        for (auto child_handle = entity.get_component<component::Children>().first;
+                             child_handle != entt::null;) {
+                            const auto next = registry->get<component::Parent>(child_handle).next;
                             self(child_handle, self);
+                            child_handle = next;
                         }
                     }
                     ImGui::TreePop();
@@ -205,8 +219,13 @@ namespace softcube {
                 }
             };
 
-            auto view = registry->view<component::Name>(entt::exclude<component::Parent>);
+            // Children orphaned by deleting their parent keep a null Parent and are listed as roots.
+            auto view = registry->view<component::Name>();
             for (auto entity_handle: view) {
+                if (const auto *parent = registry->try_get<component::Parent>(entity_handle);
+                    parent && parent->entity != entt::null) {
+                    continue;
+                }
                 draw_entity_node(entity_handle, draw_entity_node);
             }
         }
@@ -255,6 +274,168 @@ namespace softcube {
         ImGui::End();
     }
 
+    void EditorLayer::render_profiler_panel() {
+        ImGui::Begin("Profiler", &m_profiler_window_open);
+
+        auto &profiler = m_ecs_manager->get_profiler();
+
+        bool enabled = profiler.is_enabled();
+        if (ImGui::Checkbox("Record", &enabled)) {
+            profiler.set_enabled(enabled);
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Reset")) {
+            profiler.reset();
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Dump CSV")) {
+            (void) profiler.dump_csv("system_profile.csv");
+        }
+
+        constexpr ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                                ImGuiTableFlags_SizingStretchProp;
+
+        if (ImGui::BeginTable("SystemTimings", 7, table_flags)) {
+            ImGui::TableSetupColumn("System");
+            ImGui::TableSetupColumn("Phase");
+            ImGui::TableSetupColumn("Avg (ms)");
+            ImGui::TableSetupColumn("P95 (ms)");
+            ImGui::TableSetupColumn("Max (ms)");
+            ImGui::TableSetupColumn("Entities");
+            ImGui::TableSetupColumn("History");
+            ImGui::TableHeadersRow();
+
+            std::array<float, SystemProfiler::history_size> history{};
+            const auto &entries = profiler.get_entries();
+
+            for (size_t i = 0; i < entries.size(); ++i) {
+                const auto &entry = entries[i];
+                const auto stats = profiler.get_stats(i);
+                const size_t count = profiler.get_history(i, history);
+
+                ImGui::PushID(static_cast<int>(i));
+                ImGui::TableNextRow();
+
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(entry.system->get_name());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(entry.rendering ? "Render" : "Update");
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", stats.average_ms);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", stats.p95_ms);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", stats.max_ms);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", entry.processed_count);
+                ImGui::TableNextColumn();
+                ImGui::PlotHistogram("##history", history.data(), static_cast<int>(count), 0, nullptr,
+                                     0.0f, stats.max_ms, ImVec2(-1.0f, 24.0f));
+
+                ImGui::PopID();
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+
+    void EditorLayer::render_allocations_panel() {
+        ImGui::Begin("Allocations", &m_allocations_window_open);
+
+        constexpr ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                                ImGuiTableFlags_SizingStretchProp;
+
+        if (!AllocationTracker::is_enabled()) {
+            ImGui::TextUnformatted("Heap tracking disabled (built without SOFTCUBE_TRACK_ALLOCATIONS)");
+        } else {
+            if (ImGui::Button("Reset")) {
+                AllocationTracker::reset();
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Dump CSV")) {
+                (void) AllocationTracker::dump_csv("allocation_report.csv");
+            }
+
+            const auto frame = AllocationTracker::get_last_frame();
+            ImGui::Text("Last frame: %llu allocations, %llu bytes, %llu frees",
+                        static_cast<unsigned long long>(frame.allocations),
+                        static_cast<unsigned long long>(frame.bytes),
+                        static_cast<unsigned long long>(frame.frees));
+
+            if (frame.violations > 0) {
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%llu allocations in no-allocation scopes",
+                                   static_cast<unsigned long long>(frame.violations));
+            }
+
+            std::array<float, AllocationTracker::history_size> history{};
+            const size_t count = AllocationTracker::get_history(history);
+            ImGui::PlotHistogram("##allocations", history.data(), static_cast<int>(count), 0,
+                                 "Allocations per frame", 0.0f, FLT_MAX, ImVec2(-1.0f, 48.0f));
+
+            if (ImGui::BeginTable("AllocationTags", 5, table_flags)) {
+                ImGui::TableSetupColumn("Tag");
+                ImGui::TableSetupColumn("Allocs");
+                ImGui::TableSetupColumn("Bytes");
+                ImGui::TableSetupColumn("Peak allocs");
+                ImGui::TableSetupColumn("Peak bytes");
+                ImGui::TableHeadersRow();
+
+                for (const auto &tag: AllocationTracker::get_tag_stats()) {
+                    ImGui::TableNextRow();
+
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(tag.name.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(tag.last_allocations));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(tag.last_bytes));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(tag.peak_allocations));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(tag.peak_bytes));
+                }
+
+                ImGui::EndTable();
+            }
+        }
+
+        const auto *registry = m_ecs_manager->get_hierarchy_system().get_registry();
+        if (registry && ImGui::CollapsingHeader("Component storages", ImGuiTreeNodeFlags_DefaultOpen) &&
+            ImGui::BeginTable("ComponentStorages", 5, table_flags)) {
+            ImGui::TableSetupColumn("Component");
+            ImGui::TableSetupColumn("Size");
+            ImGui::TableSetupColumn("Capacity");
+            ImGui::TableSetupColumn("KiB");
+            ImGui::TableSetupColumn("Peak KiB");
+            ImGui::TableHeadersRow();
+
+            for (const auto &storage: ComponentMemory::get_storage_stats(*registry)) {
+                ImGui::TableNextRow();
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%.*s%s", static_cast<int>(storage.name.size()), storage.name.data(),
+                            storage.custom_upstream ? " *" : "");
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", storage.size);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", storage.capacity);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", static_cast<double>(storage.bytes) / 1024.0);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", static_cast<double>(storage.peak_bytes) / 1024.0);
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+
     void EditorLayer::render_components(Entity entity) {
         if (entity.has_component<component::Name>()) {
             auto &name = entity.get_component<component::Name>();
@@ -268,7 +449,10 @@ namespace softcube {
 
         if (entity.has_component<component::Transform>()) {
             auto &transform = entity.get_component<component::Transform>();
-            render_transform_component(transform);
+            if (render_transform_component(transform)) {
+                // Simulated entities would otherwise snap back to their body on the next update.
+                m_ecs_manager->get_physics_integration_system().teleport(entity.get_handle());
+            }
         }
 
         if (entity.has_component<component::MeshRenderer>()) {
@@ -282,7 +466,8 @@ namespace softcube {
         }
     }
 
-    void EditorLayer::render_transform_component(component::Transform &transform) {
+    bool EditorLayer::render_transform_component(component::Transform &transform) {
+        bool edited = false;
         if (ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen)) {
             float position[3] = {
                 transform.position.x,
@@ -293,6 +478,7 @@ namespace softcube {
                 transform.position = {position[0], position[1], position[2]};
                 transform.local_position = transform.position;
                 transform.matrix_dirty = true;
+                edited = true;
             }
 
             float rotation[3] = {
@@ -302,6 +488,7 @@ namespace softcube {
             };
             if (ImGui::DragFloat3("Rotation", rotation, 0.1f)) {
                 transform.matrix_dirty = true;
+                edited = true;
             }
 
             float scale[3] = {
@@ -313,8 +500,10 @@ namespace softcube {
                 transform.scale = {scale[0], scale[1], scale[2]};
                 transform.local_scale = transform.scale;
                 transform.matrix_dirty = true;
+                edited = true;
             }
         }
+        return edited;
     }
 
     void EditorLayer::render_mesh_renderer_component(component::MeshRenderer &mesh_renderer) {
@@ -359,54 +548,32 @@ namespace softcube {
             float fov = camera.fov;
             if (ImGui::SliderFloat("Field of View", &fov, 1.0f, 179.0f)) {
                 camera.fov = fov;
-                if (m_ecs_manager->get_renderer()) {
-                    const float width = m_ecs_manager->get_renderer()->get_width();
-                    const float height = m_ecs_manager->get_renderer()->get_height();
-                    camera.calculate_projection_matrix(width, height);
-                }
             }
 
             float near_clip = camera.near_clip;
             if (ImGui::DragFloat("Near Clip", &near_clip, 0.01f, 0.001f, camera.far_clip - 0.1f)) {
                 camera.near_clip = near_clip;
-                if (m_ecs_manager->get_renderer()) {
-                    const float width = m_ecs_manager->get_renderer()->get_width();
-                    const float height = m_ecs_manager->get_renderer()->get_height();
-                    camera.calculate_projection_matrix(width, height);
-                }
             }
 
             float far_clip = camera.far_clip;
             if (ImGui::DragFloat("Far Clip", &far_clip, 1.0f, camera.near_clip + 0.1f, 10000.0f)) {
                 camera.far_clip = far_clip;
-                if (m_ecs_manager->get_renderer()) {
-                    const float width = m_ecs_manager->get_renderer()->get_width();
-                    const float height = m_ecs_manager->get_renderer()->get_height();
-                    camera.calculate_projection_matrix(width, height);
-                }
             }
 
             bool is_orthographic = camera.is_orthographic;
             if (ImGui::Checkbox("Orthographic", &is_orthographic)) {
                 camera.is_orthographic = is_orthographic;
-                if (m_ecs_manager->get_renderer()) {
-                    const float width = m_ecs_manager->get_renderer()->get_width();
-                    const float height = m_ecs_manager->get_renderer()->get_height();
-                    camera.calculate_projection_matrix(width, height);
-                }
             }
 
             if (camera.is_orthographic) {
                 float ortho_size = camera.ortho_size;
                 if (ImGui::DragFloat("Orthographic Size", &ortho_size, 0.1f, 0.1f, 100.0f)) {
                     camera.ortho_size = ortho_size;
-                    if (m_ecs_manager->get_renderer()) {
-                        const float width = m_ecs_manager->get_renderer()->get_width();
-                        const float height = m_ecs_manager->get_renderer()->get_height();
-                        camera.calculate_projection_matrix(width, height);
-                    }
                 }
             }
+
+            ImGui::DragFloat4("Viewport", &camera.viewport.x, 0.01f, 0.0f, 1.0f);
+            ImGui::Text("View %u, matrices rebuilt %u times", camera.view_id, camera.matrix_version);
         }
     }
 
@@ -63,6 +63,16 @@ namespace softcube {
          */
         void render_inspector_panel();
 
+        /**
+         * @brief Render the per-system timing panel
+         */
+        void render_profiler_panel();
+
+        /**
+         * @brief Render the per-frame heap allocation panel
+         */
+        void render_allocations_panel();
+
         /**
          * @brief Render component properties in the inspector
          * @param entity The entity whose components to render
@@ -72,8 +82,9 @@ namespace softcube {
         /**
          * @brief Render properties for Transform component
          * @param transform Reference to the Transform component
+         * @return True if the transform was edited
          */
-        void render_transform_component(component::Transform &transform);
+        static bool render_transform_component(component::Transform &transform);
 
         /**
          * @brief Render properties for MeshRenderer component
@@ -103,6 +114,8 @@ namespace softcube {
         Entity m_selected_entity;
         bool m_hierarchy_window_open = true;
         bool m_inspector_window_open = true;
+        bool m_profiler_window_open = true;
+        bool m_allocations_window_open = false;
         float m_panel_width = 300.0f;
     };
 }
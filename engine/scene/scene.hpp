@@ -1,5 +1,6 @@
 #pragma once
 #include "core/common.hpp"
+#include "ecs/registry.hpp"
 
 namespace softcube {
     class Engine;
@@ -66,7 +67,7 @@ namespace softcube {
          * @brief Gets the scene's entity registry
          * @return Reference to the entity registry
          */
-        entt::registry &get_registry() { return registry; }
+        Registry &get_registry() { return registry; }
 
         /**
          * @brief Gets the engine instance
@@ -76,7 +77,7 @@ namespace softcube {
 
     protected:
         std::string name;
-        entt::registry registry;
+        Registry registry;
     };
 }
 